@@ -987,7 +987,7 @@ static void device_status_send(struct k_work *work)
 	}
 
 #ifdef CONFIG_MODEM_INFO
-	ret = modem_info_params_get(&modem_param);
+	ret = modem_info_params_snapshot_get(&modem_param);
 	if (ret < 0) {
 		LOG_ERR("Unable to obtain modem parameters: %d", ret);
 	} else {
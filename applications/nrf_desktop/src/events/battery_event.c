@@ -77,3 +77,5 @@ EVENT_TYPE_DEFINE(battery_level_event,
 		  IS_ENABLED(CONFIG_DESKTOP_INIT_LOG_BATTERY_LEVEL_EVENT),
 		  log_battery_level_event,
 		  &battery_level_event_info);
+
+EVENT_PROC_CLASS_SET(battery_level_event, EVENT_PROC_CLASS_LOW);
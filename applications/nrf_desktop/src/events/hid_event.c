@@ -61,6 +61,8 @@ EVENT_TYPE_DEFINE(hid_report_event,
 		  log_hid_report_event,
 		  &hid_report_event_info);
 
+EVENT_PROC_CLASS_SET(hid_report_event, EVENT_PROC_CLASS_HIGH);
+
 static int log_hid_report_subscriber_event(const struct event_header *eh,
 					      char *buf, size_t buf_len)
 {
@@ -132,6 +134,8 @@ EVENT_TYPE_DEFINE(hid_report_sent_event,
 		  log_hid_report_sent_event,
 		  &hid_report_sent_event_info);
 
+EVENT_PROC_CLASS_SET(hid_report_sent_event, EVENT_PROC_CLASS_HIGH);
+
 static int log_hid_report_subscription_event(const struct event_header *eh,
 						char *buf, size_t buf_len)
 {
@@ -23,6 +23,8 @@ EVENT_TYPE_DEFINE(led_event,
 		  log_led_event,
 		  NULL);
 
+EVENT_PROC_CLASS_SET(led_event, EVENT_PROC_CLASS_LOW);
+
 static int log_led_ready_event(const struct event_header *eh, char *buf,
 			 size_t buf_len)
 {
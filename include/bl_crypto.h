@@ -170,6 +170,16 @@ typedef int (*bl_sha256_verify_t)(const u8_t *data, u32_t data_len,
 				const u8_t *expected);
 
 
+/**
+ * @brief Implementation of bl_sha256_verify that is safe to be called from
+ *        EXT_API.
+ *
+ * See @ref bl_sha256_verify for docs.
+ */
+int bl_sha256_verify_external(const u8_t *data, u32_t data_len,
+			      const u8_t *expected);
+
+
 /**
  * @brief Validate a secp256r1 signature.
  *
@@ -36,6 +36,8 @@ struct dfu_target {
 	int (*init)(size_t file_size, dfu_target_callback_t cb);
 	int (*offset_get)(size_t *offset);
 	int (*write)(const void *const buf, size_t len);
+	/** Optional, NULL if the target only supports sequential writes. */
+	int (*write_at)(size_t offset, const void *const buf, size_t len);
 	int (*done)(bool successful);
 };
 
@@ -95,6 +97,25 @@ int dfu_target_offset_get(size_t *offset);
  **/
 int dfu_target_write(const void *const buf, size_t len);
 
+/**
+ * @brief Write the given buffer at an offset of the image.
+ *
+ *	  Parts of the image can be written in any order, and an interrupted
+ *	  transfer can be resumed by writing the parts that are missing.
+ *	  Parts that are already written are skipped. Do not mix with
+ *	  @ref dfu_target_write for the same image.
+ *
+ * @param[in] offset Offset of the data in the image.
+ * @param[in] buf A buffer of bytes which contains part of an binary firmware
+ *		  image.
+ * @param[in] len The length of the provided buffer.
+ *
+ * @return 0 on success, -ENOTSUP if the initialized DFU target only supports
+ *	   sequential writes, or another negative error code identicating
+ *	   reason of failure.
+ **/
+int dfu_target_write_at(size_t offset, const void *const buf, size_t len);
+
 /**
  * @brief Deinitialize the resources that were needed for the current DFU
  *	  target.
@@ -54,6 +54,33 @@ extern "C" {
 #define SUBS_PRIO_COUNT (SUBS_PRIO_MAX - SUBS_PRIO_MIN + 1)
 
 
+/** @def EVENT_MANAGER_LATENCY_HIST_BUCKET_CNT
+ *
+ * @brief Number of buckets in the event processing latency histogram.
+ */
+#define EVENT_MANAGER_LATENCY_HIST_BUCKET_CNT 16
+
+
+/** @brief Event processing classes.
+ *
+ * Events of a higher priority class are processed before events of
+ * a lower priority class that are waiting in the queue.
+ */
+enum event_proc_class {
+	/** Latency-critical events. */
+	EVENT_PROC_CLASS_HIGH,
+
+	/** Default class of all event types. */
+	EVENT_PROC_CLASS_NORMAL,
+
+	/** Events that can be delayed. */
+	EVENT_PROC_CLASS_LOW,
+
+	/** Number of processing classes. */
+	EVENT_PROC_CLASS_COUNT
+};
+
+
 /** @brief Event header.
  *
  * When defining an event structure, the event header
@@ -65,6 +92,11 @@ struct event_header {
 
 	/** Pointer to the event type object. */
 	const struct event_type *type_id;
+
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+	/** Event submission time in cycles. */
+	u32_t timestamp;
+#endif
 };
 
 
@@ -96,11 +128,33 @@ struct event_listener {
 };
 
 
+/** @brief Execution time statistics of an event subscriber.
+ */
+struct event_subscriber_stats {
+	/** Number of listener calls. */
+	u32_t call_cnt;
+
+	/** Shortest execution time in cycles. */
+	u32_t min_cycles;
+
+	/** Longest execution time in cycles. */
+	u32_t max_cycles;
+
+	/** Total execution time in cycles. */
+	u64_t total_cycles;
+};
+
+
 /** @brief Event subscriber.
  */
 struct event_subscriber {
 	/** Pointer to the listener. */
 	const struct event_listener *listener;
+
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS
+	/** Pointer to the execution time statistics. */
+	struct event_subscriber_stats *stats;
+#endif
 };
 
 
@@ -122,6 +176,40 @@ struct event_info {
 };
 
 
+/** @brief Event memory slab.
+ *
+ * Fixed-size memory from which events of a given type are allocated
+ * instead of the system heap. Defined with @ref EVENT_TYPE_SLAB_DEFINE.
+ */
+struct event_mem_slab {
+	/** Memory slab holding the event objects. */
+	struct k_mem_slab *slab;
+
+	/** Highest number of events allocated at the same time. */
+	atomic_t max_used;
+
+	/** Number of allocations that failed. */
+	atomic_t alloc_fail_cnt;
+};
+
+
+/** @brief Event memory slab usage.
+ */
+struct event_mem_slab_stats {
+	/** Number of events currently allocated. */
+	u32_t used;
+
+	/** Highest number of events allocated at the same time. */
+	u32_t max_used;
+
+	/** Number of events that fit in the slab. */
+	u32_t total;
+
+	/** Number of allocations that failed. */
+	u32_t alloc_fail_cnt;
+};
+
+
 /** @brief Event type.
  */
 struct event_type {
@@ -144,6 +232,37 @@ struct event_type {
 
 	/** Logging and formatting information. */
 	const struct event_info *ev_info;
+
+	/** Memory slab used for allocation or NULL if heap is used. */
+	struct event_mem_slab *mem_slab;
+};
+
+
+/** @brief Event processing class assignment.
+ *
+ * All assignments must be defined using @ref EVENT_PROC_CLASS_SET.
+ */
+struct event_proc_class_entry {
+	/** Pointer to the event type. */
+	const struct event_type *type;
+
+	/** Processing class of the event type. */
+	u8_t proc_class;
+};
+
+
+/** @brief Event merge function assignment.
+ *
+ * All assignments must be defined using @ref EVENT_MERGE_FN_SET.
+ */
+struct event_merge_fn_entry {
+	/** Pointer to the event type. */
+	const struct event_type *type;
+
+	/** Function merging a submitted event into a queued event of
+	 *  the same type. Returns true if the event was merged. */
+	bool (*merge)(struct event_header *queued,
+		      const struct event_header *eh);
 };
 
 
@@ -153,6 +272,12 @@ extern const struct event_listener __stop_event_listeners[];
 extern const struct event_type __start_event_types[];
 extern const struct event_type __stop_event_types[];
 
+extern const struct event_proc_class_entry __start_event_proc_classes[];
+extern const struct event_proc_class_entry __stop_event_proc_classes[];
+
+extern const struct event_merge_fn_entry __start_event_merge_fns[];
+extern const struct event_merge_fn_entry __stop_event_merge_fns[];
+
 
 /** Create an event listener object.
  *
@@ -237,6 +362,17 @@ extern const struct event_type __stop_event_types[];
 #define EVENT_TYPE_DYNDATA_DECLARE(ename) _EVENT_TYPE_DYNDATA_DECLARE(ename)
 
 
+/** Declare an event type allocated from a dedicated memory slab.
+ *
+ * This macro provides declarations required for an event to be used
+ * by other modules.
+ * Declared event must be defined using @ref EVENT_TYPE_SLAB_DEFINE.
+ *
+ * @param ename  Name of the event.
+ */
+#define EVENT_TYPE_SLAB_DECLARE(ename) _EVENT_TYPE_SLAB_DECLARE(ename)
+
+
 /** Define an event type.
  *
  * This macro defines an event type. In addition, it defines functions
@@ -261,6 +397,58 @@ extern const struct event_type __stop_event_types[];
 	_EVENT_TYPE_DEFINE(ename, init_log_en, log_fn, ev_info_struct)
 
 
+/** Define an event type allocated from a dedicated memory slab.
+ *
+ * This macro works like @ref EVENT_TYPE_DEFINE, but events of the given
+ * type are allocated from a memory slab of fixed size instead of the
+ * system heap. Allocation and release of such events take constant time.
+ * The event type must be declared using @ref EVENT_TYPE_SLAB_DECLARE.
+ *
+ * @note Events with dynamic data cannot be allocated from a memory slab.
+ *
+ * @param ename     	   Name of the event.
+ * @param init_log_en	   Bool indicating if the event is logged
+ *                         by default.
+ * @param log_fn  	   Function to stringify an event of this type.
+ * @param ev_info_struct   Data structure describing the event type.
+ * @param slab_cnt         Maximum number of events of this type that can
+ *                         be allocated at the same time.
+ */
+#define EVENT_TYPE_SLAB_DEFINE(ename, init_log_en, log_fn, ev_info_struct, slab_cnt) \
+	_EVENT_TYPE_SLAB_DEFINE(ename, init_log_en, log_fn, ev_info_struct, slab_cnt)
+
+
+/** Assign a processing class to an event type.
+ *
+ * Events of the given type are queued in the queue of the given processing
+ * class. The assignment takes effect only if
+ * CONFIG_DESKTOP_EVENT_MANAGER_PROC_CLASSES is enabled.
+ *
+ * @param ename       Name of the event.
+ * @param proc_class  Processing class (see @ref event_proc_class).
+ */
+#define EVENT_PROC_CLASS_SET(ename, proc_class) \
+	_EVENT_PROC_CLASS_SET(ename, proc_class)
+
+
+/** Assign a merge function to an event type.
+ *
+ * When an event of the given type is submitted while another event of this
+ * type is still waiting for processing, the merge function is called to
+ * update the queued event in place with the data of the submitted event.
+ * If the merge function returns true, the submitted event is freed and not
+ * queued. The queued event keeps its position in the queue.
+ *
+ * The merge function is called with interrupts locked and must be short.
+ * The assignment takes effect only if
+ * CONFIG_DESKTOP_EVENT_MANAGER_EVENT_MERGE is enabled.
+ *
+ * @param ename     Name of the event.
+ * @param merge_fn  Merge function.
+ */
+#define EVENT_MERGE_FN_SET(ename, merge_fn) _EVENT_MERGE_FN_SET(ename, merge_fn)
+
+
 /** Verify if an event ID is valid.
  *
  * The pointer to an event type structure is used as its ID. This macro
@@ -273,6 +461,15 @@ extern const struct event_type __stop_event_types[];
 	__ASSERT_NO_MSG((id >= __start_event_types) && (id < __stop_event_types))
 
 
+/** Allocate an event from the memory slab.
+ *
+ * @param mem_slab  Pointer to the event memory slab.
+ *
+ * @return Pointer to the allocated memory or NULL if the slab is exhausted.
+ */
+void *_event_mem_slab_alloc(struct event_mem_slab *mem_slab);
+
+
 /** Submit an event to the Event Manager.
  *
  * @param eh  Pointer to the event header element in the event object.
@@ -296,6 +493,52 @@ void _event_submit(struct event_header *eh);
 int event_manager_init(void);
 
 
+/** Get the memory slab usage of an event type.
+ *
+ * @param et     Event type.
+ * @param stats  Usage of the memory slab.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOENT If the events of the type are allocated from the heap.
+ */
+int event_manager_mem_slab_stats_get(const struct event_type *et,
+				     struct event_mem_slab_stats *stats);
+
+
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS
+/** Get the execution time statistics of an event subscriber.
+ *
+ * The statistics are copied under the lock that protects their update.
+ *
+ * @param es     Event subscriber.
+ * @param stats  Copy of the statistics.
+ */
+void event_manager_listener_stats_get(const struct event_subscriber *es,
+				      struct event_subscriber_stats *stats);
+
+
+/** Reset the execution time statistics of all event subscribers.
+ */
+void event_manager_listener_stats_reset(void);
+#endif
+
+
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+/** Get the event processing latency histogram of a processing class.
+ *
+ * Bucket 0 counts latencies below one microsecond, bucket i counts
+ * latencies from 2^(i-1) to 2^i - 1 microseconds and the last bucket
+ * counts all longer latencies.
+ *
+ * @param proc_class  Processing class. If processing classes are disabled,
+ *		      all events are counted in the first histogram.
+ *
+ * @return Array of @ref EVENT_MANAGER_LATENCY_HIST_BUCKET_CNT counters.
+ */
+const u32_t *event_manager_latency_hist_get(enum event_proc_class proc_class);
+#endif
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,6 +23,7 @@ extern "C" {
 
 #include <zephyr/types.h>
 #include <stddef.h>
+#include <kernel.h>
 
 /**
  * @brief AT command return codes
@@ -51,6 +52,56 @@ enum at_cmd_state {
  */
 typedef void (*at_cmd_handler_t)(const char *response);
 
+struct at_cmd_async;
+
+/**
+ * @typedefs at_cmd_async_handler_t
+ *
+ * Handler for the completion of an asynchronous AT command. It is called from
+ * the system work queue, in the order in which the commands were queued, so
+ * it must not call @ref at_cmd_write or @ref at_cmd_write_with_callback.
+ *
+ * @param cmd      The completed command, with its return code and state.
+ *                 It can be reused or freed by the handler.
+ * @param response Null terminated string containing the data returned by
+ *                 the modem, without the return code. Empty if there is
+ *                 none, or if the command was not sent.
+ */
+typedef void (*at_cmd_async_handler_t)(struct at_cmd_async *cmd,
+				       const char *response);
+
+/**
+ * @brief An AT command to be sent asynchronously, with
+ *        @ref at_cmd_write_async.
+ *
+ * The command is owned by the driver from when it is queued until its handler
+ * is called.
+ */
+struct at_cmd_async {
+	/** Null terminated AT command, kept until the command completes. */
+	const char *cmd;
+	/** Handler called when the command completes. NULL is allowed. */
+	at_cmd_async_handler_t handler;
+	/** Semaphore given by the AT socket thread when the command completes,
+	 *  before the handler is called. NULL is allowed. Unlike the handler,
+	 *  it can be waited for on the system work queue.
+	 */
+	struct k_sem *done;
+	/** For the user of the driver. */
+	void *user_data;
+	/** Return code, as returned by @ref at_cmd_write. -ECANCELED if the
+	 *  command was not sent, because a command before it in its batch
+	 *  failed.
+	 */
+	int code;
+	/** Return state, as returned by @ref at_cmd_write. */
+	enum at_cmd_state state;
+	/* Internal use by the driver. */
+	sys_snode_t node;
+	struct k_work work;
+	size_t batch_left;
+};
+
 /**@brief Initialize AT command driver.
  *
  * @return Zero on success, non-zero otherwise.
@@ -130,6 +181,28 @@ int at_cmd_write(const char *const cmd,
 		 size_t buf_len,
 		 enum at_cmd_state *state);
 
+/**
+ * @brief Function to queue a batch of AT commands to be sent asynchronously
+ *
+ * The commands are sent one after another by the AT socket thread, which sends
+ * each command as soon as the result of the previous one is received. Commands
+ * written with @ref at_cmd_write or @ref at_cmd_write_with_callback are sent
+ * between the batches, not within them, and are not delayed by batches queued
+ * after they started waiting.
+ *
+ * If a command fails, the rest of its batch is not sent, but completed with
+ * the code -ECANCELED. To send commands that do not depend on each other,
+ * queue them one at a time.
+ *
+ * @param cmds  Array of commands, with the cmd and handler fields set. The
+ *              other fields are set by the driver.
+ * @param count Number of commands in the array.
+ *
+ * @retval 0       If the commands were queued.
+ * @retval -EINVAL If there are no commands, or a command string is NULL.
+ */
+int at_cmd_write_async(struct at_cmd_async *cmds, size_t count);
+
 /**
  * @brief Function to set AT command global notification handler
  *
@@ -39,6 +39,9 @@ extern "C" {
  */
 typedef void (*at_notif_handler_t)(void *context, const char *response);
 
+/** Maximum length of a notification prefix, such as "+CEREG". */
+#define AT_NOTIF_PREFIX_LEN_MAX 15
+
 /**@brief Initialize AT command notification manager.
  *
  * @return Zero on success, non-zero otherwise.
@@ -78,6 +81,68 @@ int at_notif_register_handler(void *context, at_notif_handler_t handler);
  */
 int at_notif_deregister_handler(void *context, at_notif_handler_t handler);
 
+/**
+ * @brief Function to register AT command notification handler for the
+ *        notifications with a given prefix
+ *
+ * The prefix of a notification is the text before its colon, such as
+ * "+CEREG" in "+CEREG: 1". The handler is called only for the notifications
+ * with this prefix, so it does not need to check the prefix itself. The same
+ * handler can be registered for several prefixes.
+ *
+ * @note  If the same combination of context, prefix and handler exists in the
+ *        memory, then the request will be ignored and command execution will
+ *        be regarded as finished successfully.
+ *
+ * @param context Pointer to context provided by the module which has
+ *                registered the handler.
+ * @param prefix  Prefix of the notifications, of at most
+ *                @ref AT_NOTIF_PREFIX_LEN_MAX characters, without the colon.
+ *                It is copied.
+ * @param handler Pointer to a received notification handler function of type
+ *                @ref at_notif_handler_t.
+ *
+ * @retval 0            If command execution was successful.
+ * @retval -ENOBUFS     If memory cannot be allocated, or if
+ *                      CONFIG_AT_NOTIF_PREFIX_COUNT_MAX prefixes are already
+ *                      registered.
+ * @retval -EINVAL      If handler is a NULL pointer, or if prefix is not valid.
+ */
+int at_notif_register_prefix_handler(void *context, const char *prefix,
+				     at_notif_handler_t handler);
+
+/**
+ * @brief Function to de-register AT command notification handler for the
+ *        notifications with a given prefix
+ *
+ * @param context Pointer to context provided by the module which has
+ *                registered the handler.
+ * @param prefix  Prefix of the notifications.
+ * @param handler Pointer to a received notification handler function of type
+ *                @ref at_notif_handler_t.
+ *
+ * @retval 0            If command execution was successful.
+ * @retval -EINVAL      If handler or prefix is a NULL pointer.
+ */
+int at_notif_deregister_prefix_handler(void *context, const char *prefix,
+				       at_notif_handler_t handler);
+
+/**
+ * @brief Function to get the number of notifications with a given prefix that
+ *        have been dispatched
+ *
+ * The notifications are counted while handlers are registered for the
+ * prefix. The count is reset when the last of them is de-registered.
+ *
+ * @param prefix Prefix of the notifications.
+ * @param count  Number of notifications dispatched.
+ *
+ * @retval 0            If command execution was successful.
+ * @retval -ENOENT      If no handlers are registered for the prefix.
+ * @retval -EINVAL      If prefix or count is a NULL pointer.
+ */
+int at_notif_dispatch_count_get(const char *prefix, u32_t *count);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -22,11 +22,16 @@
  * All parameters values are copied in the list. Parameters should be
  * cleared to free that memory. Getter and setter methods are available
  * to read and write parameter values.
+ *
+ * A list can also be created in a buffer provided by the user, with
+ * at_params_list_init_buf(). The parameters and their values are then
+ * stored in the buffer, and the list never allocates memory.
  */
 #ifndef AT_PARAMS_H__
 #define AT_PARAMS_H__
 
 #include <zephyr/types.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -65,6 +70,16 @@ struct at_param {
 	union at_param_value value;
 };
 
+/**
+ * @brief Storage for the string and array values of a list created with
+ * at_params_list_init_buf(). For internal use.
+ */
+struct at_params_arena {
+	u8_t *values;
+	size_t size;
+	size_t used;
+};
+
 /**
  * @brief List of AT parameters that compose an AT command or response.
  *
@@ -74,8 +89,22 @@ struct at_param {
 struct at_param_list {
 	size_t param_count;
 	struct at_param *params;
+	struct at_params_arena *arena;
 };
 
+/**
+ * @brief Size of a buffer for at_params_list_init_buf().
+ *
+ * @param max_params_count Maximum number of parameters in the list.
+ * @param values_size      Space for the string and array values, in bytes.
+ *                         A string takes its length plus one byte, an array
+ *                         its size rounded up to four bytes.
+ */
+#define AT_PARAMS_LIST_BUF_SIZE(max_params_count, values_size) \
+	(sizeof(struct at_params_arena) + \
+	 (max_params_count) * sizeof(struct at_param) + \
+	 (values_size) + sizeof(void *))
+
 /**
  * @brief Create a list of parameters.
  *
@@ -92,6 +121,27 @@ struct at_param_list {
  */
 int at_params_list_init(struct at_param_list *list, size_t max_params_count);
 
+/**
+ * @brief Create a list of parameters in a buffer.
+ *
+ * The parameters, and their string and array values, are stored in
+ * @p buf instead of being allocated, until the list is cleared. Putting a
+ * value that does not fit returns -ENOMEM. The buffer must be kept until the
+ * list is freed.
+ *
+ * @param[in] list Parameter list to initialize.
+ * @param[in] max_params_count Maximum number of element that the list can
+ * store.
+ * @param[in] buf Buffer for the list.
+ * @param[in] buf_size Size of @p buf, see @ref AT_PARAMS_LIST_BUF_SIZE.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int at_params_list_init_buf(struct at_param_list *list,
+			    size_t max_params_count, void *buf,
+			    size_t buf_size);
+
 /**
  * @brief Clear/reset all parameter types and values.
  *
@@ -105,6 +155,8 @@ void at_params_list_clear(struct at_param_list *list);
  * @brief Free a list of parameters.
  *
  * First the list is cleared. Then the list and its elements are deleted.
+ * The buffer of a list created with at_params_list_init_buf() can then be
+ * reused.
  *
  * @param[in] list Parameter list to free.
  */
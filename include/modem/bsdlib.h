@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
  */
 
+#include <zephyr/types.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -40,6 +42,34 @@ int bsdlib_get_init_ret(void);
  */
 int bsdlib_shutdown(void);
 
+/**
+ * @brief Counters of the threads woken up by bsdlib events.
+ */
+struct bsdlib_wakeup_stats {
+	/** Number of times a thread waiting in bsdlib was woken up by an
+	 *  event from the modem.
+	 */
+	u32_t wakeups;
+	/** Number of those wakeups after which the thread waited again for
+	 *  the same socket or context within the same socket call, as it
+	 *  does when the event was not for it. Only the calls made through
+	 *  the socket API are counted, so a wait in the next recv() on the
+	 *  same socket is not.
+	 */
+	u32_t spurious_wakeups;
+};
+
+/**
+ * @brief Get the counters of the threads woken up by bsdlib events.
+ *
+ * The counters are kept when CONFIG_BSD_LIBRARY_WAKEUP_STATS is enabled.
+ *
+ * @param[out] stats The counters.
+ *
+ * @return Zero on success, -ENOTSUP if the counters are not kept.
+ */
+int bsdlib_wakeup_stats_get(struct bsdlib_wakeup_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
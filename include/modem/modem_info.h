@@ -113,11 +113,18 @@ struct device_param {
 	const char *app_name; /**< Application name. */
 };
 
+/** Number of AT commands that the modem parameters are read with. */
+#define MODEM_INFO_PARAMS_CMD_COUNT 12
+
 /**@brief Modem parameters. */
 struct modem_param_info {
 	struct network_param network; /**< Network parameters. */
 	struct sim_param     sim; /**< SIM card parameters. */
 	struct device_param  device;/**< Device parameters. */
+	/** Uptime in milliseconds at which the values of each AT command
+	 *  were read, or 0 if they are not. For internal use.
+	 */
+	s64_t read_time[MODEM_INFO_PARAMS_CMD_COUNT];
 };
 
 /** @brief Initialize the modem information module.
@@ -129,6 +136,10 @@ int modem_info_init(void);
 
 
 /** @brief Initialize the structure that stores modem information.
+ *
+ * Also subscribes to %XSIM notifications, which tell when the SIM card
+ * changes. If the modem rejects the subscription, the initialization
+ * still succeeds.
  *
  * @param modem_param Pointer to the modem parameter structure.
  *
@@ -228,7 +239,9 @@ int modem_info_json_object_encode(struct modem_param_info *modem,
 
 /** @brief Obtain the modem parameters.
  *
- * The data is stored in the provided info structure.
+ * The data is stored in the provided info structure. All values are read
+ * from the modem, with one AT command for the values that are in the same
+ * response.
  *
  * @param modem_param Pointer to the storage parameters.
  *
@@ -237,6 +250,32 @@ int modem_info_json_object_encode(struct modem_param_info *modem,
  */
 int modem_info_params_get(struct modem_param_info *modem_param);
 
+/** @brief Obtain the modem parameters, reading only the values that are
+ *         stale.
+ *
+ * Like @ref modem_info_params_get, but the values already in the structure
+ * are kept while they are valid:
+ *
+ * - The modem firmware version, IMEI and supported bands, once read.
+ * - The ICCID and IMSI, until a %XSIM notification. @ref
+ *   modem_info_params_init subscribes to these notifications. If the
+ *   subscription failed, for CONFIG_MODEM_INFO_PARAMS_MAX_AGE seconds.
+ * - The other network and SIM card values, for
+ *   CONFIG_MODEM_INFO_PARAMS_MAX_AGE seconds. The IP address also until a
+ *   +CEREG notification. The tracking area and cell ID are taken from a
+ *   +CEREG notification that has them, otherwise they are read again
+ *   together with the operator and band.
+ *
+ * The battery voltage and the date and time are always read.
+ * @ref modem_info_params_init discards all values.
+ *
+ * @param modem_param Pointer to the storage parameters.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int modem_info_params_snapshot_get(struct modem_param_info *modem_param);
+
 /** @} */
 
 #ifdef __cplusplus
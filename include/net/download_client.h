@@ -63,6 +63,8 @@ enum download_client_evt_id {
 struct download_fragment {
 	const void *buf;
 	size_t len;
+	/** Offset of the fragment in the file. */
+	size_t offset;
 };
 
 /**
@@ -97,6 +99,14 @@ struct download_client_cfg {
 	 *  or NULL to use the default APN.
 	 */
 	const char *apn;
+	/** Deliver fragments in the order they are received, which is not
+	 *  the order of the file when @c CONFIG_DOWNLOAD_CLIENT_PARALLEL
+	 *  is enabled. The application must write each fragment at its
+	 *  offset in the file. The first fragment is always delivered
+	 *  before the file is split in ranges, and the application may
+	 *  clear this option in @c download_client.config at that point.
+	 */
+	bool out_of_order;
 };
 
 /**
@@ -125,6 +135,16 @@ struct download_client {
 	char buf[CONFIG_DOWNLOAD_CLIENT_MAX_RESPONSE_SIZE];
 	/** Buffer offset. */
 	size_t offset;
+	/** Offset of the fragment payload in the buffer,
+	 * past the HTTP header if the buffer holds one.
+	 */
+	size_t body_offset;
+	/** Size of the HTTP header of the last response. */
+	size_t header_len;
+	/** Application buffer used instead of @c buf, if set. */
+	void *app_buf;
+	/** Size of the application buffer. */
+	size_t app_buf_size;
 
 	/** Size of the file being downloaded, in bytes. */
 	size_t file_size;
@@ -132,11 +152,21 @@ struct download_client {
 	size_t progress;
 	/** Fragment size being used for this download. */
 	size_t fragment_size;
+	/** End of the range downloaded over this connection, exclusive.
+	 * This is the file size, unless the file is split in ranges.
+	 */
+	size_t end;
+	/** End of the body of the current response, exclusive. */
+	size_t range_end;
 
 	/** Whether the HTTP header for
 	 * the current fragment has been processed.
 	 */
 	bool has_header;
+	/** Number of characters of the end of the HTTP header
+	 * matched so far.
+	 */
+	u8_t hdr_match;
 	/** The server has closed the connection. */
 	bool connection_close;
 
@@ -157,6 +187,52 @@ struct download_client {
 
 	/** Event handler. */
 	download_client_callback_t callback;
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_PIPELINE)
+	/** Additional response buffers, used in turn with @c buf. */
+	char pipeline_buf[CONFIG_DOWNLOAD_CLIENT_PIPELINE_BUF_CNT - 1]
+			 [CONFIG_DOWNLOAD_CLIENT_MAX_RESPONSE_SIZE];
+	/** Index of the buffer being received into. */
+	u8_t rx_idx;
+	/** Fragments waiting to be delivered to the application. */
+	struct k_msgq fragment_q;
+	/** Storage for the fragment queue. */
+	struct download_fragment
+		fragment_q_buf[CONFIG_DOWNLOAD_CLIENT_PIPELINE_BUF_CNT];
+	/** Buffers available for receiving, besides the current one. */
+	struct k_sem free_bufs;
+	/** Internal thread delivering fragments to the application. */
+	struct k_thread pipeline_thread;
+	/** Internal fragment delivery thread stack. */
+	K_THREAD_STACK_MEMBER(pipeline_thread_stack,
+			      CONFIG_DOWNLOAD_CLIENT_PIPELINE_STACK_SIZE);
+#endif
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+	/** Client that started the download,
+	 * if this is an additional connection.
+	 */
+	struct download_client *parent;
+	/** Additional connections downloading ranges of the file. */
+	struct download_client *
+		conn[CONFIG_DOWNLOAD_CLIENT_PARALLEL_CONN_CNT - 1];
+	/** The file has been split in ranges. */
+	bool split;
+	/** Number of connections that have not completed their range. */
+	u8_t active;
+	/** Offset of the next fragment to deliver, when in order. */
+	size_t deliver_offset;
+	/** Serializes the events of all connections. */
+	struct k_mutex lock;
+	/** Given when the next fragment to deliver may be this one's. */
+	struct k_sem turn;
+#endif
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_PIPELINE) || \
+	defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+	/** The application has refused a fragment. */
+	atomic_t stopped;
+#endif
 };
 
 /**
@@ -190,6 +266,11 @@ int download_client_connect(struct download_client *client, const char *host,
  * which are delivered to the application
  * via @ref DOWNLOAD_CLIENT_EVT_FRAGMENT events.
  *
+ * If @c CONFIG_DOWNLOAD_CLIENT_PARALLEL is enabled, the rest of the file
+ * is split in ranges after the first fragment, which are downloaded over
+ * additional connections. These connections are not affected by
+ * @ref download_client_pause.
+ *
  * @param[in] client	Client instance.
  * @param[in] file	File to download, null-terminated.
  * @param[in] from	Offset from where to resume the download,
@@ -200,6 +281,30 @@ int download_client_connect(struct download_client *client, const char *host,
 int download_client_start(struct download_client *client, const char *file,
 			  size_t from);
 
+/**
+ * @brief Lend a buffer to receive the download into.
+ *
+ * Fragments are received directly into @p buf and delivered to the
+ * application in it, instead of the buffer of the client instance.
+ * All fragments start at the beginning of the buffer: the HTTP request
+ * and the response header are stored in the buffer of the client
+ * instance, and the payload received along with the header is copied
+ * to the lent buffer.
+ *
+ * The buffer must remain valid until the download is done or stopped.
+ * Set the buffer before starting a download.
+ *
+ * @param[in] client	Client instance.
+ * @param[in] buf	Buffer, or NULL to use the buffer of the client.
+ * @param[in] len	Buffer size, in bytes.
+ *
+ * @retval int Zero on success, a negative error code otherwise.
+ *	       -ENOTSUP if @c CONFIG_DOWNLOAD_CLIENT_PIPELINE or
+ *	       @c CONFIG_DOWNLOAD_CLIENT_PARALLEL is enabled.
+ */
+int download_client_buf_set(struct download_client *client, void *buf,
+			    size_t len);
+
 /**
  * @brief Pause the download.
  *
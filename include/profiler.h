@@ -159,6 +159,25 @@ static inline void profiler_log_encode_u32(struct log_event_buf *buf,
 #endif
 
 
+/** @brief Encode and add a string to a buffer.
+ *
+ * The string is truncated if it does not fit in the buffer.
+ *
+ * @warning The buffer must be initialized with @ref profiler_log_start
+ *          before calling this function.
+ *
+ * @param buf Pointer to the data buffer.
+ * @param string Null-terminated string to add to the buffer.
+ */
+#ifdef CONFIG_PROFILER
+void profiler_log_encode_string(struct log_event_buf *buf,
+				const char *string);
+#else
+static inline void profiler_log_encode_string(struct log_event_buf *buf,
+					      const char *string) {}
+#endif
+
+
 /** @brief Encode and add the event's address in memory to the buffer.
  *
  * This information is used for event identification.
@@ -196,6 +215,20 @@ static inline void profiler_log_send(struct log_event_buf *buf,
 #endif
 
 
+/** @brief Get the number of records dropped by the Nordic profiler.
+ *
+ * Records are dropped when the data buffer is full, because the host does
+ * not read data fast enough.
+ *
+ * @return Number of dropped records.
+ */
+#ifdef CONFIG_PROFILER_NORDIC
+u32_t profiler_nordic_dropped_records_get(void);
+#else
+static inline u32_t profiler_nordic_dropped_records_get(void) {return 0; }
+#endif
+
+
 /**
  * @}
  */
@@ -35,6 +35,17 @@ static struct k_thread  socket_thread;
 static at_cmd_handler_t notification_handler;
 static at_cmd_handler_t current_cmd_handler;
 
+/* Asynchronous commands waiting to be sent, and the one being sent. The
+ * command being sent holds cmd_pending, so only one command is in the modem.
+ */
+static sys_slist_t         async_queue;
+static struct at_cmd_async *async_current;
+/* Commands of the batch being sent which are still queued. Blocking writes
+ * may take cmd_pending when there are none.
+ */
+static size_t              async_batch_left;
+static K_MUTEX_DEFINE(async_mtx);
+
 struct return_state_object {
 	int               code;
 	enum at_cmd_state state;
@@ -43,9 +54,10 @@ struct return_state_object {
 K_MSGQ_DEFINE(return_code_msq, sizeof(struct return_state_object), 1, 4);
 
 struct callback_work_item {
-	struct k_work    work;
-	char             data[CONFIG_AT_CMD_RESPONSE_MAX_LEN];
-	at_cmd_handler_t callback;
+	struct k_work       work;
+	char                data[CONFIG_AT_CMD_RESPONSE_MAX_LEN];
+	at_cmd_handler_t    callback;
+	struct at_cmd_async *async;
 };
 
 K_MEM_SLAB_DEFINE(rsp_work_items, sizeof(struct callback_work_item),
@@ -114,13 +126,156 @@ static void callback_worker(struct k_work *item)
 	struct callback_work_item *data =
 		CONTAINER_OF(item, struct callback_work_item, work);
 
-	if (data != NULL) {
+	if (data->async != NULL) {
+		data->async->handler(data->async, data->data);
+	} else {
 		data->callback(data->data);
 	}
 
 	k_mem_slab_free(&rsp_work_items, (void **)&data);
 }
 
+static void async_worker(struct k_work *work)
+{
+	struct at_cmd_async *cmd = CONTAINER_OF(work, struct at_cmd_async, work);
+
+	cmd->handler(cmd, "");
+}
+
+/* Complete a command that got no response from the modem. */
+static void async_fail(struct at_cmd_async *cmd, int code)
+{
+	cmd->code  = code;
+	cmd->state = AT_CMD_ERROR;
+
+	if (cmd->done != NULL) {
+		k_sem_give(cmd->done);
+	}
+
+	if (cmd->handler != NULL) {
+		k_work_init(&cmd->work, async_worker);
+		k_work_submit(&cmd->work);
+	}
+}
+
+/* Cancel the commands queued after a failed command of the same batch. They
+ * are at the head of the queue, since batches are queued at once.
+ */
+static void async_batch_cancel(size_t batch_left)
+{
+	sys_snode_t *node;
+
+	for (size_t i = 0; i < batch_left; i++) {
+		k_mutex_lock(&async_mtx, K_FOREVER);
+		node = sys_slist_get(&async_queue);
+		k_mutex_unlock(&async_mtx);
+
+		async_fail(CONTAINER_OF(node, struct at_cmd_async, node),
+			   -ECANCELED);
+	}
+
+	async_batch_left = 0;
+}
+
+/* Send the next queued asynchronous command, or give cmd_pending back if
+ * there is none. Must be called by the holder of cmd_pending.
+ */
+static void cmd_pending_release(void)
+{
+	struct at_cmd_async *cmd;
+	sys_snode_t *node;
+	size_t batch_left;
+	int bytes_sent;
+
+	for (;;) {
+		k_mutex_lock(&async_mtx, K_FOREVER);
+
+		if (sys_slist_is_empty(&async_queue)) {
+			async_current = NULL;
+			k_sem_give(&cmd_pending);
+			k_mutex_unlock(&async_mtx);
+			return;
+		}
+
+		if (async_batch_left == 0) {
+			/* Between batches, hand cmd_pending to a blocking
+			 * write if one is waiting for it, so that a stream of
+			 * batches does not keep it from being sent.
+			 */
+			async_current = NULL;
+			k_sem_give(&cmd_pending);
+			if (k_sem_take(&cmd_pending, K_NO_WAIT) != 0) {
+				k_mutex_unlock(&async_mtx);
+				return;
+			}
+		}
+
+		node = sys_slist_get(&async_queue);
+		cmd = CONTAINER_OF(node, struct at_cmd_async, node);
+		async_current = cmd;
+		async_batch_left = cmd->batch_left;
+
+		k_mutex_unlock(&async_mtx);
+
+		LOG_DBG("Sending command %s", log_strdup(cmd->cmd));
+
+		bytes_sent = send(common_socket_fd, cmd->cmd, strlen(cmd->cmd),
+				  0);
+		if (bytes_sent != -1) {
+			return;
+		}
+
+		LOG_ERR("Failed to send AT command (err:%d)", errno);
+
+		batch_left = cmd->batch_left;
+		async_fail(cmd, -errno);
+		async_batch_cancel(batch_left);
+	}
+}
+
+/* Complete the asynchronous command being sent with its response, and send
+ * the next one.
+ */
+static void async_complete(struct callback_work_item *item,
+			   const struct return_state_object *ret)
+{
+	struct at_cmd_async *cmd = async_current;
+	size_t batch_left = cmd->batch_left;
+
+	cmd->code  = ret->code;
+	cmd->state = ret->state;
+
+	if (ret->code < 0) {
+		/* Nothing valid was received. */
+		item->data[0] = '\0';
+	}
+
+	/* The system work queue is cooperative, so it would run the handler
+	 * before the next command is sent. Keep this thread scheduled until
+	 * the command is sent, to not leave the modem idle meanwhile.
+	 */
+	k_sched_lock();
+
+	if (cmd->done != NULL) {
+		k_sem_give(cmd->done);
+	}
+
+	if (cmd->handler == NULL) {
+		k_mem_slab_free(&rsp_work_items, (void **)&item);
+	} else {
+		item->async = cmd;
+		k_work_init(&item->work, callback_worker);
+		k_work_submit(&item->work);
+	}
+
+	if (ret->code != 0) {
+		async_batch_cancel(batch_left);
+	}
+
+	cmd_pending_release();
+
+	k_sched_unlock();
+}
 
 static void socket_thread_fn(void *arg1, void *arg2, void *arg3)
 {
@@ -142,6 +297,7 @@ static void socket_thread_fn(void *arg1, void *arg2, void *arg3)
 		ret.code  = 0;
 		ret.state = AT_CMD_OK;
 		item->callback = NULL;
+		item->async = NULL;
 
 		bytes_read = recv(common_socket_fd, item->data,
 				  sizeof(item->data), 0);
@@ -176,7 +332,8 @@ static void socket_thread_fn(void *arg1, void *arg2, void *arg3)
 
 		payload_len = get_return_code(item->data, &ret);
 
-		if (ret.state != AT_CMD_NOTIFICATION) {
+		if ((ret.state != AT_CMD_NOTIFICATION) &&
+		    (async_current == NULL)) {
 			if ((response_buf_len > 0) &&
 			    (response_buf != NULL)) {
 				if (response_buf_len >= payload_len) {
@@ -206,6 +363,12 @@ static void socket_thread_fn(void *arg1, void *arg2, void *arg3)
 			item->callback = current_cmd_handler;
 		}
 next:
+		if ((ret.state != AT_CMD_NOTIFICATION) &&
+		    (async_current != NULL)) {
+			async_complete(item, &ret);
+			continue;
+		}
+
 		/* If no callback was set, free the item.
 		 * Otherwise, work queue callback will free it.
 		 */
@@ -269,7 +432,7 @@ int at_cmd_write_with_callback(const char *const cmd,
 
 	int return_code = at_write(cmd, state);
 
-	k_sem_give(&cmd_pending);
+	cmd_pending_release();
 
 	return return_code;
 }
@@ -286,11 +449,48 @@ int at_cmd_write(const char *const cmd,
 
 	int return_code = at_write(cmd, state);
 
-	k_sem_give(&cmd_pending);
+	cmd_pending_release();
 
 	return return_code;
 }
 
+int at_cmd_write_async(struct at_cmd_async *cmds, size_t count)
+{
+	bool start;
+
+	if ((cmds == NULL) || (count == 0)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (cmds[i].cmd == NULL) {
+			return -EINVAL;
+		}
+	}
+
+	k_mutex_lock(&async_mtx, K_FOREVER);
+
+	for (size_t i = 0; i < count; i++) {
+		cmds[i].code       = 0;
+		cmds[i].state      = AT_CMD_OK;
+		cmds[i].batch_left = count - i - 1;
+		sys_slist_append(&async_queue, &cmds[i].node);
+	}
+
+	/* Otherwise, the holder of cmd_pending sends the commands when it
+	 * is done.
+	 */
+	start = (k_sem_take(&cmd_pending, K_NO_WAIT) == 0);
+
+	k_mutex_unlock(&async_mtx);
+
+	if (start) {
+		cmd_pending_release();
+	}
+
+	return 0;
+}
+
 void at_cmd_set_notification_handler(at_cmd_handler_t handler)
 {
 	LOG_DBG("Setting notification handler to %p", handler);
@@ -303,7 +503,7 @@ void at_cmd_set_notification_handler(at_cmd_handler_t handler)
 
 	notification_handler = handler;
 
-	k_sem_give(&cmd_pending);
+	cmd_pending_release();
 }
 
 static int at_cmd_driver_init(struct device *dev)
@@ -120,6 +120,7 @@ static int at_parse_process_element(const char **str, int index,
 				    struct at_param_list *const list)
 {
 	const char *tmpstr = *str;
+	int err = 0;
 
 	if (is_terminated(*tmpstr)) {
 		return -1;
@@ -132,8 +133,8 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr,
+					   tmpstr - start_ptr);
 	} else if (state == COMMAND) {
 		const char *start_ptr = tmpstr;
 
@@ -143,8 +144,8 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr,
+					   tmpstr - start_ptr);
 
 		/* Skip read/test special characters. */
 		if ((*tmpstr == AT_CMD_SEPARATOR) &&
@@ -164,8 +165,8 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr,
+					   tmpstr - start_ptr);
 
 		tmpstr++;
 	} else if (state == QUOTED_STRING) {
@@ -175,8 +176,8 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr,
+					   tmpstr - start_ptr);
 
 		tmpstr++;
 	} else if (state == ARRAY) {
@@ -207,7 +208,8 @@ static int at_parse_process_element(const char **str, int index,
 			}
 		}
 
-		at_params_array_put(list, index, tmparray, i * sizeof(u32_t));
+		err = at_params_array_put(list, index, tmparray,
+					  i * sizeof(u32_t));
 
 		tmpstr++;
 	} else if (state == NUMBER) {
@@ -229,12 +231,12 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr,
+					   tmpstr - start_ptr);
 	}
 
 	*str = tmpstr;
-	return 0;
+	return err;
 }
 
 /*
@@ -246,6 +248,7 @@ static int at_parse_param(const char **at_params_str,
 			  const size_t max_params)
 {
 	int index = 0;
+	int err;
 	const char *str = *at_params_str;
 	bool oversized = false;
 
@@ -260,8 +263,12 @@ static int at_parse_param(const char **at_params_str,
 			break;
 		}
 
-		if (at_parse_process_element(&str, index, list) == -1) {
+		err = at_parse_process_element(&str, index, list);
+		if (err == -1) {
 			break;
+		} else if (err) {
+			/* The value could not be stored. */
+			return err;
 		}
 
 		if (is_separator(*str)) {
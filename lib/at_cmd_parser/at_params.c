@@ -23,19 +23,48 @@ static void at_param_init(struct at_param *param)
 	memset(param, 0, sizeof(struct at_param));
 }
 
-/* Internal function. Parameter cannot be null. */
-static void at_param_clear(struct at_param *param)
+/* Internal function. Parameters cannot be null. */
+static void at_param_clear(const struct at_param_list *list,
+			   struct at_param *param)
 {
 	__ASSERT(param != NULL, "Parameter cannot be NULL.");
 
-	if ((param->type == AT_PARAM_TYPE_STRING) ||
-	    (param->type == AT_PARAM_TYPE_ARRAY)) {
+	/* Values in an arena are freed when the list is cleared. */
+	if (((param->type == AT_PARAM_TYPE_STRING) ||
+	     (param->type == AT_PARAM_TYPE_ARRAY)) &&
+	    (list->arena == NULL)) {
 		k_free(param->value.str_val);
 	}
 
 	param->value.int_val = 0;
 }
 
+/* Internal function. Parameter cannot be null. */
+static void *at_param_value_alloc(const struct at_param_list *list,
+				  size_t size)
+{
+	__ASSERT(list != NULL, "Parameter list cannot be NULL.");
+
+	struct at_params_arena *arena = list->arena;
+
+	if (arena == NULL) {
+		return k_malloc(size);
+	}
+
+	/* Keep the values aligned for arrays. */
+	size = ROUND_UP(size, sizeof(u32_t));
+
+	if (size > arena->size - arena->used) {
+		return NULL;
+	}
+
+	void *value = &arena->values[arena->used];
+
+	arena->used += size;
+
+	return value;
+}
+
 /* Internal function. Parameter cannot be null. */
 static struct at_param *at_params_get(const struct at_param_list *list,
 				      size_t index)
@@ -81,6 +110,41 @@ int at_params_list_init(struct at_param_list *list, size_t max_params_count)
 	}
 
 	list->param_count = max_params_count;
+	list->arena = NULL;
+	return 0;
+}
+
+int at_params_list_init_buf(struct at_param_list *list,
+			    size_t max_params_count, void *buf,
+			    size_t buf_size)
+{
+	if (list == NULL || buf == NULL) {
+		return -EINVAL;
+	}
+
+	u8_t *start = buf;
+	u8_t *ptr = (u8_t *)ROUND_UP((uintptr_t)buf, sizeof(void *));
+	size_t header_size = sizeof(struct at_params_arena) +
+			     max_params_count * sizeof(struct at_param);
+
+	if (buf_size < (ptr - start) + header_size) {
+		return -ENOMEM;
+	}
+
+	struct at_params_arena *arena = (struct at_params_arena *)ptr;
+
+	ptr += sizeof(struct at_params_arena);
+
+	/* Array initialized with empty parameters. */
+	list->params = (struct at_param *)ptr;
+	memset(list->params, 0, max_params_count * sizeof(struct at_param));
+
+	arena->values = ptr + max_params_count * sizeof(struct at_param);
+	arena->size = buf_size - (arena->values - start);
+	arena->used = 0;
+
+	list->param_count = max_params_count;
+	list->arena = arena;
 	return 0;
 }
 
@@ -93,9 +157,13 @@ void at_params_list_clear(struct at_param_list *list)
 	for (size_t i = 0; i < list->param_count; ++i) {
 		struct at_param *params = list->params;
 
-		at_param_clear(&params[i]);
+		at_param_clear(list, &params[i]);
 		at_param_init(&params[i]);
 	}
+
+	if (list->arena != NULL) {
+		list->arena->used = 0;
+	}
 }
 
 void at_params_list_free(struct at_param_list *list)
@@ -107,8 +175,11 @@ void at_params_list_free(struct at_param_list *list)
 	at_params_list_clear(list);
 
 	list->param_count = 0;
-	k_free(list->params);
+	if (list->arena == NULL) {
+		k_free(list->params);
+	}
 	list->params = NULL;
+	list->arena = NULL;
 }
 
 int at_params_short_put(const struct at_param_list *list, size_t index,
@@ -124,7 +195,7 @@ int at_params_short_put(const struct at_param_list *list, size_t index,
 		return -EINVAL;
 	}
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 
 	param->type = AT_PARAM_TYPE_NUM_SHORT;
 	param->value.int_val = (u32_t)(value & USHRT_MAX);
@@ -143,7 +214,7 @@ int at_params_empty_put(const struct at_param_list *list, size_t index)
 		return -EINVAL;
 	}
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 
 	param->type = AT_PARAM_TYPE_EMPTY;
 	param->value.int_val = 0;
@@ -164,7 +235,7 @@ int at_params_int_put(const struct at_param_list *list, size_t index,
 		return -EINVAL;
 	}
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 
 	param->type = AT_PARAM_TYPE_NUM_INT;
 	param->value.int_val = value;
@@ -184,15 +255,16 @@ int at_params_string_put(const struct at_param_list *list, size_t index,
 		return -EINVAL;
 	}
 
-	char *param_value = (char *)k_malloc(str_len + 1);
+	char *param_value = (char *)at_param_value_alloc(list, str_len + 1);
 
 	if (param_value == NULL) {
 		return -ENOMEM;
 	}
 
 	memcpy(param_value, str, str_len);
+	param_value[str_len] = '\0';
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 	param->size = str_len;
 	param->type = AT_PARAM_TYPE_STRING;
 	param->value.str_val = param_value;
@@ -213,7 +285,7 @@ int at_params_array_put(const struct at_param_list *list, size_t index,
 		return -EINVAL;
 	}
 
-	u32_t *param_value = (u32_t *)k_malloc(array_len);
+	u32_t *param_value = (u32_t *)at_param_value_alloc(list, array_len);
 
 	if (param_value == NULL) {
 		return -ENOMEM;
@@ -221,7 +293,7 @@ int at_params_array_put(const struct at_param_list *list, size_t index,
 
 	memcpy(param_value, array, array_len);
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 	param->size = array_len;
 	param->type = AT_PARAM_TYPE_ARRAY;
 	param->value.array_val = param_value;
@@ -23,20 +23,33 @@ struct notif_handler {
 	at_notif_handler_t handler;
 };
 
+/**@brief Handlers for the notifications with a prefix. */
+struct notif_prefix {
+	char        str[AT_NOTIF_PREFIX_LEN_MAX + 1];
+	u8_t        len;
+	u32_t       dispatch_cnt;
+	sys_slist_t handler_list;
+};
+
+/* Handlers for all notifications. */
 static sys_slist_t handler_list;
 
+/* Sorted by prefix, so that a notification is matched with a binary search. */
+static struct notif_prefix prefixes[CONFIG_AT_NOTIF_PREFIX_COUNT_MAX];
+static size_t prefix_count;
+
 
 /**
  * @brief Find the handler from the notification list.
  *
  * @return The node or NULL if not found and its previous node in @p prev_out.
  */
-static struct notif_handler *find_node(struct notif_handler **prev_out,
-	void *ctx, at_notif_handler_t handler)
+static struct notif_handler *find_node(sys_slist_t *list,
+	struct notif_handler **prev_out, void *ctx, at_notif_handler_t handler)
 {
 	struct notif_handler *prev = NULL, *curr, *tmp;
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&handler_list, curr, tmp, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(list, curr, tmp, node) {
 		if (curr->ctx == ctx && curr->handler == handler) {
 			*prev_out = prev;
 			return curr;
@@ -46,24 +59,131 @@ static struct notif_handler *find_node(struct notif_handler **prev_out,
 	return NULL;
 }
 
+/**
+ * @brief Get the length of the prefix of a notification, which is the text
+ *        before its colon.
+ *
+ * @return The length, or 0 if the prefix is too long to be registered.
+ */
+static size_t notif_prefix_len(const char *notif)
+{
+	for (size_t len = 0; len <= AT_NOTIF_PREFIX_LEN_MAX; len++) {
+		switch (notif[len]) {
+		case ':':
+		case ' ':
+		case '\r':
+		case '\n':
+		case '\0':
+			return len;
+		default:
+			break;
+		}
+	}
+	return 0;
+}
+
+static bool prefix_valid(const char *prefix)
+{
+	size_t len = strlen(prefix);
+
+	return (len != 0) && (notif_prefix_len(prefix) == len);
+}
+
+/**
+ * @brief Search the prefix table.
+ *
+ * @return Index of the prefix, or where it would be inserted if
+ *         @p found_out is false.
+ */
+static size_t prefix_search(const char *str, size_t len, bool *found_out)
+{
+	size_t lo = 0, hi = prefix_count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		int cmp = memcmp(prefixes[mid].str, str,
+				 MIN(prefixes[mid].len, len));
+
+		if (cmp == 0) {
+			cmp = (int)prefixes[mid].len - (int)len;
+		}
+
+		if (cmp == 0) {
+			*found_out = true;
+			return mid;
+		} else if (cmp < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	*found_out = false;
+	return lo;
+}
+
+/**
+ * @brief Get the handler list of a prefix, and add the prefix to the table
+ *        if @p add is true and it is not there.
+ *
+ * @return The handler list or NULL if not found, or if the table is full.
+ */
+static sys_slist_t *prefix_list_get(const char *prefix, bool add)
+{
+	size_t len = strlen(prefix);
+	bool found;
+	size_t idx = prefix_search(prefix, len, &found);
+
+	if (found) {
+		return &prefixes[idx].handler_list;
+	}
+
+	if (!add || (prefix_count == ARRAY_SIZE(prefixes))) {
+		return NULL;
+	}
+
+	memmove(&prefixes[idx + 1], &prefixes[idx],
+		(prefix_count - idx) * sizeof(prefixes[0]));
+	prefix_count++;
+
+	memset(&prefixes[idx], 0, sizeof(prefixes[0]));
+	memcpy(prefixes[idx].str, prefix, len);
+	prefixes[idx].len = len;
+	sys_slist_init(&prefixes[idx].handler_list);
+
+	return &prefixes[idx].handler_list;
+}
+
+/**@brief Remove a prefix from the table if it has no handlers left. */
+static void prefix_remove_unused(const char *prefix)
+{
+	bool found;
+	size_t idx = prefix_search(prefix, strlen(prefix), &found);
+
+	if (!found || !sys_slist_is_empty(&prefixes[idx].handler_list)) {
+		return;
+	}
+
+	prefix_count--;
+	memmove(&prefixes[idx], &prefixes[idx + 1],
+		(prefix_count - idx) * sizeof(prefixes[0]));
+}
+
 /**@brief Add the handler in the notification list if not already present. */
-static int append_notif_handler(void *ctx, at_notif_handler_t handler)
+static int append_notif_handler(sys_slist_t *list, void *ctx,
+				at_notif_handler_t handler)
 {
 	struct notif_handler *to_ins;
 
-	k_mutex_lock(&list_mtx, K_FOREVER);
-
 	/* Check if handler is already registered. */
-	if (find_node(&to_ins, ctx, handler) != NULL) {
+	if (find_node(list, &to_ins, ctx, handler) != NULL) {
 		LOG_DBG("Handler already registered. Nothing to do");
-		k_mutex_unlock(&list_mtx);
 		return 0;
 	}
 
 	/* Allocate memory and fill. */
 	to_ins = (struct notif_handler *)k_malloc(sizeof(struct notif_handler));
 	if (to_ins == NULL) {
-		k_mutex_unlock(&list_mtx);
 		return -ENOBUFS;
 	}
 	memset(to_ins, 0, sizeof(struct notif_handler));
@@ -71,48 +191,65 @@ static int append_notif_handler(void *ctx, at_notif_handler_t handler)
 	to_ins->handler = handler;
 
 	/* Insert handler in the list. */
-	sys_slist_append(&handler_list, &to_ins->node);
-	k_mutex_unlock(&list_mtx);
+	sys_slist_append(list, &to_ins->node);
 	return 0;
 }
 
 /**@brief Remove the handler from the notification list if registered. */
-static int remove_notif_handler(void *ctx, at_notif_handler_t handler)
+static int remove_notif_handler(sys_slist_t *list, void *ctx,
+				at_notif_handler_t handler)
 {
 	struct notif_handler *curr, *prev = NULL;
 
-	k_mutex_lock(&list_mtx, K_FOREVER);
-
 	/* Check if the handler is registered before removing it. */
-	curr = find_node(&prev, ctx, handler);
+	curr = find_node(list, &prev, ctx, handler);
 	if (curr == NULL) {
 		LOG_WRN("Handler not registered. Nothing to do");
-		k_mutex_unlock(&list_mtx);
 		return 0;
 	}
 
 	/* Remove the handler from the list. */
-	sys_slist_remove(&handler_list, &prev->node, &curr->node);
+	sys_slist_remove(list, &prev->node, &curr->node);
 	k_free(curr);
 
-	k_mutex_unlock(&list_mtx);
 	return 0;
 }
 
+static void handlers_call(sys_slist_t *list, const char *response)
+{
+	struct notif_handler *curr, *tmp;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(list, curr, tmp, node) {
+		LOG_DBG(" - ctx=0x%08X, handler=0x%08X", (u32_t)curr->ctx,
+			(u32_t)curr->handler);
+		curr->handler(curr->ctx, response);
+	}
+}
+
 /**@brief AT command notifications handler. */
 static void notif_dispatch(const char *response)
 {
-	struct notif_handler *curr, *tmp;
+	size_t len = notif_prefix_len(response);
+	bool found = false;
+	size_t idx = 0;
 
 	k_mutex_lock(&list_mtx, K_FOREVER);
 
-	/* Dispatch notifications to all registered handlers */
 	LOG_DBG("Dispatching events:");
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&handler_list, curr, tmp, node) {
-		LOG_DBG(" - ctx=0x%08X, handler=0x%08X", (u32_t)curr->ctx,
-			(u32_t)curr->handler);
-		curr->handler(curr->ctx, response);
+
+	/* Dispatch notifications to the handlers of their prefix, ... */
+	if (len != 0) {
+		idx = prefix_search(response, len, &found);
+	}
+
+	if (found) {
+		prefixes[idx].dispatch_cnt++;
+		handlers_call(&prefixes[idx].handler_list, response);
 	}
+
+	/* ... and to the handlers of all notifications. */
+	handlers_call(&handler_list, response);
+
 	LOG_DBG("Done");
 
 	k_mutex_unlock(&list_mtx);
@@ -149,7 +286,12 @@ int at_notif_register_handler(void *context, at_notif_handler_t handler)
 			(u32_t)context, (u32_t)handler);
 		return -EINVAL;
 	}
-	return append_notif_handler(context, handler);
+
+	k_mutex_lock(&list_mtx, K_FOREVER);
+	int err = append_notif_handler(&handler_list, context, handler);
+
+	k_mutex_unlock(&list_mtx);
+	return err;
 }
 
 int at_notif_deregister_handler(void *context, at_notif_handler_t handler)
@@ -159,7 +301,88 @@ int at_notif_deregister_handler(void *context, at_notif_handler_t handler)
 			(u32_t)context, (u32_t)handler);
 		return -EINVAL;
 	}
-	return remove_notif_handler(context, handler);
+
+	k_mutex_lock(&list_mtx, K_FOREVER);
+	int err = remove_notif_handler(&handler_list, context, handler);
+
+	k_mutex_unlock(&list_mtx);
+	return err;
+}
+
+int at_notif_register_prefix_handler(void *context, const char *prefix,
+				     at_notif_handler_t handler)
+{
+	sys_slist_t *list;
+	int err;
+
+	if ((handler == NULL) || (prefix == NULL) || !prefix_valid(prefix)) {
+		LOG_ERR("Invalid handler (context=0x%08X, handler=0x%08X)",
+			(u32_t)context, (u32_t)handler);
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&list_mtx, K_FOREVER);
+
+	list = prefix_list_get(prefix, true);
+	if (list == NULL) {
+		LOG_ERR("No room for prefix %s", log_strdup(prefix));
+		k_mutex_unlock(&list_mtx);
+		return -ENOBUFS;
+	}
+
+	err = append_notif_handler(list, context, handler);
+	if (err) {
+		prefix_remove_unused(prefix);
+	}
+
+	k_mutex_unlock(&list_mtx);
+	return err;
+}
+
+int at_notif_deregister_prefix_handler(void *context, const char *prefix,
+				       at_notif_handler_t handler)
+{
+	sys_slist_t *list;
+	int err = 0;
+
+	if ((handler == NULL) || (prefix == NULL)) {
+		LOG_ERR("Invalid handler (context=0x%08X, handler=0x%08X)",
+			(u32_t)context, (u32_t)handler);
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&list_mtx, K_FOREVER);
+
+	list = prefix_list_get(prefix, false);
+	if (list == NULL) {
+		LOG_WRN("Handler not registered. Nothing to do");
+	} else {
+		err = remove_notif_handler(list, context, handler);
+		prefix_remove_unused(prefix);
+	}
+
+	k_mutex_unlock(&list_mtx);
+	return err;
+}
+
+int at_notif_dispatch_count_get(const char *prefix, u32_t *count)
+{
+	bool found;
+	size_t idx;
+
+	if ((prefix == NULL) || (count == NULL)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&list_mtx, K_FOREVER);
+
+	idx = prefix_search(prefix, strlen(prefix), &found);
+	if (found) {
+		*count = prefixes[idx].dispatch_cnt;
+	}
+
+	k_mutex_unlock(&list_mtx);
+	return found ? 0 : -ENOENT;
 }
 
 #ifdef CONFIG_AT_NOTIF_SYS_INIT
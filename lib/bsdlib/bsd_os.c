@@ -16,6 +16,9 @@
 #include <zephyr/types.h>
 #include <errno.h>
 #include <logging/log.h>
+#include <modem/bsdlib.h>
+
+#include "wakeup_stats.h"
 
 #ifdef CONFIG_BSD_LIBRARY_TRACE_ENABLED
 #include <nrfx_uarte.h>
@@ -54,25 +57,36 @@ void IPC_IRQHandler(void);
 
 LOG_MODULE_REGISTER(bsdlib);
 
-struct sleeping_thread {
-	sys_snode_t node;
-	struct k_sem sem;
-};
-
 /* An array of thread ID and RPC counter pairs, used to avoid race conditions.
  * It allows to identify whether it is safe to put the thread to sleep or not.
  */
 static struct thread_monitor_entry {
 	k_tid_t id; /* Thread ID. */
 	int cnt; /* Last RPC event count. */
+	u32_t context; /* Context of the last wait. */
+	bool woken; /* Whether the last wait was ended by an RPC event. */
+	bool in_call; /* Whether the thread is in a socket call. */
 } thread_event_monitor[THREAD_MONITOR_ENTRIES];
 
+struct sleeping_thread {
+	sys_snode_t node;
+	struct k_sem sem;
+	/* Monitor entry of the thread, found when it is added. */
+	struct thread_monitor_entry *entry;
+};
+
 /* A list of threads that are sleeping and should be woken up on next event. */
 static sys_slist_t sleeping_threads;
 
 /* RPC event counter, incremented on each RPC event. */
 static atomic_t rpc_event_cnt;
 
+/* Number of waits ended by an RPC event, and of those after which the thread
+ * waited again in the same context, within the same socket call.
+ */
+static atomic_t wakeup_cnt;
+static atomic_t spurious_wakeup_cnt;
+
 /* Get thread monitor structure assigned to a specific thread id, with a RPC
  * counter value at which bsdlib last checked the 'readiness' of a thread
  */
@@ -101,6 +115,8 @@ static struct thread_monitor_entry *thread_monitor_entry_get(k_tid_t id)
 
 	new_entry->id = id;
 	new_entry->cnt = rpc_event_cnt - 1;
+	new_entry->woken = false;
+	new_entry->in_call = false;
 
 	return new_entry;
 }
@@ -133,10 +149,28 @@ static void sleeping_thread_init(struct sleeping_thread *thread)
 	k_sem_init(&thread->sem, 0, 1);
 }
 
+/* Record the context of a wait. Within a socket call, bsdlib waits again in
+ * the same context when the event that woke the thread up was not for it.
+ * A wait in the next call, for example the next recv() on the same socket,
+ * is not counted.
+ */
+static void thread_monitor_context_set(struct thread_monitor_entry *entry,
+				       u32_t context)
+{
+	if (IS_ENABLED(CONFIG_BSD_LIBRARY_WAKEUP_STATS) && entry->in_call &&
+	    entry->woken && entry->context == context) {
+		atomic_inc(&spurious_wakeup_cnt);
+	}
+
+	entry->context = context;
+	entry->woken = false;
+}
+
 /* Add thread to the sleeping threads list. Will return information whether
  * the thread was allowed to sleep or not.
  */
-static bool sleeping_thread_add(struct sleeping_thread *thread)
+static bool sleeping_thread_add(struct sleeping_thread *thread,
+				u32_t context)
 {
 	bool allow_to_sleep = false;
 	struct thread_monitor_entry *entry;
@@ -144,9 +178,11 @@ static bool sleeping_thread_add(struct sleeping_thread *thread)
 	u32_t key = irq_lock();
 
 	entry = thread_monitor_entry_get(k_current_get());
+	thread_monitor_context_set(entry, context);
 
 	if (can_thread_sleep(entry)) {
 		allow_to_sleep = true;
+		thread->entry = entry;
 		sys_slist_append(&sleeping_threads, &thread->node);
 	}
 
@@ -156,24 +192,36 @@ static bool sleeping_thread_add(struct sleeping_thread *thread)
 }
 
 /* Remove a thread form the sleeping threads list. */
-static void sleeping_thread_remove(struct sleeping_thread *thread)
+static void sleeping_thread_remove(struct sleeping_thread *thread, bool woken)
 {
-	struct thread_monitor_entry *entry;
+	struct thread_monitor_entry *entry = thread->entry;
 
 	u32_t key = irq_lock();
 
 	sys_slist_find_and_remove(&sleeping_threads, &thread->node);
 
-	entry = thread_monitor_entry_get(k_current_get());
+	/* The entry is only searched again if it was taken over by another
+	 * thread while this one was sleeping.
+	 */
+	if (entry->id != k_current_get()) {
+		entry = thread_monitor_entry_get(k_current_get());
+	}
+
 	thread_monitor_entry_update(entry);
+	entry->woken = woken;
 
 	irq_unlock(key);
+
+	if (IS_ENABLED(CONFIG_BSD_LIBRARY_WAKEUP_STATS) && woken) {
+		atomic_inc(&wakeup_cnt);
+	}
 }
 
 int32_t bsd_os_timedwait(uint32_t context, int32_t *timeout)
 {
 	struct sleeping_thread thread;
 	s64_t start, remaining;
+	int err;
 
 	start = k_uptime_get();
 
@@ -188,13 +236,13 @@ int32_t bsd_os_timedwait(uint32_t context, int32_t *timeout)
 
 	sleeping_thread_init(&thread);
 
-	if (!sleeping_thread_add(&thread)) {
+	if (!sleeping_thread_add(&thread, context)) {
 		return 0;
 	}
 
-	(void)k_sem_take(&thread.sem, SYS_TIMEOUT_MS(*timeout));
+	err = k_sem_take(&thread.sem, SYS_TIMEOUT_MS(*timeout));
 
-	sleeping_thread_remove(&thread);
+	sleeping_thread_remove(&thread, err == 0);
 
 	if (*timeout == SYS_FOREVER_MS) {
 		return 0;
@@ -211,6 +259,42 @@ int32_t bsd_os_timedwait(uint32_t context, int32_t *timeout)
 	return 0;
 }
 
+#ifdef CONFIG_BSD_LIBRARY_WAKEUP_STATS
+static void thread_monitor_call_set(bool in_call)
+{
+	struct thread_monitor_entry *entry;
+	u32_t key = irq_lock();
+
+	entry = thread_monitor_entry_get(k_current_get());
+	entry->in_call = in_call;
+	entry->woken = false;
+
+	irq_unlock(key);
+}
+
+void wakeup_stats_call_begin(void)
+{
+	thread_monitor_call_set(true);
+}
+
+void wakeup_stats_call_end(void)
+{
+	thread_monitor_call_set(false);
+}
+#endif
+
+int bsdlib_wakeup_stats_get(struct bsdlib_wakeup_stats *stats)
+{
+	if (!IS_ENABLED(CONFIG_BSD_LIBRARY_WAKEUP_STATS)) {
+		return -ENOTSUP;
+	}
+
+	stats->wakeups = atomic_get(&wakeup_cnt);
+	stats->spurious_wakeups = atomic_get(&spurious_wakeup_cnt);
+
+	return 0;
+}
+
 void bsd_os_errno_set(int err_code)
 {
 	switch (err_code) {
@@ -371,7 +455,9 @@ ISR_DIRECT_DECLARE(rpc_proxy_irq_handler)
 
 	struct sleeping_thread *thread;
 
-	/* Wake up all sleeping threads. */
+	/* Wake up all sleeping threads, since the event does not tell which
+	 * context it is for.
+	 */
 	SYS_SLIST_FOR_EACH_CONTAINER(&sleeping_threads, thread, node) {
 		k_sem_give(&thread->sem);
 	}
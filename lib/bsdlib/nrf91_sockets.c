@@ -22,6 +22,8 @@
 #include <sys/fdtable.h>
 #include <zephyr.h>
 
+#include "wakeup_stats.h"
+
 #if defined(CONFIG_NET_SOCKETS_OFFLOAD)
 
 #if defined(CONFIG_NRF91_SOCKET_ENABLE_DEBUG_LOGS)
@@ -530,7 +532,8 @@ static int nrf91_socket_offload_accept(void *obj, struct sockaddr *addr,
 		}
 	}
 
-	new_sd = nrf_accept(sd, nrf_addr_ptr, nrf_addrlen_ptr);
+	new_sd = WAKEUP_STATS_CALL(nrf_accept(sd, nrf_addr_ptr,
+					      nrf_addrlen_ptr));
 	if (new_sd < 0) {
 		/* nrf_accept sets errno appropriately */
 		return -1;
@@ -607,17 +610,20 @@ static int nrf91_socket_offload_connect(void *obj, const struct sockaddr *addr,
 		struct nrf_sockaddr_in ipv4;
 
 		z_to_nrf_ipv4(addr, &ipv4);
-		retval = nrf_connect(sd, (const struct nrf_sockaddr_in *)&ipv4,
-				     sizeof(struct nrf_sockaddr_in));
+		retval = WAKEUP_STATS_CALL(
+			nrf_connect(sd, (const struct nrf_sockaddr_in *)&ipv4,
+				    sizeof(struct nrf_sockaddr_in)));
 	} else if (addr->sa_family == AF_INET6) {
 		struct nrf_sockaddr_in6 ipv6;
 
 		z_to_nrf_ipv6(addr, &ipv6);
-		retval = nrf_connect(sd, (const struct nrf_sockaddr *)&ipv6,
-				  sizeof(struct nrf_sockaddr_in6));
+		retval = WAKEUP_STATS_CALL(
+			nrf_connect(sd, (const struct nrf_sockaddr *)&ipv6,
+				    sizeof(struct nrf_sockaddr_in6)));
 	} else {
 		/* Pass in raw to library as it is non-IP address. */
-		retval = nrf_connect(sd, (void *)addr, addrlen);
+		retval = WAKEUP_STATS_CALL(nrf_connect(sd, (void *)addr,
+						       addrlen));
 		if (retval < 0) {
 			/* Not supported by library. */
 			goto error;
@@ -729,16 +735,18 @@ static ssize_t nrf91_socket_offload_recvfrom(void *obj, void *buf, size_t len,
 	ssize_t retval;
 
 	if (from == NULL) {
-		retval = nrf_recvfrom(sd, buf, len, z_to_nrf_flags(flags), NULL,
-				      NULL);
+		retval = WAKEUP_STATS_CALL(
+			nrf_recvfrom(sd, buf, len, z_to_nrf_flags(flags), NULL,
+				     NULL));
 	} else {
 		/* Allocate space for maximum of IPv4 and IPv6 family type. */
 		struct nrf_sockaddr_in6 cliaddr_storage;
 		nrf_socklen_t sock_len = sizeof(struct nrf_sockaddr_in6);
 		struct nrf_sockaddr *cliaddr = (struct nrf_sockaddr *)&cliaddr_storage;
 
-		retval = nrf_recvfrom(sd, buf, len, z_to_nrf_flags(flags),
-				      cliaddr, &sock_len);
+		retval = WAKEUP_STATS_CALL(
+			nrf_recvfrom(sd, buf, len, z_to_nrf_flags(flags),
+				     cliaddr, &sock_len));
 		if (cliaddr->sa_family == NRF_AF_INET) {
 			nrf_to_z_ipv4(from, (struct nrf_sockaddr_in *)cliaddr);
 			*fromlen = sizeof(struct sockaddr_in);
@@ -765,22 +773,25 @@ static ssize_t nrf91_socket_offload_sendto(void *obj, const void *buf,
 	}
 
 	if (to == NULL) {
-		retval = nrf_sendto(sd, buf, len, z_to_nrf_flags(flags), NULL,
-				    0);
+		retval = WAKEUP_STATS_CALL(
+			nrf_sendto(sd, buf, len, z_to_nrf_flags(flags), NULL,
+				   0));
 	} else if (to->sa_family == AF_INET) {
 		struct nrf_sockaddr_in ipv4;
 		nrf_socklen_t sock_len = sizeof(struct nrf_sockaddr_in);
 
 		z_to_nrf_ipv4(to, &ipv4);
-		retval = nrf_sendto(sd, buf, len, z_to_nrf_flags(flags), &ipv4,
-				    sock_len);
+		retval = WAKEUP_STATS_CALL(
+			nrf_sendto(sd, buf, len, z_to_nrf_flags(flags), &ipv4,
+				   sock_len));
 	} else if (to->sa_family == AF_INET6) {
 		struct nrf_sockaddr_in6 ipv6;
 		nrf_socklen_t sock_len = sizeof(struct nrf_sockaddr_in6);
 
 		z_to_nrf_ipv6(to, &ipv6);
-		retval = nrf_sendto(sd, buf, len, z_to_nrf_flags(flags), &ipv6,
-				    sock_len);
+		retval = WAKEUP_STATS_CALL(
+			nrf_sendto(sd, buf, len, z_to_nrf_flags(flags), &ipv6,
+				   sock_len));
 	} else {
 		goto error;
 	}
@@ -902,7 +913,8 @@ static inline int nrf91_socket_offload_poll(struct pollfd *fds, int nfds,
 		return retval;
 	}
 
-	retval = nrf_poll((struct nrf_pollfd *)&tmp, nfds, timeout);
+	retval = WAKEUP_STATS_CALL(nrf_poll((struct nrf_pollfd *)&tmp, nfds,
+					   timeout));
 
 	/* Translate the API from nRF to native. */
 	/* No need to translate .events, shall be untouched by poll() */
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef WAKEUP_STATS_H__
+#define WAKEUP_STATS_H__
+
+/* Mark the bsdlib calls made by the socket offload layer, so that a thread
+ * which waits again within a call can be told apart from one which waits in
+ * its next call.
+ */
+#ifdef CONFIG_BSD_LIBRARY_WAKEUP_STATS
+void wakeup_stats_call_begin(void);
+void wakeup_stats_call_end(void);
+#else
+static inline void wakeup_stats_call_begin(void) {}
+static inline void wakeup_stats_call_end(void) {}
+#endif
+
+/* Make a bsdlib call which may wait for an event. */
+#define WAKEUP_STATS_CALL(call) ({		\
+	__typeof__(call) _ret;			\
+						\
+	wakeup_stats_call_begin();		\
+	_ret = (call);				\
+	wakeup_stats_call_end();		\
+	_ret;					\
+})
+
+#endif /* WAKEUP_STATS_H__ */
@@ -216,6 +216,12 @@ static bool is_relevant_notif(const char *notif, enum lte_lc_notif_type *type)
 	return false;
 }
 
+/* Storage of the parameters of the notifications, which are parsed one at a
+ * time by the AT handler.
+ */
+static u8_t notif_params_buf[AT_PARAMS_LIST_BUF_SIZE(AT_CEREG_PARAMS_COUNT_MAX,
+						   AT_CEREG_RESPONSE_MAX_LEN)];
+
 static int parse_cereg(const char *notification,
 		       enum lte_lc_nw_reg_status *reg_status,
 		       struct lte_lc_cell *cell,
@@ -226,7 +232,9 @@ static int parse_cereg(const char *notification,
 	char str_buf[10];
 	size_t len = sizeof(str_buf) - 1;
 
-	err = at_params_list_init(&resp_list, AT_CEREG_PARAMS_COUNT_MAX);
+	err = at_params_list_init_buf(&resp_list, AT_CEREG_PARAMS_COUNT_MAX,
+				      notif_params_buf,
+				      sizeof(notif_params_buf));
 	if (err) {
 		LOG_ERR("Could not init AT params list, error: %d", err);
 		return err;
@@ -486,6 +494,52 @@ static int parse_psm_cfg(struct at_param_list *at_params,
 	return 0;
 }
 
+/* Configuration commands sent at initialization. They are sent as one
+ * batch, so the modem does not wait for this thread between them. The
+ * semaphore is given by the AT socket thread, so the batch can be waited for
+ * on the system work queue.
+ */
+static struct at_cmd_async init_cmds[7];
+static size_t init_cmd_count;
+static K_SEM_DEFINE(init_cmds_done, 0, ARRAY_SIZE(init_cmds));
+
+static void init_cmd_add(const char *cmd)
+{
+	__ASSERT_NO_MSG(init_cmd_count < ARRAY_SIZE(init_cmds));
+
+	init_cmds[init_cmd_count++] = (struct at_cmd_async){
+		.cmd = cmd,
+		.done = &init_cmds_done,
+	};
+}
+
+static int init_cmds_write(void)
+{
+	int err;
+	size_t count = init_cmd_count;
+
+	init_cmd_count = 0;
+
+	err = at_cmd_write_async(init_cmds, count);
+	if (err) {
+		return err;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		k_sem_take(&init_cmds_done, K_FOREVER);
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (init_cmds[i].code != 0) {
+			LOG_ERR("%s failed, error: %d",
+				log_strdup(init_cmds[i].cmd), init_cmds[i].code);
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
 static int w_lte_lc_init(void)
 {
 	int err;
@@ -494,10 +548,13 @@ static int w_lte_lc_init(void)
 		return -EALREADY;
 	}
 
-	err = at_notif_register_handler(NULL, at_handler);
-	if (err) {
-		LOG_ERR("Can't register AT handler, error: %d", err);
-		return err;
+	for (size_t i = 0; i < ARRAY_SIZE(at_notifs); i++) {
+		err = at_notif_register_prefix_handler(NULL, at_notifs[i],
+						       at_handler);
+		if (err) {
+			LOG_ERR("Can't register AT handler, error: %d", err);
+			return err;
+		}
 	}
 
 	err = lte_lc_system_mode_set(sys_mode_preferred);
@@ -526,52 +583,47 @@ static int w_lte_lc_init(void)
 	}
 #endif
 #if defined(CONFIG_BSD_LIBRARY_TRACE_ENABLED)
-	if (at_cmd_write(mdm_trace, NULL, 0, NULL) != 0) {
-		return -EIO;
-	}
+	init_cmd_add(mdm_trace);
 #endif
-	if (at_cmd_write(cereg_5_subscribe, NULL, 0, NULL) != 0) {
-		return -EIO;
-	}
-
+	init_cmd_add(cereg_5_subscribe);
 #if defined(CONFIG_LTE_LOCK_BANDS)
 	/* Set LTE band lock (volatile setting).
 	 * Has to be done every time before activating the modem.
 	 */
-	if (at_cmd_write(lock_bands, NULL, 0, NULL) != 0) {
-		return -EIO;
-	}
+	init_cmd_add(lock_bands);
 #endif
 #if defined(CONFIG_LTE_LOCK_PLMN)
 	/* Manually select Operator (volatile setting).
 	 * Has to be done every time before activating the modem.
 	 */
-	if (at_cmd_write(lock_plmn, NULL, 0, NULL) != 0) {
-		return -EIO;
-	}
+	init_cmd_add(lock_plmn);
 #elif defined(CONFIG_LTE_UNLOCK_PLMN)
 	/* Automatically select Operator (volatile setting).
 	 */
-	if (at_cmd_write(unlock_plmn, NULL, 0, NULL) != 0) {
-		return -EIO;
-	}
+	init_cmd_add(unlock_plmn);
 #endif
 #if defined(CONFIG_LTE_LEGACY_PCO_MODE)
-	if (at_cmd_write(legacy_pco, NULL, 0, NULL) != 0) {
-		return -EIO;
+	init_cmd_add(legacy_pco);
+#endif
+#if defined(CONFIG_LTE_PDP_CMD)
+	init_cmd_add(cgdcont);
+#endif
+#if defined(CONFIG_LTE_PDN_AUTH_CMD)
+	init_cmd_add(cgauth);
+#endif
+
+	err = init_cmds_write();
+	if (err) {
+		return err;
 	}
+
+#if defined(CONFIG_LTE_LEGACY_PCO_MODE)
 	LOG_INF("Using legacy LTE PCO mode...");
 #endif
 #if defined(CONFIG_LTE_PDP_CMD)
-	if (at_cmd_write(cgdcont, NULL, 0, NULL) != 0) {
-		return -EIO;
-	}
 	LOG_INF("PDP Context: %s", log_strdup(cgdcont));
 #endif
 #if defined(CONFIG_LTE_PDN_AUTH_CMD)
-	if (at_cmd_write(cgauth, NULL, 0, NULL) != 0) {
-		return -EIO;
-	}
 	LOG_INF("PDN Auth: %s", log_strdup(cgauth));
 #endif
 
@@ -1065,7 +1117,9 @@ static int parse_rrc_mode(const char *at_response,
 	int err, temp_mode;
 	struct at_param_list resp_list = {0};
 
-	err = at_params_list_init(&resp_list, AT_CSCON_PARAMS_COUNT_MAX);
+	err = at_params_list_init_buf(&resp_list, AT_CSCON_PARAMS_COUNT_MAX,
+				      notif_params_buf,
+				      sizeof(notif_params_buf));
 	if (err) {
 		LOG_ERR("Could not init AT params list, error: %d", err);
 		return err;
@@ -1219,7 +1273,9 @@ static int parse_edrx(const char *at_response,
 		return err;
 	}
 
-	err = at_params_list_init(&resp_list, AT_CEDRXP_PARAMS_COUNT_MAX);
+	err = at_params_list_init_buf(&resp_list, AT_CEDRXP_PARAMS_COUNT_MAX,
+				      notif_params_buf,
+				      sizeof(notif_params_buf));
 	if (err) {
 		LOG_ERR("Could not init AT params list, error: %d", err);
 		return err;
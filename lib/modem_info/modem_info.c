@@ -18,6 +18,8 @@
 #include <zephyr/types.h>
 #include <logging/log.h>
 
+#include "modem_info_internal.h"
+
 LOG_MODULE_REGISTER(modem_info);
 
 #define INVALID_DESCRIPTOR	-1
@@ -343,11 +345,6 @@ static const struct modem_info_data *const modem_data[] = {
 static rsrp_cb_t modem_info_rsrp_cb;
 static struct at_param_list m_param_list;
 
-static bool is_cesq_notification(const char *buf, size_t len)
-{
-	return strstr(buf, AT_CMD_CESQ_RESP) ? true : false;
-}
-
 static void flip_iccid_string(char *buf)
 {
 	u8_t current_char;
@@ -417,30 +414,24 @@ int modem_info_name_get(enum modem_info info, char *name)
 	return len;
 }
 
-int modem_info_short_get(enum modem_info info, u16_t *buf)
+const char *modem_info_cmd_get(enum modem_info info)
 {
-	int err;
-	char recv_buf[CONFIG_MODEM_INFO_BUFFER_SIZE] = {0};
-	int cmd_length = 0;
-
-	if (buf == NULL) {
-		return -EINVAL;
+	if (info >= MODEM_INFO_COUNT) {
+		return NULL;
 	}
 
-	if (modem_data[info]->data_type == AT_PARAM_TYPE_STRING) {
-		return -EINVAL;
-	}
+	return modem_data[info]->cmd;
+}
 
-	err = at_cmd_write(modem_data[info]->cmd,
-			   recv_buf,
-			   CONFIG_MODEM_INFO_BUFFER_SIZE,
-			   NULL);
+int modem_info_short_parse(enum modem_info info, const char *rsp, u16_t *buf)
+{
+	int err;
 
-	if (err != 0) {
-		return -EIO;
+	if (modem_data[info]->data_type == AT_PARAM_TYPE_STRING) {
+		return -EINVAL;
 	}
 
-	err = modem_info_parse(modem_data[info], &recv_buf[cmd_length]);
+	err = modem_info_parse(modem_data[info], rsp);
 
 	if (err) {
 		return err;
@@ -457,14 +448,38 @@ int modem_info_short_get(enum modem_info info, u16_t *buf)
 	return sizeof(u16_t);
 }
 
-int modem_info_string_get(enum modem_info info, char *buf,
-				  const size_t buf_size)
+int modem_info_short_get(enum modem_info info, u16_t *buf)
 {
 	int err;
 	char recv_buf[CONFIG_MODEM_INFO_BUFFER_SIZE] = {0};
+
+	if (buf == NULL) {
+		return -EINVAL;
+	}
+
+	if (modem_data[info]->data_type == AT_PARAM_TYPE_STRING) {
+		return -EINVAL;
+	}
+
+	err = at_cmd_write(modem_data[info]->cmd,
+			   recv_buf,
+			   CONFIG_MODEM_INFO_BUFFER_SIZE,
+			   NULL);
+
+	if (err != 0) {
+		return -EIO;
+	}
+
+	return modem_info_short_parse(info, recv_buf, buf);
+}
+
+int modem_info_string_parse(enum modem_info info, char *rsp, char *buf,
+			    const size_t buf_size)
+{
+	int err;
 	u16_t param_value;
 	int ip_cnt = 0;
-	char *ip_str_end = recv_buf;
+	char *ip_str_end = rsp;
 	/* index into the AT cmd response buffer */
 	size_t cmd_rsp_idx = 0;
 	/* length of each parsed IP address line */
@@ -474,20 +489,11 @@ int modem_info_string_get(enum modem_info info, char *buf,
 	/* return value indicating length of the string written to buf */
 	size_t len = 0;
 
-	if ((buf == NULL) || (buf_size == 0)) {
-		return -EINVAL;
-	}
-
-	err = at_cmd_write(modem_data[info]->cmd,
-			  recv_buf,
-			  CONFIG_MODEM_INFO_BUFFER_SIZE,
-			  NULL);
-
 	/* modem_info does not yet support array objects, so here we handle
 	 * the supported bands independently as a string
 	 */
 	if (info == MODEM_INFO_SUP_BAND) {
-		strcpy(buf, recv_buf + sizeof("%XCBAND: ") - 1);
+		snprintf(buf, buf_size, "%s", rsp + sizeof("%XCBAND: ") - 1);
 		return strlen(buf);
 	}
 	if (info == MODEM_INFO_IP_ADDRESS) {
@@ -500,22 +506,18 @@ int modem_info_string_get(enum modem_info info, char *buf,
 		LOG_DBG("Device contains %d IP addresses", ip_cnt);
 	}
 
-	if (err != 0) {
-		return -EIO;
-	}
-
 parse:
 	if (info == MODEM_INFO_IP_ADDRESS) {
 		/* parse each IP address line separately */
-		ip_str_end = strstr(&recv_buf[cmd_rsp_idx], AT_CMD_RSP_DELIM);
+		ip_str_end = strstr(&rsp[cmd_rsp_idx], AT_CMD_RSP_DELIM);
 		if (ip_str_end == NULL) {
 			return -EFAULT;
 		}
 		/* get the size and then null-terminate the line */
-		ip_str_len = ip_str_end - &recv_buf[cmd_rsp_idx];
-		recv_buf[++ip_str_len] = 0;
+		ip_str_len = ip_str_end - &rsp[cmd_rsp_idx];
+		rsp[++ip_str_len] = 0;
 	}
-	err = modem_info_parse(modem_data[info], &recv_buf[cmd_rsp_idx]);
+	err = modem_info_parse(modem_data[info], &rsp[cmd_rsp_idx]);
 
 	if (err) {
 		LOG_ERR("Unable to parse data: %d", err);
@@ -595,6 +597,28 @@ parse:
 	return len <= 0 ? -ENOTSUP : len;
 }
 
+int modem_info_string_get(enum modem_info info, char *buf,
+				  const size_t buf_size)
+{
+	int err;
+	char recv_buf[CONFIG_MODEM_INFO_BUFFER_SIZE] = {0};
+
+	if ((buf == NULL) || (buf_size == 0)) {
+		return -EINVAL;
+	}
+
+	err = at_cmd_write(modem_data[info]->cmd,
+			  recv_buf,
+			  CONFIG_MODEM_INFO_BUFFER_SIZE,
+			  NULL);
+
+	if ((err != 0) && (info != MODEM_INFO_SUP_BAND)) {
+		return -EIO;
+	}
+
+	return modem_info_string_parse(info, recv_buf, buf, buf_size);
+}
+
 static void modem_info_rsrp_subscribe_handler(void *context, const char *response)
 {
 	ARG_UNUSED(context);
@@ -602,10 +626,6 @@ static void modem_info_rsrp_subscribe_handler(void *context, const char *respons
 	u16_t param_value;
 	int err;
 
-	if (!is_cesq_notification(response, strlen(response))) {
-		return;
-	}
-
 	const struct modem_info_data rsrp_notify_data = {
 		.cmd		= AT_CMD_CESQ,
 		.data_name	= RSRP_DATA_NAME,
@@ -636,7 +656,7 @@ int modem_info_rsrp_register(rsrp_cb_t cb)
 {
 	modem_info_rsrp_cb = cb;
 
-	int rc = at_notif_register_handler(NULL,
+	int rc = at_notif_register_prefix_handler(NULL, AT_CMD_CESQ_RESP,
 		modem_info_rsrp_subscribe_handler);
 	if (rc != 0) {
 		LOG_ERR("Can't register handler rc=%d", rc);
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef MODEM_INFO_INTERNAL_H__
+#define MODEM_INFO_INTERNAL_H__
+
+#include <zephyr/types.h>
+#include <modem/modem_info.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Get the AT command that reads an information type.
+ *
+ * @param info The information type.
+ *
+ * @return The AT command, or NULL if @p info is not valid.
+ */
+const char *modem_info_cmd_get(enum modem_info info);
+
+/** @brief Parse an information value of type short from the response to
+ *         its AT command.
+ *
+ * @param info The information type.
+ * @param rsp  The response.
+ * @param buf  The short where to store the information.
+ *
+ * @return Length of received data if the operation was successful.
+ *         Otherwise, a (negative) error code is returned.
+ */
+int modem_info_short_parse(enum modem_info info, const char *rsp, u16_t *buf);
+
+/** @brief Parse an information value as a string from the response to its
+ *         AT command.
+ *
+ * The response is modified while it is parsed.
+ *
+ * @param info     The information type.
+ * @param rsp      The response.
+ * @param buf      The buffer to store the null-terminated string.
+ * @param buf_size The size of the buffer.
+ *
+ * @return Length of received data if the operation was successful.
+ *         Otherwise, a (negative) error code is returned.
+ */
+int modem_info_string_parse(enum modem_info info, char *rsp, char *buf,
+			    const size_t buf_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MODEM_INFO_INTERNAL_H__ */
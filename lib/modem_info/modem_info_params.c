@@ -9,16 +9,326 @@
 #include <stdlib.h>
 #include <modem/modem_info.h>
 #include <modem/at_params.h>
+#include <modem/at_cmd.h>
+#include <modem/at_cmd_parser.h>
+#include <modem/at_notif.h>
 #include <logging/log.h>
 
+#include "modem_info_internal.h"
+
 LOG_MODULE_REGISTER(modem_info_params);
 
+#define AT_CMD_XMONITOR			"AT%XMONITOR"
+#define AT_CEREG_NOTIF			"+CEREG"
+#define AT_XSIM_NOTIF			"%XSIM"
+#define AT_XSIM_SUBSCRIBE		"AT%XSIM=1"
+
+/* Only the parameters up to the cell ID are parsed from %XMONITOR. */
+#define XMONITOR_OPERATOR_PARAM_INDEX	4
+#define XMONITOR_AREA_CODE_PARAM_INDEX	5
+#define XMONITOR_BAND_PARAM_INDEX	7
+#define XMONITOR_CELLID_PARAM_INDEX	8
+#define XMONITOR_PARAM_COUNT		9
+
+/* Only the parameters up to the cell ID are parsed from +CEREG. */
+#define CEREG_REG_STATUS_PARAM_INDEX	1
+#define CEREG_AREA_CODE_PARAM_INDEX	2
+#define CEREG_CELLID_PARAM_INDEX	3
+#define CEREG_PARAM_COUNT		4
+#define CEREG_STATUS_REGISTERED_HOME	1
+#define CEREG_STATUS_REGISTERED_ROAMING	5
+
+#define RSP_BUF_SIZE			256
+
+#define MAX_AGE_FOREVER			-1
+#define NETWORK_MAX_AGE	(CONFIG_MODEM_INFO_PARAMS_MAX_AGE * MSEC_PER_SEC)
+
+#define PARAM(field) offsetof(struct modem_param_info, field)
+
+/* The AT commands that the parameters are read with. The values read with a
+ * command are cached together.
+ */
+enum params_cmd_id {
+	CMD_XMONITOR,
+	CMD_SUP_BAND,
+	CMD_UE_MODE,
+	CMD_PDP_CONTEXT,
+	CMD_SYSTEMMODE,
+	CMD_DATE_TIME,
+	CMD_UICC,
+	CMD_ICCID,
+	CMD_IMSI,
+	CMD_FW_VERSION,
+	CMD_BATTERY,
+	CMD_IMEI,
+	CMD_COUNT
+};
+
+BUILD_ASSERT(CMD_COUNT == MODEM_INFO_PARAMS_CMD_COUNT,
+	     "Wrong number of AT commands");
+
+struct params_cmd {
+	bool enabled;
+	/* Time the values stay valid, in milliseconds. */
+	s64_t max_age;
+	/* Offsets of the values in struct modem_param_info. The command is
+	 * the one of the first value. Not used for %XMONITOR.
+	 */
+	u16_t params[3];
+	u8_t param_count;
+};
+
+static const struct params_cmd params_cmds[] = {
+	[CMD_XMONITOR] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK),
+		.max_age	= NETWORK_MAX_AGE,
+	},
+	[CMD_SUP_BAND] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK),
+		.max_age	= MAX_AGE_FOREVER,
+		.params		= { PARAM(network.sup_band) },
+		.param_count	= 1,
+	},
+	[CMD_UE_MODE] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK),
+		.max_age	= NETWORK_MAX_AGE,
+		.params		= { PARAM(network.ue_mode) },
+		.param_count	= 1,
+	},
+	[CMD_PDP_CONTEXT] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK),
+		.max_age	= NETWORK_MAX_AGE,
+		.params		= { PARAM(network.ip_address),
+				    PARAM(network.apn) },
+		.param_count	= 2,
+	},
+	[CMD_SYSTEMMODE] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK),
+		.max_age	= NETWORK_MAX_AGE,
+		.params		= { PARAM(network.lte_mode),
+				    PARAM(network.nbiot_mode),
+				    PARAM(network.gps_mode) },
+		.param_count	= 3,
+	},
+	[CMD_DATE_TIME] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_DATE_TIME),
+		.max_age	= 0,
+		.params		= { PARAM(network.date_time) },
+		.param_count	= 1,
+	},
+	[CMD_UICC] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM),
+		.max_age	= NETWORK_MAX_AGE,
+		.params		= { PARAM(sim.uicc) },
+		.param_count	= 1,
+	},
+	[CMD_ICCID] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM) &&
+				  IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM_ICCID),
+		.max_age	= MAX_AGE_FOREVER,
+		.params		= { PARAM(sim.iccid) },
+		.param_count	= 1,
+	},
+	[CMD_IMSI] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM) &&
+				  IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM_IMSI),
+		.max_age	= MAX_AGE_FOREVER,
+		.params		= { PARAM(sim.imsi) },
+		.param_count	= 1,
+	},
+	[CMD_FW_VERSION] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_DEVICE),
+		.max_age	= MAX_AGE_FOREVER,
+		.params		= { PARAM(device.modem_fw) },
+		.param_count	= 1,
+	},
+	[CMD_BATTERY] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_DEVICE),
+		.max_age	= 0,
+		.params		= { PARAM(device.battery) },
+		.param_count	= 1,
+	},
+	[CMD_IMEI] = {
+		.enabled	= IS_ENABLED(CONFIG_MODEM_INFO_ADD_DEVICE),
+		.max_age	= MAX_AGE_FOREVER,
+		.params		= { PARAM(device.imei) },
+		.param_count	= 1,
+	},
+};
+
+/* Uptime of the last notification that changed the values of each command. */
+static s64_t invalidated[CMD_COUNT];
+static struct k_spinlock invalidated_lock;
+
+/* Tracking area and cell from the last +CEREG notification, protected by
+ * invalidated_lock. A time of 0 means that no cell was notified.
+ */
+static struct {
+	s64_t time;
+	char area_code[MODEM_INFO_MAX_RESPONSE_SIZE];
+	char cellid[MODEM_INFO_MAX_RESPONSE_SIZE];
+} cereg_cell;
+
+/* The +CEREG notifications are parsed in the AT command thread. */
+static struct at_param_list cereg_list;
+static u8_t cereg_list_buf[AT_PARAMS_LIST_BUF_SIZE(CEREG_PARAM_COUNT,
+						   RSP_BUF_SIZE)];
+
+/* Without %XSIM notifications, the ICCID and IMSI expire like the network
+ * values.
+ */
+static bool xsim_subscribed;
+
+/* Protects the buffers below, which are shared by all the reads. */
+static K_MUTEX_DEFINE(params_mutex);
+static char rsp_buf[RSP_BUF_SIZE];
+static char parse_buf[RSP_BUF_SIZE];
+static struct at_param_list xmonitor_list;
+static u8_t xmonitor_list_buf[AT_PARAMS_LIST_BUF_SIZE(XMONITOR_PARAM_COUNT,
+						      RSP_BUF_SIZE)];
+
+static void cmd_invalidate(enum params_cmd_id id)
+{
+	k_spinlock_key_t key = k_spin_lock(&invalidated_lock);
+
+	invalidated[id] = k_uptime_get();
+	k_spin_unlock(&invalidated_lock, key);
+}
+
+static int cereg_string_get(size_t index, char *str, size_t size)
+{
+	size_t len = size - 1;
+	int err;
+
+	err = at_params_string_get(&cereg_list, index, str, &len);
+	if (err) {
+		return err;
+	}
+
+	str[len] = '\0';
+
+	return 0;
+}
+
+/* Keeps the tracking area and cell of a registered device from the
+ * notification, so that they are not read again with %XMONITOR.
+ */
+static int cereg_cell_parse(const char *response)
+{
+	char area_code[sizeof(cereg_cell.area_code)];
+	char cellid[sizeof(cereg_cell.cellid)];
+	k_spinlock_key_t key;
+	int status;
+	int err;
+
+	err = at_parser_max_params_from_str(response, NULL, &cereg_list,
+					    CEREG_PARAM_COUNT);
+	if ((err != 0) && (err != -E2BIG) && (err != -EAGAIN)) {
+		return err;
+	}
+
+	err = at_params_int_get(&cereg_list, CEREG_REG_STATUS_PARAM_INDEX,
+				&status);
+	if (err) {
+		return err;
+	}
+
+	if ((status != CEREG_STATUS_REGISTERED_HOME) &&
+	    (status != CEREG_STATUS_REGISTERED_ROAMING)) {
+		return -EAGAIN;
+	}
+
+	err = cereg_string_get(CEREG_AREA_CODE_PARAM_INDEX, area_code,
+			       sizeof(area_code));
+	err += cereg_string_get(CEREG_CELLID_PARAM_INDEX, cellid,
+				sizeof(cellid));
+	if (err) {
+		return -EAGAIN;
+	}
+
+	key = k_spin_lock(&invalidated_lock);
+	strcpy(cereg_cell.area_code, area_code);
+	strcpy(cereg_cell.cellid, cellid);
+	cereg_cell.time = k_uptime_get();
+	k_spin_unlock(&invalidated_lock, key);
+
+	return 0;
+}
+
+/* A change of registration or cell can change the operator, band, cell and
+ * IP address. When the notification has the tracking area and cell, only
+ * the IP address is read again, and the operator and band expire with
+ * CONFIG_MODEM_INFO_PARAMS_MAX_AGE.
+ */
+static void cereg_notif_handler(void *context, const char *response)
+{
+	ARG_UNUSED(context);
+
+	if (cereg_cell_parse(response)) {
+		cmd_invalidate(CMD_XMONITOR);
+	}
+
+	cmd_invalidate(CMD_PDP_CONTEXT);
+}
+
+static void xsim_notif_handler(void *context, const char *response)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(response);
+
+	cmd_invalidate(CMD_UICC);
+	cmd_invalidate(CMD_ICCID);
+	cmd_invalidate(CMD_IMSI);
+}
+
 int modem_info_params_init(struct modem_param_info *modem)
 {
+	int err;
+
 	if (modem == NULL) {
 		return -EINVAL;
 	}
 
+	err = at_params_list_init_buf(&cereg_list, CEREG_PARAM_COUNT,
+				      cereg_list_buf, sizeof(cereg_list_buf));
+	if (err) {
+		return err;
+	}
+
+	err = at_notif_register_prefix_handler(NULL, AT_CEREG_NOTIF,
+					       cereg_notif_handler);
+	if (err) {
+		LOG_ERR("Can't register handler err=%d", err);
+		return err;
+	}
+
+	err = at_notif_register_prefix_handler(NULL, AT_XSIM_NOTIF,
+					       xsim_notif_handler);
+	if (err) {
+		LOG_ERR("Can't register handler err=%d", err);
+		return err;
+	}
+
+	/* The modem only sends %XSIM notifications once subscribed to. */
+	err = at_cmd_write(AT_XSIM_SUBSCRIBE, NULL, 0, NULL);
+	if (err) {
+		LOG_WRN("Can't subscribe to %%XSIM err=%d, ICCID and IMSI "
+			"are read again after %d s", err,
+			CONFIG_MODEM_INFO_PARAMS_MAX_AGE);
+	}
+	xsim_subscribed = (err == 0);
+
+	k_mutex_lock(&params_mutex, K_FOREVER);
+	err = at_params_list_init_buf(&xmonitor_list, XMONITOR_PARAM_COUNT,
+				      xmonitor_list_buf,
+				      sizeof(xmonitor_list_buf));
+	k_mutex_unlock(&params_mutex);
+	if (err) {
+		return err;
+	}
+
+	memset(modem->read_time, 0, sizeof(modem->read_time));
+
 	modem->network.current_band.type	= MODEM_INFO_CUR_BAND;
 	modem->network.sup_band.type		= MODEM_INFO_SUP_BAND;
 	modem->network.area_code.type		= MODEM_INFO_AREA_CODE;
@@ -98,7 +408,61 @@ static int cellid_to_dec(struct lte_param *cellID, double *cellID_dec)
 	return 0;
 }
 
-static int modem_data_get(struct lte_param *param)
+static int xmonitor_string_get(size_t index, struct lte_param *param)
+{
+	size_t len = sizeof(param->value_string) - 1;
+	int err;
+
+	err = at_params_string_get(&xmonitor_list, index, param->value_string,
+				   &len);
+	if (err) {
+		return err;
+	}
+
+	param->value_string[len] = '\0';
+
+	return 0;
+}
+
+static int xmonitor_parse(struct modem_param_info *modem, const char *rsp)
+{
+	struct network_param *network = &modem->network;
+	int err;
+
+	err = at_parser_max_params_from_str(rsp, NULL, &xmonitor_list,
+					    XMONITOR_PARAM_COUNT);
+	if ((err != 0) && (err != -E2BIG) && (err != -EAGAIN)) {
+		return err;
+	}
+
+	/* The response has only the registration status when the device is
+	 * not registered.
+	 */
+	if (at_params_valid_count_get(&xmonitor_list) < XMONITOR_PARAM_COUNT) {
+		return -EAGAIN;
+	}
+
+	err = xmonitor_string_get(XMONITOR_OPERATOR_PARAM_INDEX,
+				  &network->current_operator);
+	err += xmonitor_string_get(XMONITOR_AREA_CODE_PARAM_INDEX,
+				   &network->area_code);
+	err += xmonitor_string_get(XMONITOR_CELLID_PARAM_INDEX,
+				   &network->cellid_hex);
+	err += at_params_short_get(&xmonitor_list, XMONITOR_BAND_PARAM_INDEX,
+				   &network->current_band.value);
+	if (err) {
+		return -EAGAIN;
+	}
+
+	mcc_mnc_parse(&network->current_operator, &network->mcc,
+		      &network->mnc);
+	cellid_to_dec(&network->cellid_hex, &network->cellid_dec);
+	area_code_parse(&network->area_code);
+
+	return 0;
+}
+
+static int param_parse(struct lte_param *param, const char *rsp)
 {
 	enum at_param_type data_type;
 	int ret;
@@ -110,84 +474,160 @@ static int modem_data_get(struct lte_param *param)
 	}
 
 	if (data_type == AT_PARAM_TYPE_STRING) {
-		ret = modem_info_string_get(param->type,
+		/* The response is modified while it is parsed, and other
+		 * values can still be parsed from it.
+		 */
+		strcpy(parse_buf, rsp);
+		ret = modem_info_string_parse(param->type, parse_buf,
 				param->value_string,
 				sizeof(param->value_string));
-		if (ret < 0) {
-			LOG_ERR("Link data not obtained: %d %d", param->type, ret);
-			return ret;
+	} else {
+		ret = modem_info_short_parse(param->type, rsp, &param->value);
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Link data not obtained: %d %d", param->type, ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+static int cmd_read(struct modem_param_info *modem, enum params_cmd_id id)
+{
+	const struct params_cmd *cmd = &params_cmds[id];
+	struct lte_param *param;
+	const char *at_cmd;
+	/* Taken before the command is sent, so that a notification received
+	 * during the read invalidates the values.
+	 */
+	s64_t read_time = k_uptime_get();
+	int err;
+
+	if (id == CMD_XMONITOR) {
+		at_cmd = AT_CMD_XMONITOR;
+	} else {
+		param = (struct lte_param *)((u8_t *)modem + cmd->params[0]);
+		at_cmd = modem_info_cmd_get(param->type);
+	}
+
+	err = at_cmd_write(at_cmd, rsp_buf, sizeof(rsp_buf), NULL);
+	if (err) {
+		return -EIO;
+	}
+
+	if (id == CMD_XMONITOR) {
+		err = xmonitor_parse(modem, rsp_buf);
+		if (err) {
+			return err;
 		}
-	} else if (data_type == AT_PARAM_TYPE_NUM_SHORT) {
-		ret = modem_info_short_get(param->type, &param->value);
-		if (ret < 0) {
-			LOG_ERR("Link data not obtained: %d", ret);
-			return ret;
+	}
+
+	for (size_t i = 0; i < cmd->param_count; i++) {
+		param = (struct lte_param *)((u8_t *)modem + cmd->params[i]);
+		err = param_parse(param, rsp_buf);
+		if (err) {
+			return err;
 		}
 	}
 
+	modem->read_time[id] = read_time;
+
 	return 0;
 }
 
-int modem_info_params_get(struct modem_param_info *modem)
+static s64_t cmd_max_age(enum params_cmd_id id)
 {
-	int ret;
+	if (!xsim_subscribed && ((id == CMD_ICCID) || (id == CMD_IMSI))) {
+		return NETWORK_MAX_AGE;
+	}
+
+	return params_cmds[id].max_age;
+}
+
+/* Replaces the tracking area and cell from %XMONITOR with the ones of a
+ * later +CEREG notification.
+ */
+static void cereg_cell_apply(struct modem_param_info *modem)
+{
+	struct network_param *network = &modem->network;
+	s64_t read_time = modem->read_time[CMD_XMONITOR];
+	k_spinlock_key_t key = k_spin_lock(&invalidated_lock);
+
+	if ((read_time == 0) || (cereg_cell.time < read_time)) {
+		k_spin_unlock(&invalidated_lock, key);
+		return;
+	}
+
+	strcpy(network->area_code.value_string, cereg_cell.area_code);
+	strcpy(network->cellid_hex.value_string, cereg_cell.cellid);
+	k_spin_unlock(&invalidated_lock, key);
+
+	cellid_to_dec(&network->cellid_hex, &network->cellid_dec);
+	area_code_parse(&network->area_code);
+}
+
+static bool cmd_cached(const struct modem_param_info *modem,
+		       enum params_cmd_id id, s64_t now)
+{
+	s64_t read_time = modem->read_time[id];
+	s64_t max_age = cmd_max_age(id);
+	k_spinlock_key_t key = k_spin_lock(&invalidated_lock);
+	/* Values that were never read have a read time of 0, which is never
+	 * after the last invalidation.
+	 */
+	bool cached = read_time > invalidated[id];
+
+	k_spin_unlock(&invalidated_lock, key);
+
+	if (!cached) {
+		return false;
+	}
+
+	return (max_age == MAX_AGE_FOREVER) || (now - read_time < max_age);
+}
+
+static int params_read(struct modem_param_info *modem, bool use_cache)
+{
+	s64_t now = k_uptime_get();
+	int ret = 0;
+	int err;
 
 	if (modem == NULL) {
 		return -EINVAL;
 	}
 
-	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_NETWORK)) {
-		ret = modem_data_get(&modem->network.current_band);
-		ret += modem_data_get(&modem->network.sup_band);
-		ret += modem_data_get(&modem->network.ip_address);
-		ret += modem_data_get(&modem->network.ue_mode);
-		ret += modem_data_get(&modem->network.current_operator);
-		ret += modem_data_get(&modem->network.cellid_hex);
-		ret += modem_data_get(&modem->network.area_code);
-		ret += modem_data_get(&modem->network.lte_mode);
-		ret += modem_data_get(&modem->network.nbiot_mode);
-		ret += modem_data_get(&modem->network.gps_mode);
-		ret += modem_data_get(&modem->network.apn);
-
-		if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_DATE_TIME)) {
-			ret += modem_data_get(&modem->network.date_time);
-		}
+	k_mutex_lock(&params_mutex, K_FOREVER);
 
-		ret += mcc_mnc_parse(&modem->network.current_operator,
-				&modem->network.mcc,
-				&modem->network.mnc);
-		ret += cellid_to_dec(&modem->network.cellid_hex,
-				&modem->network.cellid_dec);
-		ret += area_code_parse(&modem->network.area_code);
-		if (ret) {
-			LOG_ERR("Network data not obtained: %d", ret);
-			return -EAGAIN;
+	for (enum params_cmd_id id = 0; id < CMD_COUNT; id++) {
+		if (!params_cmds[id].enabled ||
+		    (use_cache && cmd_cached(modem, id, now))) {
+			continue;
 		}
-	}
 
-	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM)) {
-		ret = modem_data_get(&modem->sim.uicc);
-		if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM_ICCID)) {
-			ret += modem_data_get(&modem->sim.iccid);
-		}
-		if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_SIM_IMSI)) {
-			ret += modem_data_get(&modem->sim.imsi);
-		}
-		if (ret) {
-			LOG_ERR("Sim data not obtained: %d", ret);
-			return -EAGAIN;
+		err = cmd_read(modem, id);
+		if (err) {
+			LOG_ERR("Modem data not obtained: %d %d", id, err);
+			modem->read_time[id] = 0;
+			ret = -EAGAIN;
 		}
 	}
 
-	if (IS_ENABLED(CONFIG_MODEM_INFO_ADD_DEVICE)) {
-		ret = modem_data_get(&modem->device.modem_fw);
-		ret += modem_data_get(&modem->device.battery);
-		ret += modem_data_get(&modem->device.imei);
-		if (ret) {
-			LOG_ERR("Device data not obtained: %d", ret);
-			return -EAGAIN;
-		}
+	if (params_cmds[CMD_XMONITOR].enabled) {
+		cereg_cell_apply(modem);
 	}
 
-	return 0;
+	k_mutex_unlock(&params_mutex);
+
+	return ret;
+}
+
+int modem_info_params_get(struct modem_param_info *modem)
+{
+	return params_read(modem, false);
+}
+
+int modem_info_params_snapshot_get(struct modem_param_info *modem)
+{
+	return params_read(modem, true);
 }
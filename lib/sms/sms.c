@@ -35,7 +35,8 @@ LOG_MODULE_REGISTER(sms, CONFIG_SMS_LOG_LEVEL);
 #define AT_SMS_PDU_ACK "AT+CNMA=1"
 
 /** @brief Start of AT notification for incoming SMS. */
-#define AT_SMS_NOTIFICATION "+CMT:"
+#define AT_SMS_NOTIFICATION_PREFIX "+CMT"
+#define AT_SMS_NOTIFICATION AT_SMS_NOTIFICATION_PREFIX ":"
 #define AT_SMS_NOTIFICATION_LEN (sizeof(AT_SMS_NOTIFICATION) - 1)
 
 static struct at_param_list resp_list;
@@ -218,7 +219,8 @@ int sms_init(void)
 	}
 
 	/* Register for AT commands notifications before creating the client. */
-	ret = at_notif_register_handler(NULL, sms_at_handler);
+	ret = at_notif_register_prefix_handler(NULL, AT_SMS_NOTIFICATION_PREFIX,
+					       sms_at_handler);
 	if (ret) {
 		LOG_ERR("Cannot register AT notification handler, err: %d",
 			ret);
@@ -228,7 +230,8 @@ int sms_init(void)
 	/* Register this module as an SMS client. */
 	ret = at_cmd_write(AT_SMS_SUBSCRIBER_REGISTER, NULL, 0, NULL);
 	if (ret) {
-		(void)at_notif_deregister_handler(NULL, sms_at_handler);
+		(void)at_notif_deregister_prefix_handler(NULL,
+				AT_SMS_NOTIFICATION_PREFIX, sms_at_handler);
 		LOG_ERR("Unable to register a new SMS client, err: %d", ret);
 		return ret;
 	}
@@ -302,7 +305,8 @@ void sms_uninit(void)
 	}
 
 	/* Unregister from AT commands notifications. */
-	(void)at_notif_deregister_handler(NULL, sms_at_handler);
+	(void)at_notif_deregister_prefix_handler(NULL,
+				AT_SMS_NOTIFICATION_PREFIX, sms_at_handler);
 
 	sms_client_registered = false;
 }
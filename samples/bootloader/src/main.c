@@ -39,6 +39,13 @@ static void validate_and_boot(const struct fw_info *fw_info, u16_t slot)
 		set_monotonic_version(fw_info->version, slot);
 	}
 
+#ifdef CONFIG_SB_VALIDATION_CACHE
+	if (fprotect_area(PM_B0_CACHE_ADDRESS, PM_B0_CACHE_SIZE)) {
+		printk("Failed to protect validation cache, cancel boot.\n\r");
+		return;
+	}
+#endif
+
 	bl_boot(fw_info);
 }
 
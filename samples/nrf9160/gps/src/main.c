@@ -96,14 +96,16 @@ static int activate_lte(bool activate)
 			return -1;
 		}
 
-		at_notif_register_handler(NULL, wait_for_lte);
+		at_notif_register_prefix_handler(NULL, "+CEREG",
+						 wait_for_lte);
 		if (at_cmd_write("AT+CEREG=2", NULL, 0, NULL) != 0) {
 			return -1;
 		}
 
 		k_sem_take(&lte_ready, K_FOREVER);
 
-		at_notif_deregister_handler(NULL, wait_for_lte);
+		at_notif_deregister_prefix_handler(NULL, "+CEREG",
+						   wait_for_lte);
 		if (at_cmd_write("AT+CEREG=0", NULL, 0, NULL) != 0) {
 			return -1;
 		}
@@ -4,6 +4,7 @@
 # SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
 
 from rtt_nordic_profiler_host import RttNordicProfilerHost
+from native_nordic_profiler_host import NativeNordicProfilerHost
 import sys
 import argparse
 import logging
@@ -17,6 +18,7 @@ def main():
     parser.add_argument('time', type=int, help='Time of collecting data [s]')
     parser.add_argument('dataset_name', help='Name of dataset')
     parser.add_argument('--log', help='Log level')
+    NativeNordicProfilerHost.add_arguments(parser)
     args = parser.parse_args()
 
     if args.log is not None:
@@ -30,11 +32,17 @@ def main():
     signal.signal(signal.SIGINT, sigint_handler)
     end_ev = threading.Event()
 
-    profiler = RttNordicProfilerHost(
-                event_filename=args.dataset_name + ".csv",
-                finish_event=end_ev,
-                event_types_filename=args.dataset_name + ".json",
-                log_lvl=log_lvl_number)
+    host_args = dict(event_filename=args.dataset_name + ".csv",
+                     finish_event=end_ev,
+                     event_types_filename=args.dataset_name + ".json",
+                     log_lvl=log_lvl_number)
+    if args.native_data is not None:
+        profiler = NativeNordicProfilerHost(args.native_data,
+                                            args.native_info,
+                                            args.native_commands,
+                                            **host_args)
+    else:
+        profiler = RttNordicProfilerHost(**host_args)
     profiler.get_events_descriptions()
     profiler.read_events_rtt(args.time)
 
@@ -3,6 +3,7 @@
 #
 # SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
 
+import ast
 import csv
 import json
 import hashlib
@@ -112,11 +113,9 @@ class EventsData():
                 for row in rd:
                     type_id = int(row['type_id'])
                     timestamp = float(row['timestamp'])
-                    # reading event data from single row in csv file
-                    if (row['data'][1:-1] != ''):
-                        data = list(map(int, (row['data'][1:-1].split(','))))
-                    else:
-                        data = []
+                    # reading event data from single row in csv file,
+                    # numbers and strings are stored as a Python list
+                    data = ast.literal_eval(row['data'])
                     ev = Event(type_id, timestamp, data)
                     self.events.append(ev)
         except IOError:
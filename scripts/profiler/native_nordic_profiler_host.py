@@ -0,0 +1,79 @@
+#
+# Copyright (c) 2020 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+
+import os
+from rtt_nordic_profiler_host import RttNordicProfilerHost
+from rtt_nordic_config import RttNordicConfig
+
+# native_posix hardware clock runs at 1 MHz
+NativeNordicConfig = dict(RttNordicConfig, ms_per_timestamp_tick=0.001,
+                          reset_on_start=False)
+
+
+class NativeNordicProfilerHost(RttNordicProfilerHost):
+    """Receives Nordic profiler data written by a native_posix application
+    to files or named pipes (FIFOs) instead of RTT."""
+
+    io_error = OSError
+
+    def __init__(self, data_path, info_path, commands_path=None, **kwargs):
+        self.data_path = data_path
+        self.info_path = info_path
+        self.commands_path = commands_path
+        self.data_file = None
+        self.info_file = None
+        self.commands_file = None
+        self.data_eof = False
+        kwargs.setdefault('config', NativeNordicConfig)
+        super().__init__(**kwargs)
+
+    @staticmethod
+    def add_arguments(parser):
+        parser.add_argument('--native-data',
+                            help='File or FIFO with event records written by native_posix application')
+        parser.add_argument('--native-info',
+                            help='File or FIFO with event descriptions written by native_posix application')
+        parser.add_argument('--native-commands',
+                            help='FIFO used to send commands to native_posix application')
+
+    def connect(self):
+        # Opening order matches the application, otherwise opening FIFOs
+        # would deadlock
+        self.data_file = open(self.data_path, 'rb', buffering=0)
+        os.set_blocking(self.data_file.fileno(), False)
+        self.info_file = open(self.info_path, 'rb', buffering=0)
+        os.set_blocking(self.info_file.fileno(), False)
+        if self.commands_path is not None:
+            self.commands_file = open(self.commands_path, 'wb', buffering=0)
+        self.logger.info("Connected to native_posix application")
+
+    def _close(self):
+        self.data_file.close()
+        self.info_file.close()
+        if self.commands_file is not None:
+            self.commands_file.close()
+
+    def _read_raw_data(self):
+        buf = self.data_file.read(self.config['rtt_read_chunk_size'])
+        if buf is None:
+            # No data available in FIFO yet
+            return bytes()
+        if len(buf) == 0:
+            self.data_eof = True
+        return buf
+
+    def _read_raw_info(self):
+        buf = self.info_file.read(self.config['rtt_read_chunk_size'])
+        if buf is None:
+            return ''
+        return buf.decode('utf-8')
+
+    def _write_raw_command(self, command):
+        # Without command channel application logs events from start
+        if self.commands_file is not None:
+            self.commands_file.write(command)
+
+    def _data_source_finished(self):
+        return self.data_eof
@@ -5,6 +5,7 @@
 
 from plot_nordic import PlotNordic
 from rtt_nordic_profiler_host import RttNordicProfilerHost
+from native_nordic_profiler_host import NativeNordicProfilerHost
 
 import argparse
 import threading
@@ -12,11 +13,16 @@ import queue
 import sys
 import logging
 
-def rtt_thread(queue, finish_event, event_filename, event_types_filename, log_lvl_number):
-    profiler = RttNordicProfilerHost(finish_event=finish_event, queue=queue,
-                                     event_filename=event_filename,
-                                     event_types_filename=event_types_filename,
-                                     log_lvl=log_lvl_number)
+def rtt_thread(queue, finish_event, event_filename, event_types_filename, log_lvl_number,
+               native_paths):
+    host_args = dict(finish_event=finish_event, queue=queue,
+                     event_filename=event_filename,
+                     event_types_filename=event_types_filename,
+                     log_lvl=log_lvl_number)
+    if native_paths[0] is not None:
+        profiler = NativeNordicProfilerHost(*native_paths, **host_args)
+    else:
+        profiler = RttNordicProfilerHost(**host_args)
     profiler.get_events_descriptions()
     profiler.read_events_rtt(-1)
 
@@ -25,6 +31,7 @@ def main():
         description='Collecting data from Nordic profiler for given time and saving to files.')
     parser.add_argument('dataset_name', help='Name of dataset')
     parser.add_argument('--log', help='Log level')
+    NativeNordicProfilerHost.add_arguments(parser)
     args = parser.parse_args()
 
     if args.log is not None:
@@ -37,7 +44,8 @@ def main():
     t_rtt = threading.Thread(
         target=rtt_thread,
         args=[que, ev, args.dataset_name + ".csv",
-              args.dataset_name + ".json", log_lvl_number])
+              args.dataset_name + ".json", log_lvl_number,
+              (args.native_data, args.native_info, args.native_commands)])
     t_rtt.start()
 
     pn = PlotNordic(log_lvl=log_lvl_number)
@@ -3,8 +3,15 @@
 #
 # SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
 
-from pynrfjprog.LowLevel import API
-from pynrfjprog.APIError import APIError
+try:
+    from pynrfjprog.LowLevel import API
+    from pynrfjprog.APIError import APIError
+except ImportError:
+    # pynrfjprog is not needed to collect data from native_posix
+    API = None
+
+    class APIError(Exception):
+        pass
 import time
 import sys
 from enum import Enum
@@ -19,6 +26,8 @@ class Command(Enum):
 
 
 class RttNordicProfilerHost:
+    # Exception raised by the transport on communication problems
+    io_error = APIError
 
     def __init__(self, config=RttNordicConfig, finish_event=None,
                  queue=None, event_filename=None,
@@ -32,6 +41,10 @@ class RttNordicProfilerHost:
         self.timestamp_overflows = 0
         self.after_half = False
 
+        self.compact_encoding = False
+        self.mem_address_base = 0
+        self.last_timestamp_raw = 0
+
         self.desc_buf = ""
         self.bufs = list()
         self.bcnt = 0
@@ -100,11 +113,9 @@ class RttNordicProfilerHost:
         # read remaining data to buffer
         while True:
             try:
-                buf = self.jlink.rtt_read(self.config['rtt_data_channel'],
-                                          self.config['rtt_read_chunk_size'],
-                                          encoding=None)
+                buf = self._read_raw_data()
 
-            except APIError:
+            except self.io_error:
                 self.logger.error("Problem with reading RTT data.")
                 buf = []
 
@@ -115,16 +126,35 @@ class RttNordicProfilerHost:
                 break
 
         try:
-            self.jlink.rtt_stop()
-            self.jlink.disconnect_from_emu()
-            self.jlink.close()
+            self._close()
 
-        except APIError:
+        except self.io_error:
             self.logger.error("JLink connection lost. Saving collected data.")
             return
 
         self.logger.info("Disconnected from device")
 
+    def _close(self):
+        self.jlink.rtt_stop()
+        self.jlink.disconnect_from_emu()
+        self.jlink.close()
+
+    def _read_raw_data(self):
+        return self.jlink.rtt_read(self.config['rtt_data_channel'],
+                                   self.config['rtt_read_chunk_size'],
+                                   encoding=None)
+
+    def _read_raw_info(self):
+        return self.jlink.rtt_read(self.config['rtt_info_channel'],
+                                   self.config['rtt_read_chunk_size'],
+                                   encoding='utf-8')
+
+    def _write_raw_command(self, command):
+        self.jlink.rtt_write(self.config['rtt_command_channel'], command, None)
+
+    def _data_source_finished(self):
+        return False
+
     def _get_buffered_data(self, num_bytes):
         buf = bytearray()
         while len(buf) < num_bytes:
@@ -148,10 +178,8 @@ class RttNordicProfilerHost:
                 break
 
             try:
-                buf = self.jlink.rtt_read(self.config['rtt_data_channel'],
-                                          self.config['rtt_read_chunk_size'],
-                                          encoding=None)
-            except APIError:
+                buf = self._read_raw_data()
+            except self.io_error:
                 self.logger.error("Problem with reading RTT data.")
                 self.shutdown()
                 sys.exit()
@@ -175,6 +203,12 @@ class RttNordicProfilerHost:
                 self.logger.info("Events data saved to files")
                 sys.exit()
 
+            if self._data_source_finished():
+                self.logger.info("End of data reached")
+                self.shutdown()
+                self.logger.info("Events data saved to files")
+                sys.exit()
+
             time.sleep(0.05)
 
         return self._get_buffered_data(num_bytes)
@@ -186,11 +220,9 @@ class RttNordicProfilerHost:
     def _read_single_event_description(self):
         while '\n' not in self.desc_buf:
             try:
-                buf_temp = self.jlink.rtt_read(self.config['rtt_info_channel'],
-                                      self.config['rtt_read_chunk_size'],
-                                      encoding='utf-8')
+                buf_temp = self._read_raw_info()
 
-            except APIError:
+            except self.io_error:
                 self.logger.error("Problem with reading RTT data.")
                 self.shutdown()
 
@@ -203,6 +235,11 @@ class RttNordicProfilerHost:
             return None, None
         self.desc_buf = self.desc_buf[self.desc_buf.find('\n')+1:]
 
+        # Header describing the encoding of event records
+        if desc[0] == '#':
+            self._parse_encoding_header(desc[1:])
+            return self._read_single_event_description()
+
         desc_fields = desc.split(',')
 
         name = desc_fields[0]
@@ -215,6 +252,65 @@ class RttNordicProfilerHost:
             data.append(desc_fields[i])
         return id, EventType(name, data_type, data)
 
+    def _parse_encoding_header(self, header):
+        header_fields = header.split(',')
+        if header_fields[0] == 'compact':
+            self.compact_encoding = True
+            self.mem_address_base = int(header_fields[1])
+            self.logger.info("Device uses compact encoding")
+        else:
+            self.logger.warning("Unknown encoding: " + header_fields[0])
+
+    def _read_varint(self):
+        value = 0
+        shift = 0
+        while True:
+            byte = self._read_bytes(1)[0]
+            value |= (byte & 0x7f) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    @staticmethod
+    def _zigzag_decode(value):
+        return (value >> 1) ^ -(value & 1)
+
+    def _read_timestamp_raw(self):
+        if not self.compact_encoding:
+            buf = self._read_bytes(4)
+            return int.from_bytes(buf, byteorder=self.config['byteorder'],
+                                  signed=False)
+
+        delta = RttNordicProfilerHost._zigzag_decode(self._read_varint())
+        self.last_timestamp_raw = (self.last_timestamp_raw + delta) \
+                                  % self.config['timestamp_raw_max']
+        return self.last_timestamp_raw
+
+    def _read_string(self):
+        length = self._read_bytes(1)[0]
+        return self._read_bytes(length).decode(errors='replace')
+
+    def _read_data_field(self, data_type, data_description):
+        if data_type == 's':
+            return self._read_string()
+
+        signum = False
+        if data_type[0] == 's':
+            signum = True
+
+        if not self.compact_encoding:
+            buf = self._read_bytes(4)
+            return int.from_bytes(buf, byteorder=self.config['byteorder'],
+                                  signed=signum)
+
+        value = RttNordicProfilerHost._zigzag_decode(self._read_varint())
+        if data_description == 'mem_address':
+            value += self.mem_address_base
+        value &= 0xffffffff
+        if signum and value >= 2**31:
+            value -= 2**32
+        return value
+
     def _read_all_events_descriptions(self):
         while True:
             id, et = self._read_single_event_description()
@@ -237,12 +333,7 @@ class RttNordicProfilerHost:
             signed=False)
         et = self.received_events.registered_events_types[id]
 
-        buf = self._read_bytes(4)
-        timestamp_raw = (
-            int.from_bytes(
-                buf,
-                byteorder=self.config['byteorder'],
-                signed=False))
+        timestamp_raw = self._read_timestamp_raw()
 
         if self.after_half \
         and timestamp_raw < 0.2 * self.config['timestamp_raw_max']:
@@ -256,13 +347,8 @@ class RttNordicProfilerHost:
         timestamp = self._calculate_timestamp_from_clock_ticks(timestamp_raw)
 
         data = []
-        for i in et.data_types:
-            signum = False
-            if i[0] == 's':
-                signum = True
-            buf = self._read_bytes(4)
-            data.append(int.from_bytes(buf, byteorder=self.config['byteorder'],
-                                       signed=signum))
+        for i, j in zip(et.data_types, et.data_descriptions):
+            data.append(self._read_data_field(i, j))
         return Event(id, timestamp, data)
 
     def _read_remaining_events(self):
@@ -294,6 +380,8 @@ class RttNordicProfilerHost:
         sys.exit()
 
     def start_logging_events(self):
+        # Device encodes timestamp deltas starting from zero after start
+        self.last_timestamp_raw = 0
         self._send_command(Command.START)
 
     def stop_logging_events(self):
@@ -303,6 +391,6 @@ class RttNordicProfilerHost:
         command = bytearray(1)
         command[0] = command_type.value
         try:
-            self.jlink.rtt_write(self.config['rtt_command_channel'], command, None)
-        except APIError:
+            self._write_raw_command(command)
+        except self.io_error:
             self.logger.error("Problem with writing RTT data.")
@@ -121,7 +121,16 @@ int bl_root_of_trust_verify_external(
 }
 
 #ifndef CONFIG_BL_SHA256_EXT_API_REQUIRED
+/* For use by the bootloader. */
 int bl_sha256_verify(const u8_t *data, u32_t data_len, const u8_t *expected)
+{
+	return verify_truncated_hash(data, data_len, expected, CONFIG_SB_HASH_LEN, false);
+}
+
+
+/* For use through EXT_API. */
+int bl_sha256_verify_external(const u8_t *data, u32_t data_len,
+			      const u8_t *expected)
 {
 	return verify_truncated_hash(data, data_len, expected, CONFIG_SB_HASH_LEN, true);
 }
@@ -139,7 +148,7 @@ EXT_API(BL_SHA256, struct bl_sha256_ext_api, bl_sha256_ext_api) = {
 		.bl_sha256_init = bl_sha256_init,
 		.bl_sha256_update = bl_sha256_update,
 		.bl_sha256_finalize = bl_sha256_finalize,
-		.bl_sha256_verify = bl_sha256_verify,
+		.bl_sha256_verify = bl_sha256_verify_external,
 		.bl_sha256_ctx_size = SHA256_CTX_SIZE,
 	}
 };
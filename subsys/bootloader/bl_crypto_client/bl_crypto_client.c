@@ -48,6 +48,12 @@ int bl_sha256_verify(const u8_t *data, u32_t data_len, const u8_t *expected)
 	return bl_sha256->ext_api.bl_sha256_verify(data, data_len, expected);
 }
 
+int bl_sha256_verify_external(const u8_t *data, u32_t data_len,
+			      const u8_t *expected)
+{
+	return bl_sha256->ext_api.bl_sha256_verify(data, data_len, expected);
+}
+
 int get_hash(u8_t *hash, const u8_t *data, u32_t data_len, bool external)
 {
 	bl_sha256_ctx_t ctx;
@@ -65,6 +65,9 @@ bool bl_validate_firmware(u32_t fw_dst_address, u32_t fw_src_address)
 #include <sys/printk.h>
 #include <toolchain.h>
 #include <bl_crypto.h>
+#ifdef CONFIG_SB_VALIDATION_CACHE
+#include "bl_validation_cache.h"
+#endif
 
 #define PRINT(...) if (!external) printk(__VA_ARGS__)
 
@@ -143,7 +146,7 @@ validation_info_find(u32_t start_address, u32_t search_distance)
 static bool validate_signature(u32_t fw_src_address,
 				const struct fw_info *fwinfo,
 				const struct fw_validation_info *fw_val_info,
-				bool external)
+				u32_t *key_idx, bool external)
 {
 	int retval = bl_crypto_init();
 
@@ -189,6 +192,7 @@ static bool validate_signature(u32_t fw_src_address,
 					fwinfo->size);
 
 		if (retval == 0) {
+			*key_idx = key_data_idx;
 			for (u32_t i = 0; i < key_data_idx; i++) {
 				PRINT("Invalidating key %d.\n\r", i);
 				invalidate_public_key(i);
@@ -211,19 +215,92 @@ static bool validate_signature(u32_t fw_src_address,
 }
 
 
+#ifdef CONFIG_SB_VALIDATION_CACHE
+/* Validate the firmware against the record of an earlier validation, instead
+ * of verifying its signature again. The firmware must still have the recorded
+ * hash, and the public key it was validated with must still be valid.
+ */
+static bool validate_cached(u32_t fw_src_address, const struct fw_info *fwinfo,
+			const struct fw_validation_info *fw_val_info)
+{
+	u32_t key_idx;
+	__aligned(4) u8_t key_data[CONFIG_SB_PUBLIC_KEY_HASH_LEN];
+	int retval;
+
+	if (!bl_validation_cache_find(fw_src_address, fwinfo->size,
+			fwinfo->version, fw_val_info->hash, &key_idx)) {
+		return false;
+	}
+
+	retval = bl_crypto_init();
+	if (retval) {
+		printk("bl_crypto_init() returned %d.\n\r", retval);
+		return false;
+	}
+
+	retval = public_key_data_read(key_idx, key_data, sizeof(key_data));
+	if (retval < 0) {
+		printk("Key %d is no longer valid.\n\r", key_idx);
+		bl_validation_cache_invalidate(fw_src_address);
+		return false;
+	}
+
+	retval = bl_sha256_verify((u8_t *)fw_src_address, fwinfo->size,
+				fw_val_info->hash);
+	if (retval != 0) {
+		printk("Firmware does not match validation cache.\n\r");
+		bl_validation_cache_invalidate(fw_src_address);
+		return false;
+	}
+
+	printk("Firmware hash matches validation cache.\n\r");
+
+	return true;
+}
+
+
+/* Record the validation, so that the next boot can skip the signature. The
+ * recorded hash is taken from the validation info, which is not covered by the
+ * signature, so it must be checked against the firmware first.
+ */
+static void validation_cache_update(u32_t fw_src_address,
+			const struct fw_info *fwinfo,
+			const struct fw_validation_info *fw_val_info,
+			u32_t key_idx)
+{
+	int retval = bl_sha256_verify((u8_t *)fw_src_address, fwinfo->size,
+				fw_val_info->hash);
+
+	if (retval != 0) {
+		printk("Firmware hash does not match validation info.\n\r");
+		return;
+	}
+
+	retval = bl_validation_cache_store(fw_src_address, fwinfo->size,
+			fwinfo->version, fw_val_info->hash, key_idx);
+	if (retval != 0) {
+		printk("bl_validation_cache_store() error: %d\n\r", retval);
+	}
+}
+#endif
+
+
 #elif defined(CONFIG_SB_VALIDATE_FW_HASH)
 static bool validate_hash(u32_t fw_src_address, const struct fw_info *fwinfo,
 			const struct fw_validation_info *fw_val_info,
 			bool external)
 {
 	int retval = bl_crypto_init();
+	bl_sha256_verify_t sha256_verify = external ?
+					bl_sha256_verify_external :
+					bl_sha256_verify;
 
 	if (retval) {
 		PRINT("bl_crypto_init() returned %d.\n\r", retval);
 		return false;
 	}
 
-	retval = bl_sha256_verify((u8_t *)fw_src_address, fwinfo->size,
+	retval = sha256_verify((u8_t *)fw_src_address, fwinfo->size,
 			fw_val_info->hash);
 
 	if (retval != 0) {
@@ -293,8 +370,27 @@ static bool validate_firmware(u32_t fw_dst_address, u32_t fw_src_address,
 	}
 
 #ifdef CONFIG_SB_VALIDATE_FW_SIGNATURE
-	return validate_signature(fw_src_address, fwinfo, fw_val_info,
-				external);
+	u32_t key_idx;
+
+#ifdef CONFIG_SB_VALIDATION_CACHE
+	if (!external && validate_cached(fw_src_address, fwinfo, fw_val_info)) {
+		return true;
+	}
+#endif
+
+	if (!validate_signature(fw_src_address, fwinfo, fw_val_info,
+				&key_idx, external)) {
+		return false;
+	}
+
+#ifdef CONFIG_SB_VALIDATION_CACHE
+	if (!external) {
+		validation_cache_update(fw_src_address, fwinfo, fw_val_info,
+					key_idx);
+	}
+#endif
+
+	return true;
 #elif defined(CONFIG_SB_VALIDATE_FW_HASH)
 	return validate_hash(fw_src_address, fwinfo, fw_val_info,
 				external);
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include "bl_validation_cache.h"
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <toolchain.h>
+#include <pm_config.h>
+#include <nrfx_nvmc.h>
+
+#define RECORD_MAGIC 0x4fd3a7c1
+#define RECORD_VALID 0x8e5b29d6
+#define RECORD_INVALID 0
+#define ERASED_VAL 0xFFFFFFFF
+
+/** A successful validation of the firmware at 'address'. Records are
+ *  appended to the partition, so that nothing is erased until it is full.
+ */
+struct record {
+	u32_t magic;
+	u32_t address;
+	u32_t size;
+	u32_t version;
+	u32_t key_idx;
+	u8_t hash[CONFIG_SB_HASH_LEN];
+	/* Written after the rest of the record, so that a partly written
+	 * record is never valid. Written to RECORD_INVALID when the record
+	 * is superseded.
+	 */
+	u32_t valid;
+};
+
+BUILD_ASSERT(sizeof(struct record) % 4 == 0);
+
+#define NUM_RECORDS (PM_B0_CACHE_SIZE / sizeof(struct record))
+
+static const struct record *records =
+	(const struct record *)PM_B0_CACHE_ADDRESS;
+
+
+static bool record_valid(const struct record *rec)
+{
+	return (rec->magic == RECORD_MAGIC) && (rec->valid == RECORD_VALID);
+}
+
+
+/* Records after the first free one have not been written either. */
+static bool record_free(const struct record *rec)
+{
+	return rec->magic == ERASED_VAL;
+}
+
+
+static void record_invalidate(const struct record *rec)
+{
+	nrfx_nvmc_word_write((u32_t)&rec->valid, RECORD_INVALID);
+}
+
+
+static const struct record *record_find(u32_t address)
+{
+	for (u32_t i = 0; i < NUM_RECORDS && !record_free(&records[i]); i++) {
+		if (record_valid(&records[i])
+			&& (records[i].address == address)) {
+			return &records[i];
+		}
+	}
+	return NULL;
+}
+
+
+static int cache_erase(void)
+{
+	u32_t page_size = nrfx_nvmc_flash_page_size_get();
+
+	for (u32_t addr = PM_B0_CACHE_ADDRESS;
+		addr < (PM_B0_CACHE_ADDRESS + PM_B0_CACHE_SIZE);
+		addr += page_size) {
+		if (nrfx_nvmc_page_erase(addr) != NRFX_SUCCESS) {
+			return -EIO;
+		}
+	}
+	return 0;
+}
+
+
+bool bl_validation_cache_find(u32_t address, u32_t size, u32_t version,
+			const u8_t *hash, u32_t *key_idx)
+{
+	const struct record *rec = record_find(address);
+
+	if (rec == NULL) {
+		return false;
+	}
+
+	if ((rec->size != size) || (rec->version != version)
+		|| (memcmp(rec->hash, hash, CONFIG_SB_HASH_LEN) != 0)) {
+		/* The firmware at this address has changed. */
+		record_invalidate(rec);
+		return false;
+	}
+
+	*key_idx = rec->key_idx;
+	return true;
+}
+
+
+int bl_validation_cache_store(u32_t address, u32_t size, u32_t version,
+			const u8_t *hash, u32_t key_idx)
+{
+	const struct record *free_rec = NULL;
+	struct record new_rec = {
+		.magic = RECORD_MAGIC,
+		.address = address,
+		.size = size,
+		.version = version,
+		.key_idx = key_idx,
+	};
+
+	memcpy(new_rec.hash, hash, CONFIG_SB_HASH_LEN);
+
+	for (u32_t i = 0; i < NUM_RECORDS; i++) {
+		if (record_free(&records[i])) {
+			free_rec = &records[i];
+			break;
+		}
+		if (record_valid(&records[i])
+			&& (records[i].address == address)) {
+			record_invalidate(&records[i]);
+		}
+	}
+
+	if (free_rec == NULL) {
+		int err = cache_erase();
+
+		if (err) {
+			return err;
+		}
+		free_rec = &records[0];
+	}
+
+	nrfx_nvmc_words_write((u32_t)free_rec, &new_rec,
+			offsetof(struct record, valid) / 4);
+	nrfx_nvmc_word_write((u32_t)&free_rec->valid, RECORD_VALID);
+
+	new_rec.valid = RECORD_VALID;
+	if (memcmp(free_rec, &new_rec, sizeof(new_rec)) != 0) {
+		record_invalidate(free_rec);
+		return -EIO;
+	}
+	return 0;
+}
+
+
+void bl_validation_cache_invalidate(u32_t address)
+{
+	const struct record *rec = record_find(address);
+
+	if (rec != NULL) {
+		record_invalidate(rec);
+	}
+}
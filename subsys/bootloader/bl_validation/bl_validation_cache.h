@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef BL_VALIDATION_CACHE_H__
+#define BL_VALIDATION_CACHE_H__
+
+#include <stdbool.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Find the record of an earlier successful validation of a firmware.
+ *
+ * @details The records are kept in the b0_cache partition, one per firmware
+ *          address. A record for @p address that does not match the other
+ *          parameters is invalidated, since the firmware has changed.
+ *
+ * @param[in]  address  Address of the firmware.
+ * @param[in]  size     Size of the firmware, from its fw_info.
+ * @param[in]  version  Version of the firmware, from its fw_info.
+ * @param[in]  hash     Hash of the firmware, from its validation info.
+ * @param[out] key_idx  Index of the public key that the firmware was
+ *                      validated with.
+ *
+ * @retval true   A matching record was found.
+ * @retval false  No matching record was found.
+ */
+bool bl_validation_cache_find(u32_t address, u32_t size, u32_t version,
+			const u8_t *hash, u32_t *key_idx);
+
+/** Record a successful validation of a firmware.
+ *
+ * @details The previous record for @p address, if any, is invalidated.
+ *          When the partition is full, it is erased first, so the records
+ *          for other addresses are lost.
+ *
+ * @param[in]  address  Address of the firmware.
+ * @param[in]  size     Size of the firmware, from its fw_info.
+ * @param[in]  version  Version of the firmware, from its fw_info.
+ * @param[in]  hash     Hash of the firmware, which must have been verified.
+ * @param[in]  key_idx  Index of the public key that the firmware was
+ *                      validated with.
+ *
+ * @retval 0       The record was written.
+ * @retval -EIO    The record could not be written.
+ */
+int bl_validation_cache_store(u32_t address, u32_t size, u32_t version,
+			const u8_t *hash, u32_t key_idx);
+
+/** Invalidate the record for a firmware address, if there is one.
+ *
+ * @param[in]  address  Address of the firmware.
+ */
+void bl_validation_cache_invalidate(u32_t address);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BL_VALIDATION_CACHE_H__ */
@@ -77,6 +77,24 @@ int dfu_target_mcuboot_offset_get(size_t *offset);
  */
 int dfu_target_mcuboot_write(const void *const buf, size_t len);
 
+/**
+ * @brief Write firmware data at an offset of the image.
+ *
+ * The image is split in chunks of @c CONFIG_DFU_TARGET_MCUBOOT_CHUNK_SIZE
+ * bytes. Complete chunks are recorded, and writes to them are skipped.
+ * Writes to an incomplete chunk must not overlap. Data which does not fill
+ * a flash write block is kept in RAM until the rest of the block is written,
+ * and only a few such blocks can be pending at a time.
+ *
+ * @param[in] offset Offset of the data in the image.
+ * @param[in] buf Pointer to data that should be written.
+ * @param[in] len Length of data to write.
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+int dfu_target_mcuboot_write_at(size_t offset, const void *const buf,
+				size_t len);
+
 /**
  * @brief Deinitialize resources and finalize firmware upgrade if successful.
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/** @file dfu_target_mcuboot_hash.h
+ *
+ * @defgroup dfu_target_mcuboot_hash MCUBoot image hash verification
+ * @{
+ * @brief Verify the SHA-256 digest of an MCUBoot image while it is written.
+ *
+ * The image is hashed as it is passed to @ref dfu_target_mcuboot_hash_update,
+ * and the expected digest is taken from the SHA-256 TLV that follows the
+ * image, so that a corrupt image is detected without reading it back from
+ * flash.
+ */
+
+#ifndef DFU_TARGET_MCUBOOT_HASH_H__
+#define DFU_TARGET_MCUBOOT_HASH_H__
+
+#include <stddef.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start verifying a new image.
+ *
+ * @retval 0 On success, negative errno otherwise.
+ */
+int dfu_target_mcuboot_hash_init(void);
+
+/**
+ * @brief Hash the next part of the image.
+ *
+ * The image must be passed in order, from the start.
+ *
+ * @param[in] buf Pointer to the image data.
+ * @param[in] len Length of the image data.
+ *
+ * @retval 0 On success, negative errno otherwise.
+ */
+int dfu_target_mcuboot_hash_update(const u8_t *buf, size_t len);
+
+/**
+ * @brief Check the digest of the image against the digest in its TLV.
+ *
+ * @retval 0 If the digests match.
+ * @retval -EHASHINV If the digests do not match.
+ * @retval -EINVAL If the image is not an MCUBoot image, or it is incomplete.
+ * @return Any error code from @ref bl_sha256_finalize.
+ */
+int dfu_target_mcuboot_hash_verify(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DFU_TARGET_MCUBOOT_HASH_H__ */
+
+/**@} */
@@ -8,21 +8,26 @@
 #include <dfu/mcuboot.h>
 #include <dfu/dfu_target.h>
 
-#define DEF_DFU_TARGET(name) \
+#define DEF_DFU_TARGET(name, write_at_fn) \
 static const struct dfu_target dfu_target_ ## name  = { \
 	.init = dfu_target_ ## name ## _init, \
 	.offset_get = dfu_target_## name ##_offset_get, \
 	.write = dfu_target_ ## name ## _write, \
+	.write_at = write_at_fn, \
 	.done = dfu_target_ ## name ## _done, \
 }
 
 #ifdef CONFIG_DFU_TARGET_MODEM
 #include "dfu_target_modem.h"
-DEF_DFU_TARGET(modem);
+DEF_DFU_TARGET(modem, NULL);
 #endif
 #ifdef CONFIG_DFU_TARGET_MCUBOOT
 #include "dfu_target_mcuboot.h"
-DEF_DFU_TARGET(mcuboot);
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+DEF_DFU_TARGET(mcuboot, dfu_target_mcuboot_write_at);
+#else
+DEF_DFU_TARGET(mcuboot, NULL);
+#endif
 #endif
 
 #define MIN_SIZE_IDENTIFY_BUF 32
@@ -103,6 +108,19 @@ int dfu_target_write(const void *const buf, size_t len)
 	return current_target->write(buf, len);
 }
 
+int dfu_target_write_at(size_t offset, const void *const buf, size_t len)
+{
+	if (current_target == NULL || buf == NULL) {
+		return -EACCES;
+	}
+
+	if (current_target->write_at == NULL) {
+		return -ENOTSUP;
+	}
+
+	return current_target->write_at(offset, buf, len);
+}
+
 int dfu_target_done(bool successful)
 {
 	int err;
@@ -18,12 +18,16 @@
 
 #include <zephyr.h>
 #include <drivers/flash.h>
+#include <storage/flash_map.h>
 #include <pm_config.h>
 #include <logging/log.h>
 #include <dfu/mcuboot.h>
 #include <dfu/dfu_target.h>
 #include <dfu/flash_img.h>
+#include <storage/stream_flash.h>
 #include <settings/settings.h>
+#include <sys/crc.h>
+#include <dfu_target_mcuboot_hash.h>
 
 LOG_MODULE_REGISTER(dfu_target_mcuboot, CONFIG_DFU_TARGET_LOG_LEVEL);
 
@@ -32,6 +36,21 @@ LOG_MODULE_REGISTER(dfu_target_mcuboot, CONFIG_DFU_TARGET_LOG_LEVEL);
 
 static struct flash_img_context flash_img;
 
+/* Write progress, as stored with the settings subsystem. */
+static struct {
+	/* Number of bytes written to flash. */
+	size_t bytes_written;
+	/* Start of the data written since the progress was stored before. */
+	size_t tail_offset;
+	/* CRC32 of the data from tail_offset to bytes_written. */
+	u32_t tail_crc;
+} progress;
+static u32_t progress_time;
+/* Offset in the image where the flash_img stream starts, which is not zero
+ * when a transfer is resumed.
+ */
+static size_t stream_offset;
+
 int dfu_ctx_mcuboot_set_b1_file(const char *file, bool s0_active,
 				const char **update)
 {
@@ -69,18 +88,114 @@ int dfu_ctx_mcuboot_set_b1_file(const char *file, bool s0_active,
 
 #define MODULE "dfu"
 #define FILE_FLASH_IMG "mcuboot/flash_img"
+#define FILE_CHUNKS "mcuboot/chunks"
+
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+#define CHUNK_SIZE CONFIG_DFU_TARGET_MCUBOOT_CHUNK_SIZE
+#define CHUNK_CNT ceiling_fraction(PM_MCUBOOT_SECONDARY_SIZE, CHUNK_SIZE)
+/* Data is written to flash in blocks of this size, which is a multiple of
+ * every flash write block size supported.
+ */
+#define BLOCK_SIZE 16
+#define CHUNK_BLOCKS (CHUNK_SIZE / BLOCK_SIZE)
+/* Number of chunks which can be partly written at a time. */
+#define OPEN_CHUNK_CNT 4
+/* Number of blocks which can be partly written at a time. */
+#define PARTIAL_CNT 8
+
+BUILD_ASSERT(CHUNK_SIZE % BLOCK_SIZE == 0,
+	     "Chunk size must be a multiple of the block size");
+
+static const struct flash_area *fa;
+static size_t image_size;
+/* The image is written with dfu_target_mcuboot_write_at(). */
+static bool random_access;
+/* Chunks which are completely written. Stored with the progress. */
+static ATOMIC_DEFINE(chunks_done, CHUNK_CNT);
+/* Chunks which have been erased since the transfer was initialized. */
+static ATOMIC_DEFINE(chunks_erased, CHUNK_CNT);
+/* Incomplete chunks, with the blocks of each which are written to flash.
+ * A block is never written twice, since flash can not be programmed again
+ * without an erase.
+ */
+static struct {
+	bool used;
+	size_t chunk;
+	ATOMIC_DEFINE(blocks, CHUNK_BLOCKS);
+} open_chunks[OPEN_CHUNK_CNT];
+/* Blocks at the edges of the writes, which are written to flash once all
+ * their bytes are received.
+ */
+static struct {
+	bool used;
+	off_t off;
+	/* One bit for each byte of data received. */
+	u16_t received;
+	u8_t data[BLOCK_SIZE];
+} partial[PARTIAL_CNT];
+/* Bytes of the chunks completed since the chunks were stored. */
+static size_t chunks_unstored;
+#endif
+
+/**
+ * @brief Get the number of image bytes which are written in order.
+ */
+static size_t bytes_written_get(void)
+{
+	return stream_offset + flash_img_bytes_written(&flash_img);
+}
+
+/**
+ * @brief Compute the CRC32 of image data which is written to flash.
+ */
+static int image_crc(size_t from, size_t to, u32_t *crc)
+{
+	u8_t buf[64];
+
+	*crc = 0;
+
+	while (from < to) {
+		size_t len = MIN(sizeof(buf), to - from);
+		int err = flash_area_read(flash_img.flash_area, from, buf, len);
+
+		if (err) {
+			LOG_ERR("flash_area_read error %d", err);
+			return err;
+		}
+
+		*crc = crc32_ieee_update(*crc, buf, len);
+		from += len;
+	}
+
+	return 0;
+}
+
 /**
  * @brief Store the information stored in the flash_img instance so that it can
  *	  be restored from flash in case of a power failure, reboot etc.
+ *	  The data written since the previous store is read back, so that it
+ *	  can be verified when it is restored.
  */
 static int store_flash_img_context(void)
 {
 	if (IS_ENABLED(CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS)) {
 		char key[] = MODULE "/" FILE_FLASH_IMG;
-		size_t bytes_written = flash_img_bytes_written(&flash_img);
-		int err = settings_save_one(key, &bytes_written,
-					    sizeof(bytes_written));
+		size_t bytes_written = bytes_written_get();
+		size_t tail_offset = MIN(progress.bytes_written, bytes_written);
+		u32_t tail_crc;
+		int err;
+
+		err = image_crc(tail_offset, bytes_written, &tail_crc);
+		if (err) {
+			return err;
+		}
+
+		progress.bytes_written = bytes_written;
+		progress.tail_offset = tail_offset;
+		progress.tail_crc = tail_crc;
+		progress_time = k_uptime_get_32();
 
+		err = settings_save_one(key, &progress, sizeof(progress));
 		if (err) {
 			LOG_ERR("Problem storing offset (err %d)", err);
 			return err;
@@ -90,6 +205,185 @@ static int store_flash_img_context(void)
 	return 0;
 }
 
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS
+/**
+ * @brief Check whether enough data has been written, or enough time has
+ *	  passed, since the progress was last stored.
+ */
+static bool store_due(void)
+{
+	size_t bytes_written = bytes_written_get();
+
+	if (bytes_written == progress.bytes_written) {
+		/* Nothing new in flash, the write is still buffered. */
+		return false;
+	}
+
+	if (bytes_written - progress.bytes_written >=
+	    CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS_BYTES) {
+		return true;
+	}
+
+	return (CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS_MS > 0) &&
+	       (k_uptime_get_32() - progress_time >=
+		CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS_MS);
+}
+#endif
+
+/**
+ * @brief Resume writing after the stored progress.
+ *
+ * The data written since the progress was stored before is verified, and
+ * written again if it does not match. Writing resumes at the start of a flash
+ * page, since the page that is written to is erased first. The flash_img
+ * stream is started again at that page.
+ */
+static int restore_flash_img_context(size_t file_size)
+{
+	const struct flash_area *area = flash_img.flash_area;
+	struct device *dev = device_get_binding(area->fa_dev_name);
+	struct flash_pages_info page;
+	size_t resume = progress.bytes_written;
+	u32_t tail_crc;
+	int err;
+
+	if (resume == 0) {
+		return 0;
+	}
+
+	if ((resume > file_size) || (progress.tail_offset > resume)) {
+		LOG_WRN("Stored progress does not match image, restarting");
+		(void)memset(&progress, 0, sizeof(progress));
+		return 0;
+	}
+
+	err = image_crc(progress.tail_offset, resume, &tail_crc);
+	if (err) {
+		return err;
+	}
+
+	if (tail_crc != progress.tail_crc) {
+		LOG_WRN("Data written after offset %zu does not match",
+			progress.tail_offset);
+		resume = progress.tail_offset;
+	}
+
+	if (dev == NULL) {
+		LOG_ERR("Flash device %s not found", area->fa_dev_name);
+		return -ENODEV;
+	}
+
+	err = flash_get_page_info_by_offs(dev, area->fa_off + resume, &page);
+	if (err) {
+		LOG_ERR("flash_get_page_info_by_offs error %d", err);
+		return err;
+	}
+
+	resume = page.start_offset - area->fa_off;
+
+	err = stream_flash_init(&flash_img.stream, dev, flash_img.buf,
+				sizeof(flash_img.buf), page.start_offset,
+				area->fa_size - resume, NULL);
+	if (err) {
+		LOG_ERR("stream_flash_init error %d", err);
+		return err;
+	}
+
+	stream_offset = resume;
+	progress.bytes_written = resume;
+	progress.tail_offset = resume;
+	progress_time = k_uptime_get_32();
+
+	LOG_INF("Resuming write at offset %zu", resume);
+
+	return 0;
+}
+
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+/**
+ * @brief Store which chunks are completely written.
+ */
+static int store_chunks(void)
+{
+	if (IS_ENABLED(CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS)) {
+		char key[] = MODULE "/" FILE_CHUNKS;
+		int err = settings_save_one(key, chunks_done,
+					    sizeof(chunks_done));
+
+		if (err) {
+			LOG_ERR("Problem storing chunks (err %d)", err);
+			return err;
+		}
+
+		chunks_unstored = 0;
+		progress_time = k_uptime_get_32();
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS
+/**
+ * @brief Check whether enough chunks have been completed, or enough time has
+ *	  passed, since the chunks were last stored.
+ */
+static bool chunks_store_due(void)
+{
+	if (chunks_unstored >= CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS_BYTES) {
+		return true;
+	}
+
+	return (CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS_MS > 0) &&
+	       (k_uptime_get_32() - progress_time >=
+		CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS_MS);
+}
+#endif
+
+/**
+ * @brief Check that every chunk starts at a flash page, so that erasing a
+ *	  chunk leaves the other chunks intact.
+ */
+static int chunks_check(void)
+{
+	struct device *dev = device_get_binding(fa->fa_dev_name);
+	struct flash_pages_info page;
+
+	if (dev == NULL) {
+		LOG_ERR("Flash device %s not found", fa->fa_dev_name);
+		return -ENODEV;
+	}
+
+	for (size_t i = 0; i < CHUNK_CNT; i++) {
+		off_t off = fa->fa_off + i * CHUNK_SIZE;
+		int err = flash_get_page_info_by_offs(dev, off, &page);
+
+		if (err != 0) {
+			LOG_ERR("flash_get_page_info_by_offs error %d", err);
+			return err;
+		}
+
+		if (page.start_offset != off) {
+			LOG_ERR("Chunk size %d is not a multiple of the page "
+				"size %zu", CHUNK_SIZE, page.size);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Forget the incomplete chunks, they are erased and written again.
+ */
+static void chunks_open_reset(void)
+{
+	(void)memset(chunks_erased, 0, sizeof(chunks_erased));
+	(void)memset(open_chunks, 0, sizeof(open_chunks));
+	(void)memset(partial, 0, sizeof(partial));
+	chunks_unstored = 0;
+}
+#endif
+
 /**
  * @brief Function used by settings_load() to restore the flash_img variable.
  *	  See the Zephyr documentation of the settings subsystem for more
@@ -99,19 +393,87 @@ static int settings_set(const char *key, size_t len_rd,
 			settings_read_cb read_cb, void *cb_arg)
 {
 	if (!strcmp(key, FILE_FLASH_IMG)) {
-		size_t bytes_written = flash_img_bytes_written(&flash_img);
-		ssize_t len = read_cb(cb_arg, &bytes_written,
-				      sizeof(bytes_written));
+		ssize_t len;
+
+		if (len_rd == sizeof(progress.bytes_written)) {
+			/* Stored by an earlier version, without the CRC of
+			 * the data, so none of the data is verified.
+			 */
+			len = read_cb(cb_arg, &progress.bytes_written, len_rd);
+			progress.tail_offset = progress.bytes_written;
+			progress.tail_crc = 0;
+		} else {
+			len = read_cb(cb_arg, &progress, sizeof(progress));
+		}
 
-		if (len != sizeof(bytes_written)) {
+		if (len != len_rd) {
 			LOG_ERR("Can't read flash_img from storage");
+			(void)memset(&progress, 0, sizeof(progress));
+			return len;
+		}
+	}
+
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+	if (!strcmp(key, FILE_CHUNKS)) {
+		ssize_t len = read_cb(cb_arg, chunks_done, sizeof(chunks_done));
+
+		if (len != sizeof(chunks_done)) {
+			LOG_ERR("Can't read chunks from storage");
+			(void)memset(chunks_done, 0, sizeof(chunks_done));
 			return len;
 		}
+
+		for (size_t i = 0; i < CHUNK_CNT; i++) {
+			if (atomic_test_bit(chunks_done, i)) {
+				random_access = true;
+				break;
+			}
+		}
 	}
+#endif
 
 	return 0;
 }
 
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_VERIFY_HASH
+/**
+ * @brief Restart hashing the image with the part which is already in flash.
+ */
+static int hash_from_flash(size_t len)
+{
+	u8_t buf[128];
+	int err = dfu_target_mcuboot_hash_init();
+
+	for (size_t off = 0; (err == 0) && (off < len); off += sizeof(buf)) {
+		size_t n = MIN(sizeof(buf), len - off);
+
+		err = flash_area_read(flash_img.flash_area, off, buf, n);
+		if (err == 0) {
+			err = dfu_target_mcuboot_hash_update(buf, n);
+		}
+	}
+
+	return err;
+}
+
+static int verify_hash(void)
+{
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+	if (random_access) {
+		/* Not written in order, so the image was not hashed. */
+		int err = hash_from_flash(image_size);
+
+		if (err != 0) {
+			LOG_ERR("Unable to hash image: %d", err);
+			return err;
+		}
+	}
+#endif
+
+	return dfu_target_mcuboot_hash_verify();
+}
+#endif /* CONFIG_DFU_TARGET_MCUBOOT_VERIFY_HASH */
+
 bool dfu_target_mcuboot_identify(const void *const buf)
 {
 	/* MCUBoot headers starts with 4 byte magic word */
@@ -128,12 +490,39 @@ int dfu_target_mcuboot_init(size_t file_size, dfu_target_callback_t cb)
 		return err;
 	}
 
+	stream_offset = 0;
+
 	if (file_size > PM_MCUBOOT_SECONDARY_SIZE) {
 		LOG_ERR("Requested file too big to fit in flash %zu > 0x%x",
 			file_size, PM_MCUBOOT_SECONDARY_SIZE);
 		return -EFBIG;
 	}
 
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+	err = flash_area_open(PM_MCUBOOT_SECONDARY_ID, &fa);
+	if (err != 0) {
+		LOG_ERR("flash_area_open error %d", err);
+		return err;
+	}
+
+	if (BLOCK_SIZE % flash_area_align(fa) != 0) {
+		LOG_ERR("Unsupported write block size %d",
+			flash_area_align(fa));
+		return -ENOTSUP;
+	}
+
+	err = chunks_check();
+	if (err != 0) {
+		return err;
+	}
+
+	image_size = file_size;
+	/* Chunks which are not stored as done are written again. */
+	random_access = false;
+	(void)memset(chunks_done, 0, sizeof(chunks_done));
+	chunks_open_reset();
+#endif
+
 	if (IS_ENABLED(CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS)) {
 		static struct settings_handler sh = {
 			.name = MODULE,
@@ -153,19 +542,49 @@ int dfu_target_mcuboot_init(size_t file_size, dfu_target_callback_t cb)
 			return err;
 		}
 
+		(void)memset(&progress, 0, sizeof(progress));
 		err = settings_load();
 		if (err) {
 			LOG_ERR("Cannot load settings (err %d)", err);
 			return err;
 		}
+
+		err = restore_flash_img_context(file_size);
+		if (err) {
+			LOG_ERR("Cannot restore progress (err %d)", err);
+			return err;
+		}
 	}
 
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_VERIFY_HASH
+	/* Only the part of the image written before a reset is read back. */
+	err = hash_from_flash(bytes_written_get());
+	if (err) {
+		LOG_ERR("Unable to hash image: %d", err);
+		return err;
+	}
+#endif
+
 	return 0;
 }
 
 int dfu_target_mcuboot_offset_get(size_t *out)
 {
-	*out = flash_img_bytes_written(&flash_img);
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+	if (random_access) {
+		size_t i = 0;
+
+		/* Contiguous part written from the start of the image. */
+		while ((i < CHUNK_CNT) && atomic_test_bit(chunks_done, i)) {
+			i++;
+		}
+
+		*out = MIN(i * CHUNK_SIZE, image_size);
+		return 0;
+	}
+#endif
+
+	*out = bytes_written_get();
 	return 0;
 }
 
@@ -178,17 +597,326 @@ int dfu_target_mcuboot_write(const void *const buf, size_t len)
 		return err;
 	}
 
-	err = store_flash_img_context();
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_VERIFY_HASH
+	err = dfu_target_mcuboot_hash_update(buf, len);
+	if (err != 0) {
+		return err;
+	}
+#endif
+
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS
+	if (store_due()) {
+		err = store_flash_img_context();
+		if (err != 0) {
+			/* Failing to store progress is not a critical error
+			 * you'll just be left to download a bit more if you
+			 * fail and resume.
+			 */
+			LOG_WRN("Unable to store write progress: %d", err);
+		}
+	}
+#endif
+
+	return 0;
+}
+
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+static size_t chunk_len(size_t chunk)
+{
+	return MIN(CHUNK_SIZE, image_size - chunk * CHUNK_SIZE);
+}
+
+static int chunk_erase(size_t chunk)
+{
+	off_t off = chunk * CHUNK_SIZE;
+	int err;
+
+	if (atomic_test_and_set_bit(chunks_erased, chunk)) {
+		return 0;
+	}
+
+	err = flash_area_erase(fa, off, MIN(CHUNK_SIZE, fa->fa_size - off));
+	if (err != 0) {
+		LOG_ERR("flash_area_erase error %d", err);
+		atomic_clear_bit(chunks_erased, chunk);
+		return err;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the incomplete chunk which is written to, and start tracking it
+ *	  if it is not written to yet.
+ */
+static int chunk_open(size_t chunk)
+{
+	int idx = -1;
+
+	for (int i = 0; i < OPEN_CHUNK_CNT; i++) {
+		if (open_chunks[i].used && (open_chunks[i].chunk == chunk)) {
+			return i;
+		} else if (!open_chunks[i].used && (idx < 0)) {
+			idx = i;
+		}
+	}
+
+	if (idx < 0) {
+		LOG_ERR("Too many partly written chunks");
+		return -ENOMEM;
+	}
+
+	open_chunks[idx].used = true;
+	open_chunks[idx].chunk = chunk;
+	(void)memset(open_chunks[idx].blocks, 0,
+		     sizeof(open_chunks[idx].blocks));
+
+	return idx;
+}
+
+/**
+ * @brief Stop tracking a chunk which is complete, or which must be erased and
+ *	  written again.
+ */
+static void chunk_close(int idx)
+{
+	for (int i = 0; i < PARTIAL_CNT; i++) {
+		if (partial[i].used &&
+		    (partial[i].off / CHUNK_SIZE == open_chunks[idx].chunk)) {
+			partial[i].used = false;
+		}
+	}
+
+	open_chunks[idx].used = false;
+}
+
+/**
+ * @brief Drop the partly received blocks in a range of whole blocks which is
+ *	  written to flash directly.
+ */
+static void partial_free(off_t off, size_t len)
+{
+	for (int i = 0; i < PARTIAL_CNT; i++) {
+		if (partial[i].used && (partial[i].off >= off) &&
+		    (partial[i].off < off + len)) {
+			partial[i].used = false;
+		}
+	}
+}
+
+/**
+ * @brief Add bytes to a block, and write it once all its bytes are received.
+ *	  The end of the last block of the image is padded.
+ *
+ * @param written Set if the block is written to flash.
+ */
+static int partial_write(off_t off, const u8_t *buf, size_t len,
+			 bool *written)
+{
+	off_t block = ROUND_DOWN(off, BLOCK_SIZE);
+	size_t needed = MIN(BLOCK_SIZE, image_size - block);
+	int idx = -1;
+	int err;
+
+	*written = false;
+
+	for (int i = 0; i < PARTIAL_CNT; i++) {
+		if (partial[i].used && (partial[i].off == block)) {
+			idx = i;
+			break;
+		} else if (!partial[i].used && (idx < 0)) {
+			idx = i;
+		}
+	}
+
+	if (idx < 0) {
+		LOG_ERR("Too many partly written blocks");
+		return -ENOMEM;
+	}
+
+	if (!partial[idx].used) {
+		partial[idx].used = true;
+		partial[idx].off = block;
+		partial[idx].received = 0;
+		(void)memset(partial[idx].data, 0xff, sizeof(partial[idx].data));
+	}
+
+	/* Bytes which are received again are only copied again. */
+	memcpy(&partial[idx].data[off - block], buf, len);
+	partial[idx].received |= BIT_MASK(len) << (off - block);
+
+	if (partial[idx].received != BIT_MASK(needed)) {
+		return 0;
+	}
+
+	partial[idx].used = false;
+
+	err = flash_area_write(fa, block, partial[idx].data, BLOCK_SIZE);
 	if (err != 0) {
-		/* Failing to store progress is not a critical error you'll just
-		 * be left to download a bit more if you fail and resume.
-		 */
-		LOG_WRN("Unable to store write progress: %d", err);
+		LOG_ERR("flash_area_write error %d", err);
+		return err;
+	}
+
+	*written = true;
+
+	return 0;
+}
+
+/**
+ * @brief Write data which is within a single chunk.
+ *
+ * Blocks which are already in flash are skipped, so a range can be written
+ * again, and the chunk is only complete once every block of it is written.
+ */
+static int chunk_write(off_t off, const u8_t *buf, size_t len)
+{
+	size_t chunk = off / CHUNK_SIZE;
+	int idx;
+	int err;
+
+	if (atomic_test_bit(chunks_done, chunk)) {
+		/* Resumed transfer, already written. */
+		return 0;
+	}
+
+	idx = chunk_open(chunk);
+	if (idx < 0) {
+		return idx;
+	}
+
+	err = chunk_erase(chunk);
+	if (err != 0) {
+		return err;
+	}
+
+	while (len > 0) {
+		off_t block = ROUND_DOWN(off, BLOCK_SIZE);
+		size_t bit = (block % CHUNK_SIZE) / BLOCK_SIZE;
+		size_t n = MIN(len, block + BLOCK_SIZE - off);
+		size_t cnt = 1;
+		bool written = false;
+
+		if (atomic_test_bit(open_chunks[idx].blocks, bit)) {
+			/* Already in flash, the data is sent again. */
+		} else if ((off == block) && (len >= BLOCK_SIZE)) {
+			/* Whole blocks, up to one which is already in flash. */
+			while (((cnt + 1) * BLOCK_SIZE <= len) &&
+			       !atomic_test_bit(open_chunks[idx].blocks,
+						bit + cnt)) {
+				cnt++;
+			}
+
+			n = cnt * BLOCK_SIZE;
+			err = flash_area_write(fa, off, buf, n);
+			if (err != 0) {
+				LOG_ERR("flash_area_write error %d", err);
+			} else {
+				partial_free(off, n);
+			}
+			written = (err == 0);
+		} else {
+			err = partial_write(off, buf, n, &written);
+		}
+
+		if (err == -ENOMEM) {
+			return err;
+		} else if (err != 0) {
+			/* The blocks may be partly programmed, so the chunk
+			 * is erased and written again.
+			 */
+			chunk_close(idx);
+			atomic_clear_bit(chunks_erased, chunk);
+			return err;
+		}
+
+		for (size_t i = 0; written && (i < cnt); i++) {
+			atomic_set_bit(open_chunks[idx].blocks, bit + i);
+		}
+
+		off += n;
+		buf += n;
+		len -= n;
+	}
+
+	for (size_t i = 0; i < ceiling_fraction(chunk_len(chunk), BLOCK_SIZE);
+	     i++) {
+		if (!atomic_test_bit(open_chunks[idx].blocks, i)) {
+			return 0;
+		}
+	}
+
+	chunk_close(idx);
+	atomic_set_bit(chunks_done, chunk);
+
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS
+	chunks_unstored += chunk_len(chunk);
+	if (chunks_store_due()) {
+		err = store_chunks();
+		if (err != 0) {
+			/* The chunks are written again if the transfer is
+			 * resumed.
+			 */
+			LOG_WRN("Unable to store write progress: %d", err);
+		}
 	}
+#endif
 
 	return 0;
 }
 
+int dfu_target_mcuboot_write_at(size_t offset, const void *const buf,
+				size_t len)
+{
+	const u8_t *data = buf;
+	int err;
+
+	if ((offset > image_size) || (len > image_size - offset)) {
+		LOG_ERR("Write outside of the image");
+		return -EINVAL;
+	}
+
+	random_access = true;
+
+	while (len > 0) {
+		size_t n = MIN(len, CHUNK_SIZE - offset % CHUNK_SIZE);
+
+		err = chunk_write(offset, data, n);
+		if (err != 0) {
+			return err;
+		}
+
+		offset += n;
+		data += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+static bool chunks_complete(void)
+{
+	for (size_t i = 0; i < ceiling_fraction(image_size, CHUNK_SIZE); i++) {
+		if (!atomic_test_bit(chunks_done, i)) {
+			LOG_ERR("Chunk %zu is missing", i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void reset_chunks(void)
+{
+	random_access = false;
+	(void)memset(chunks_done, 0, sizeof(chunks_done));
+	chunks_open_reset();
+
+	if (store_chunks() != 0) {
+		LOG_ERR("Unable to reset chunks");
+	}
+}
+#endif /* CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT */
+
 static void reset_flash_context(void)
 {
 	/* Need to set bytes_written to 0 */
@@ -197,10 +925,16 @@ static void reset_flash_context(void)
 	if (err) {
 		LOG_ERR("Unable to re-initialize flash_img");
 	}
+	stream_offset = 0;
+	(void)memset(&progress, 0, sizeof(progress));
 	err = store_flash_img_context();
 	if (err != 0) {
 		LOG_ERR("Unable to reset write progress: %d", err);
 	}
+
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+	reset_chunks();
+#endif
 }
 
 int dfu_target_mcuboot_done(bool successful)
@@ -208,13 +942,36 @@ int dfu_target_mcuboot_done(bool successful)
 	int err = 0;
 
 	if (successful) {
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT
+		if (random_access) {
+			if (!chunks_complete()) {
+				/* Let the application write the missing
+				 * chunks.
+				 */
+				return -EINVAL;
+			}
+		} else {
+			err = flash_img_buffered_write(&flash_img, NULL, 0,
+						       true);
+		}
+#else
 		err = flash_img_buffered_write(&flash_img, NULL, 0, true);
+#endif
 		if (err != 0) {
 			LOG_ERR("flash_img_buffered_write error %d", err);
 			reset_flash_context();
 			return err;
 		}
 
+#ifdef CONFIG_DFU_TARGET_MCUBOOT_VERIFY_HASH
+		err = verify_hash();
+		if (err != 0) {
+			LOG_ERR("Image verification failed: %d", err);
+			reset_flash_context();
+			return err;
+		}
+#endif
+
 		err = boot_request_upgrade(BOOT_UPGRADE_TEST);
 		if (err != 0) {
 			LOG_ERR("boot_request_upgrade error %d", err);
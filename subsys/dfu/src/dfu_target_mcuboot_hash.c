@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/byteorder.h>
+#include <logging/log.h>
+#include <bl_crypto.h>
+#include <dfu_target_mcuboot_hash.h>
+
+LOG_MODULE_REGISTER(dfu_target_mcuboot_hash, CONFIG_DFU_TARGET_LOG_LEVEL);
+
+#define IMAGE_MAGIC 0x96f3b83d
+#define IMAGE_TLV_INFO_MAGIC 0x6907
+#define IMAGE_TLV_SHA256 0x10
+#define IMAGE_TLV_HDR_SIZE 4
+#define SHA256_LEN 32
+
+/* Start of the MCUBoot image header, in little endian. */
+struct image_header {
+	u32_t magic;
+	u32_t load_addr;
+	u16_t hdr_size;
+	u16_t protect_tlv_size;
+	u32_t img_size;
+} __packed;
+
+static bl_sha256_ctx_t ctx;
+/* Number of bytes of the image processed. */
+static size_t pos;
+/* Header, collected until it is complete. */
+static union {
+	struct image_header fields;
+	u8_t raw[sizeof(struct image_header)];
+} hdr;
+/* Length of the hashed part of the image, or 0 if not known yet. */
+static size_t hashed_len;
+
+/* State of the TLV being parsed, after the hashed part of the image. */
+static struct {
+	/* TLV info header, which holds the magic and the size of the TLVs. */
+	u8_t info[IMAGE_TLV_HDR_SIZE];
+	/* Offset of the next TLV in the image. */
+	size_t next;
+	/* Header of the current TLV. */
+	u8_t hdr[IMAGE_TLV_HDR_SIZE];
+	u8_t digest[SHA256_LEN];
+	bool digest_found;
+} tlv;
+
+int dfu_target_mcuboot_hash_init(void)
+{
+	pos = 0;
+	hashed_len = 0;
+	memset(&tlv, 0, sizeof(tlv));
+
+	return bl_sha256_init(&ctx);
+}
+
+static void header_parse(void)
+{
+	if (sys_le32_to_cpu(hdr.fields.magic) != IMAGE_MAGIC) {
+		LOG_ERR("Not an MCUBoot image");
+		return;
+	}
+
+	hashed_len = sys_le16_to_cpu(hdr.fields.hdr_size) +
+		     sys_le32_to_cpu(hdr.fields.img_size) +
+		     sys_le16_to_cpu(hdr.fields.protect_tlv_size);
+
+	/* Skip the TLV info header, which holds the magic and the size. */
+	tlv.next = hashed_len + IMAGE_TLV_HDR_SIZE;
+}
+
+static void tlv_parse(const u8_t *buf, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		size_t off = pos + i;
+		size_t tlv_off;
+		u16_t tlv_len;
+
+		if (off < hashed_len + IMAGE_TLV_HDR_SIZE) {
+			tlv.info[off - hashed_len] = buf[i];
+			continue;
+		}
+
+		if (off == tlv.next + IMAGE_TLV_HDR_SIZE) {
+			/* Header of the current TLV is complete. */
+			tlv.next += IMAGE_TLV_HDR_SIZE +
+				    sys_get_le16(&tlv.hdr[2]);
+		}
+
+		if (off >= tlv.next) {
+			/* Header of the next TLV. */
+			tlv.hdr[off - tlv.next] = buf[i];
+			continue;
+		}
+
+		tlv_len = sys_get_le16(&tlv.hdr[2]);
+		tlv_off = off - (tlv.next - tlv_len);
+
+		if ((tlv.hdr[0] == IMAGE_TLV_SHA256) &&
+		    (tlv_len == SHA256_LEN)) {
+			tlv.digest[tlv_off] = buf[i];
+			if (tlv_off == SHA256_LEN - 1) {
+				tlv.digest_found = true;
+			}
+		}
+	}
+}
+
+int dfu_target_mcuboot_hash_update(const u8_t *buf, size_t len)
+{
+	int err;
+
+	while (len > 0) {
+		size_t n = len;
+
+		if (pos < sizeof(hdr)) {
+			n = MIN(n, sizeof(hdr) - pos);
+			memcpy(&hdr.raw[pos], buf, n);
+			if (pos + n == sizeof(hdr)) {
+				header_parse();
+			}
+		} else if (hashed_len == 0) {
+			/* Not an MCUBoot image, verification fails. */
+			return 0;
+		}
+
+		if ((pos < sizeof(hdr)) || (pos < hashed_len)) {
+			if (hashed_len > 0) {
+				n = MIN(n, hashed_len - pos);
+			}
+
+			err = bl_sha256_update(&ctx, buf, n);
+			if (err) {
+				LOG_ERR("bl_sha256_update error %d", err);
+				return err;
+			}
+		} else {
+			tlv_parse(buf, n);
+		}
+
+		pos += n;
+		buf += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+int dfu_target_mcuboot_hash_verify(void)
+{
+	u8_t digest[SHA256_LEN];
+	int err;
+
+	if ((hashed_len == 0) || (pos < hashed_len + IMAGE_TLV_HDR_SIZE) ||
+	    (sys_get_le16(&tlv.info[0]) != IMAGE_TLV_INFO_MAGIC) ||
+	    (pos < hashed_len + sys_get_le16(&tlv.info[2]))) {
+		LOG_ERR("Image is incomplete, %zu bytes", pos);
+		return -EINVAL;
+	}
+
+	if (!tlv.digest_found) {
+		LOG_ERR("Image has no SHA-256 digest");
+		return -EINVAL;
+	}
+
+	err = bl_sha256_finalize(&ctx, digest);
+	if (err) {
+		LOG_ERR("bl_sha256_finalize error %d", err);
+		return err;
+	}
+
+	if (memcmp(digest, tlv.digest, sizeof(digest)) != 0) {
+		LOG_ERR("Image digest does not match");
+		return -EHASHINV;
+	}
+
+	return 0;
+}
@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <zephyr.h>
 #include <spinlock.h>
 #include <sys/slist.h>
@@ -29,9 +30,101 @@ extern u32_t event_manager_displayed_events;
 static u32_t event_manager_displayed_events;
 #endif
 
+#if CONFIG_DESKTOP_EVENT_MANAGER_DISPATCH_TABLE
+#define DISPATCH_TABLE_SIZE CONFIG_DESKTOP_EVENT_MANAGER_DISPATCH_TABLE_SIZE
+/* Number of event types is limited by the size of displayed events mask. */
+#define DISPATCH_EVENT_CNT (sizeof(event_manager_displayed_events) * 8)
+#else
+#define DISPATCH_TABLE_SIZE 0
+#define DISPATCH_EVENT_CNT 0
+#endif
+
+typedef bool (*event_notification_fn)(const struct event_header *eh);
+typedef bool (*event_merge_fn)(struct event_header *queued,
+			       const struct event_header *eh);
+
 static u16_t profiler_event_ids[IDS_COUNT];
+
+/* Flat dispatch table. Notification functions of all subscribers of the
+ * event type with index i are stored in dispatch_fns between
+ * dispatch_idx[i] and dispatch_idx[i + 1], ordered by subscriber priority.
+ */
+static event_notification_fn dispatch_fns[DISPATCH_TABLE_SIZE];
+static const struct event_subscriber *dispatch_subs[DISPATCH_TABLE_SIZE];
+static u16_t dispatch_idx[DISPATCH_EVENT_CNT + 1];
+static bool dispatch_table_ready;
+
+#if CONFIG_DESKTOP_EVENT_MANAGER_PROC_CLASSES
+#define PROC_CLASS_CNT EVENT_PROC_CLASS_COUNT
+/* Number of event types is limited by the size of displayed events mask. */
+#define PROC_CLASS_EVENT_CNT (sizeof(event_manager_displayed_events) * 8)
+#else
+#define PROC_CLASS_CNT 1
+#define PROC_CLASS_EVENT_CNT 0
+#endif
+
+#if CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+#define LATENCY_HIST_BUCKET_CNT EVENT_MANAGER_LATENCY_HIST_BUCKET_CNT
+
+static u32_t latency_hist[PROC_CLASS_CNT][LATENCY_HIST_BUCKET_CNT];
+#endif
+
+static u8_t event_type_proc_classes[PROC_CLASS_EVENT_CNT];
+static bool proc_classes_ready;
+
+/* Ensure the processing class section exists even if no class is set. */
+const struct {} __event_proc_class_empty
+__attribute__((__section__("event_proc_classes"))) = {};
+
+#if CONFIG_DESKTOP_EVENT_MANAGER_HIGH_CLASS_WORKQ
+static void event_processor_high_fn(struct k_work *work);
+
+static K_THREAD_STACK_DEFINE(event_high_workq_stack,
+			     CONFIG_DESKTOP_EVENT_MANAGER_HIGH_CLASS_WORKQ_STACK_SIZE);
+static struct k_work_q event_high_workq;
+#endif
+
+#if CONFIG_DESKTOP_EVENT_MANAGER_EVENT_MERGE
+/* Number of event types is limited by the size of displayed events mask. */
+#define MERGE_EVENT_CNT (sizeof(event_manager_displayed_events) * 8)
+#else
+#define MERGE_EVENT_CNT 0
+#endif
+
+/* Merge functions and the most recent event of every event type that is
+ * still waiting for processing. Pending events are protected by the lock.
+ */
+static event_merge_fn merge_fns[MERGE_EVENT_CNT];
+static struct event_header *merge_pending[MERGE_EVENT_CNT];
+static bool merge_ready;
+
+/* Ensure the merge function section exists even if no function is set. */
+const struct {} __event_merge_fn_empty
+__attribute__((__section__("event_merge_fns"))) = {};
+
 static K_WORK_DEFINE(event_processor, event_processor_fn);
-static sys_slist_t eventq = SYS_SLIST_STATIC_INIT(&eventq);
+#if CONFIG_DESKTOP_EVENT_MANAGER_HIGH_CLASS_WORKQ
+static K_WORK_DEFINE(event_processor_high, event_processor_high_fn);
+#endif
+#if CONFIG_DESKTOP_EVENT_MANAGER_LOCKLESS_QUEUE
+#define LOCKLESS_QUEUE_CNT PROC_CLASS_CNT
+#else
+#define LOCKLESS_QUEUE_CNT 0
+#endif
+
+/* Lock-free multi-producer single-consumer intrusive queue. Producers only
+ * exchange the head pointer, so they never block each other. The stub node
+ * keeps the queue non-empty for the consumer. NULL head and tail stand for
+ * the stub, so a zero-initialized queue is empty.
+ */
+struct lockless_queue {
+	sys_snode_t *head;
+	sys_snode_t *tail;
+	sys_snode_t stub;
+};
+
+static sys_slist_t eventq[PROC_CLASS_CNT];
+static struct lockless_queue eventq_lockless[LOCKLESS_QUEUE_CNT];
 static struct k_spinlock lock;
 
 
@@ -127,6 +220,34 @@ static void trace_event_execution(const struct event_header *eh, bool is_start)
 	profiler_log_send(&buf, trace_evt_id);
 }
 
+#if CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS
+static void trace_listener_execution(const struct event_header *eh,
+				     const struct event_listener *el,
+				     u32_t cycles)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_PROFILER_ENABLED)) {
+		return;
+	}
+
+	size_t event_cnt = __stop_event_types - __start_event_types;
+	size_t trace_evt_id = profiler_event_ids[event_cnt + 2];
+
+	if (!is_profiling_enabled(trace_evt_id)) {
+		return;
+	}
+
+	struct log_event_buf buf;
+	ARG_UNUSED(buf);
+
+	/* Names go last, they are truncated if they do not fit. */
+	profiler_log_start(&buf);
+	profiler_log_encode_u32(&buf, cycles);
+	profiler_log_encode_string(&buf, eh->type_id->name);
+	profiler_log_encode_string(&buf, el->name);
+	profiler_log_send(&buf, trace_evt_id);
+}
+#endif
+
 static void trace_event_submission(const struct event_header *eh)
 {
 	if (!IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_PROFILER_ENABLED)) {
@@ -181,6 +302,22 @@ static void trace_register_execution_tracking_events(void)
 	profiler_event_ids[event_cnt + 1] = profiler_event_id;
 }
 
+static void trace_register_listener_execution_event(void)
+{
+	const char *labels[] = {"cycles", "event_type", "listener"};
+	enum profiler_arg types[] = {PROFILER_ARG_U32, PROFILER_ARG_STRING,
+				     PROFILER_ARG_STRING};
+	size_t event_cnt = __stop_event_types - __start_event_types;
+
+	ARG_UNUSED(types);
+	ARG_UNUSED(labels);
+
+	/* Listener execution event after event execution events. */
+	profiler_event_ids[event_cnt + 2] = profiler_register_event_type(
+				"listener_execution",
+				labels, types, ARRAY_SIZE(labels));
+}
+
 static void trace_register_events(void)
 {
 	for (const struct event_type *et = __start_event_types;
@@ -201,6 +338,10 @@ static void trace_register_events(void)
 	if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_TRACE_EVENT_EXECUTION)) {
 		trace_register_execution_tracking_events();
 	}
+
+	if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS)) {
+		trace_register_listener_execution_event();
+	}
 }
 
 static int trace_event_init(void)
@@ -217,19 +358,335 @@ static int trace_event_init(void)
 	return 0;
 }
 
-static void event_processor_fn(struct k_work *work)
+static int dispatch_table_init(void)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_DISPATCH_TABLE)) {
+		return 0;
+	}
+
+	size_t event_cnt = __stop_event_types - __start_event_types;
+	size_t idx = 0;
+
+	if (event_cnt > DISPATCH_EVENT_CNT) {
+		LOG_ERR("Too many event types");
+		return -ENOMEM;
+	}
+
+	for (const struct event_type *et = __start_event_types;
+	     (et != NULL) && (et != __stop_event_types);
+	     et++) {
+		dispatch_idx[et - __start_event_types] = idx;
+
+		for (size_t prio = SUBS_PRIO_MIN; prio <= SUBS_PRIO_MAX;
+		     prio++) {
+			for (const struct event_subscriber *es =
+					et->subs_start[prio];
+			     es != et->subs_stop[prio];
+			     es++) {
+
+				__ASSERT_NO_MSG(es != NULL);
+
+				const struct event_listener *el = es->listener;
+
+				__ASSERT_NO_MSG(el != NULL);
+				__ASSERT_NO_MSG(el->notification != NULL);
+
+				if (idx >= DISPATCH_TABLE_SIZE) {
+					LOG_ERR("Dispatch table too small");
+					return -ENOMEM;
+				}
+
+				dispatch_subs[idx] = es;
+				dispatch_fns[idx] = el->notification;
+				idx++;
+			}
+		}
+	}
+
+	dispatch_idx[event_cnt] = idx;
+	dispatch_table_ready = true;
+
+	return 0;
+}
+
+#if CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS
+/* Statistics are updated by the threads processing events,
+ * and read or reset from other threads.
+ */
+static struct k_spinlock stats_lock;
+
+static void listener_stats_update(struct event_subscriber_stats *stats,
+				  u32_t cycles)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	if (stats->call_cnt == 0) {
+		stats->min_cycles = cycles;
+		stats->max_cycles = cycles;
+	} else {
+		stats->min_cycles = MIN(stats->min_cycles, cycles);
+		stats->max_cycles = MAX(stats->max_cycles, cycles);
+	}
+
+	stats->total_cycles += cycles;
+	stats->call_cnt++;
+
+	k_spin_unlock(&stats_lock, key);
+}
+
+void event_manager_listener_stats_get(const struct event_subscriber *es,
+				      struct event_subscriber_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	*stats = *es->stats;
+
+	k_spin_unlock(&stats_lock, key);
+}
+
+void event_manager_listener_stats_reset(void)
+{
+	for (const struct event_type *et = __start_event_types;
+	     (et != NULL) && (et != __stop_event_types);
+	     et++) {
+		for (size_t prio = SUBS_PRIO_MIN;
+		     prio <= SUBS_PRIO_MAX;
+		     prio++) {
+			for (const struct event_subscriber *es =
+					et->subs_start[prio];
+			     es != et->subs_stop[prio];
+			     es++) {
+				k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+				memset(es->stats, 0, sizeof(*es->stats));
+
+				k_spin_unlock(&stats_lock, key);
+			}
+		}
+	}
+}
+#endif
+
+static bool listener_notify(const struct event_header *eh,
+			    const struct event_subscriber *es,
+			    event_notification_fn notification)
+{
+#if CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS
+	u32_t start = k_cycle_get_32();
+	bool consumed = notification(eh);
+	u32_t cycles = k_cycle_get_32() - start;
+
+	listener_stats_update(es->stats, cycles);
+	trace_listener_execution(eh, es->listener, cycles);
+
+	return consumed;
+#else
+	return notification(eh);
+#endif
+}
+
+static void event_dispatch_table(const struct event_header *eh)
+{
+	const struct event_type *et = eh->type_id;
+	size_t event_idx = et - __start_event_types;
+	size_t stop = dispatch_idx[event_idx + 1];
+
+	for (size_t i = dispatch_idx[event_idx]; i < stop; i++) {
+		log_event_progress(et, dispatch_subs[i]->listener);
+
+		if (listener_notify(eh, dispatch_subs[i], dispatch_fns[i])) {
+			log_event_consumed(et);
+			break;
+		}
+	}
+}
+
+static void event_dispatch(const struct event_header *eh)
+{
+	if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_DISPATCH_TABLE) &&
+	    dispatch_table_ready) {
+		event_dispatch_table(eh);
+		return;
+	}
+
+	const struct event_type *et = eh->type_id;
+	bool consumed = false;
+
+	for (size_t prio = SUBS_PRIO_MIN;
+	     (prio <= SUBS_PRIO_MAX) && !consumed;
+	     prio++) {
+		for (const struct event_subscriber *es =
+				et->subs_start[prio];
+		     (es != et->subs_stop[prio]) && !consumed;
+		     es++) {
+
+			__ASSERT_NO_MSG(es != NULL);
+
+			const struct event_listener *el = es->listener;
+
+			__ASSERT_NO_MSG(el != NULL);
+			__ASSERT_NO_MSG(el->notification != NULL);
+
+			log_event_progress(et, el);
+
+			consumed = listener_notify(eh, es, el->notification);
+
+			if (consumed) {
+				log_event_consumed(et);
+			}
+		}
+	}
+}
+
+static void event_free(struct event_header *eh)
+{
+	const struct event_type *et = eh->type_id;
+
+	if (et->mem_slab) {
+		void *event = eh;
+
+		k_mem_slab_free(et->mem_slab->slab, &event);
+	} else {
+		k_free(eh);
+	}
+}
+
+static void latency_hist_update(const struct event_header *eh,
+				size_t proc_class)
+{
+#if CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+	u32_t latency = k_cyc_to_us_floor32(k_cycle_get_32() - eh->timestamp);
+	size_t bucket = 0;
+
+	/* Bucket i holds latencies from 2^(i-1) to 2^i - 1 microseconds. */
+	if (latency > 0) {
+		bucket = MIN(32 - __builtin_clz(latency),
+			     LATENCY_HIST_BUCKET_CNT - 1);
+	}
+
+	latency_hist[proc_class][bucket]++;
+#endif
+}
+
+#if CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+const u32_t *event_manager_latency_hist_get(enum event_proc_class proc_class)
+{
+	__ASSERT_NO_MSG(proc_class < PROC_CLASS_CNT);
+
+	return latency_hist[proc_class];
+}
+#endif
+
+static int merge_init(void)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_EVENT_MERGE)) {
+		return 0;
+	}
+
+	for (const struct event_merge_fn_entry *em = __start_event_merge_fns;
+	     (em != NULL) && (em != __stop_event_merge_fns);
+	     em++) {
+		ASSERT_EVENT_ID(em->type);
+		__ASSERT_NO_MSG(em->merge != NULL);
+
+		size_t event_idx = em->type - __start_event_types;
+
+		if (event_idx >= MERGE_EVENT_CNT) {
+			LOG_ERR("Too many event types");
+			return -ENOMEM;
+		}
+
+		merge_fns[event_idx] = em->merge;
+	}
+
+	merge_ready = true;
+
+	return 0;
+}
+
+/* Must be called with the lock held. Returns true if the event was merged
+ * into an already queued event of the same type.
+ */
+static bool event_merge(struct event_header *eh)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_EVENT_MERGE) ||
+	    !merge_ready) {
+		return false;
+	}
+
+	size_t event_idx = eh->type_id - __start_event_types;
+	event_merge_fn merge = merge_fns[event_idx];
+
+	if (!merge) {
+		return false;
+	}
+
+	struct event_header *pending = merge_pending[event_idx];
+
+	if (pending && merge(pending, eh)) {
+		return true;
+	}
+
+	merge_pending[event_idx] = eh;
+
+	return false;
+}
+
+static void event_merge_stop(const struct event_header *eh)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_EVENT_MERGE) ||
+	    !merge_ready) {
+		return;
+	}
+
+	size_t event_idx = eh->type_id - __start_event_types;
+
+	if (!merge_fns[event_idx]) {
+		return;
+	}
+
+	/* Event is about to be processed and can no longer be modified. */
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (merge_pending[event_idx] == eh) {
+		merge_pending[event_idx] = NULL;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static void process_event(struct event_header *eh, size_t proc_class)
+{
+	ASSERT_EVENT_ID(eh->type_id);
+
+	event_merge_stop(eh);
+
+	latency_hist_update(eh, proc_class);
+
+	trace_event_execution(eh, true);
+
+	log_event(eh);
+
+	event_dispatch(eh);
+
+	trace_event_execution(eh, false);
+
+	event_free(eh);
+}
+
+static void process_event_list(void)
 {
 	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
 
 	/* Make current event list local. */
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	if (sys_slist_is_empty(&eventq)) {
+	if (sys_slist_is_empty(&eventq[0])) {
 		k_spin_unlock(&lock, key);
 		return;
 	}
 
-	sys_slist_merge_slist(&events, &eventq);
+	sys_slist_merge_slist(&events, &eventq[0]);
 
 	k_spin_unlock(&lock, key);
 
@@ -241,45 +698,240 @@ static void event_processor_fn(struct k_work *work)
 						       struct event_header,
 						       node);
 
-		ASSERT_EVENT_ID(eh->type_id);
+		process_event(eh, 0);
+	}
+}
 
-		const struct event_type *et = eh->type_id;
+static void lockless_queue_push(struct lockless_queue *q, sys_snode_t *node)
+{
+	__atomic_store_n(&node->next, NULL, __ATOMIC_RELAXED);
 
-		trace_event_execution(eh, true);
+	sys_snode_t *prev = __atomic_exchange_n(&q->head, node,
+						__ATOMIC_ACQ_REL);
 
-		log_event(eh);
+	if (!prev) {
+		prev = &q->stub;
+	}
 
-		bool consumed = false;
+	/* Until this store, the consumer sees the queue as empty after
+	 * the previous node. The producer submits the work afterwards, so
+	 * the consumer will run again.
+	 */
+	__atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+}
 
-		for (size_t prio = SUBS_PRIO_MIN;
-		     (prio <= SUBS_PRIO_MAX) && !consumed;
-		     prio++) {
-			for (const struct event_subscriber *es =
-					et->subs_start[prio];
-			     (es != et->subs_stop[prio]) && !consumed;
-			     es++) {
+static sys_snode_t *lockless_queue_pop(struct lockless_queue *q)
+{
+	sys_snode_t *tail = q->tail ? q->tail : &q->stub;
+	sys_snode_t *next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
 
-				__ASSERT_NO_MSG(es != NULL);
+	if (tail == &q->stub) {
+		if (!next) {
+			return NULL;
+		}
 
-				const struct event_listener *el = es->listener;
+		q->tail = next;
+		tail = next;
+		next = __atomic_load_n(&next->next, __ATOMIC_ACQUIRE);
+	}
 
-				__ASSERT_NO_MSG(el != NULL);
-				__ASSERT_NO_MSG(el->notification != NULL);
+	if (next) {
+		q->tail = next;
+		return tail;
+	}
 
-				log_event_progress(et, el);
+	if (tail != __atomic_load_n(&q->head, __ATOMIC_ACQUIRE)) {
+		/* Producer has not linked its node yet. */
+		return NULL;
+	}
 
-				consumed = el->notification(eh);
+	/* Last node can be removed only when the stub is behind it. */
+	lockless_queue_push(q, &q->stub);
 
-				if (consumed) {
-					log_event_consumed(et);
-				}
+	next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+	if (next) {
+		q->tail = next;
+		return tail;
+	}
+
+	return NULL;
+}
+
+static sys_snode_t *eventq_get(size_t first_class, size_t last_class,
+			       size_t *proc_class)
+{
+	sys_snode_t *node = NULL;
+
+	if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_LOCKLESS_QUEUE)) {
+		for (size_t c = first_class; c <= last_class; c++) {
+			node = lockless_queue_pop(&eventq_lockless[c]);
+			if (node) {
+				*proc_class = c;
+				break;
 			}
 		}
 
-		trace_event_execution(eh, false);
+		return node;
+	}
 
-		k_free(eh);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t c = first_class; c <= last_class; c++) {
+		node = sys_slist_get(&eventq[c]);
+		if (node) {
+			*proc_class = c;
+			break;
+		}
 	}
+
+	k_spin_unlock(&lock, key);
+
+	return node;
+}
+
+static void process_event_classes(size_t first_class, size_t last_class)
+{
+	while (true) {
+		size_t proc_class;
+
+		/* Higher priority classes are checked again after every
+		 * processed event.
+		 */
+		sys_snode_t *node = eventq_get(first_class, last_class,
+					       &proc_class);
+
+		if (!node) {
+			break;
+		}
+
+		process_event(CONTAINER_OF(node, struct event_header, node),
+			      proc_class);
+	}
+}
+
+static void event_processor_fn(struct k_work *work)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_PROC_CLASSES)) {
+		if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_LOCKLESS_QUEUE)) {
+			process_event_classes(0, 0);
+		} else {
+			process_event_list();
+		}
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_HIGH_CLASS_WORKQ)) {
+		process_event_classes(EVENT_PROC_CLASS_NORMAL,
+				      PROC_CLASS_CNT - 1);
+	} else {
+		process_event_classes(EVENT_PROC_CLASS_HIGH,
+				      PROC_CLASS_CNT - 1);
+	}
+}
+
+#if CONFIG_DESKTOP_EVENT_MANAGER_HIGH_CLASS_WORKQ
+static void event_processor_high_fn(struct k_work *work)
+{
+	process_event_classes(EVENT_PROC_CLASS_HIGH, EVENT_PROC_CLASS_HIGH);
+}
+#endif
+
+static int proc_classes_init(void)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_PROC_CLASSES)) {
+		return 0;
+	}
+
+	/* Event types without assigned processing class use
+	 * the normal class.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(event_type_proc_classes); i++) {
+		event_type_proc_classes[i] = EVENT_PROC_CLASS_NORMAL;
+	}
+
+	for (const struct event_proc_class_entry *ec =
+		__start_event_proc_classes;
+	     (ec != NULL) && (ec != __stop_event_proc_classes);
+	     ec++) {
+		ASSERT_EVENT_ID(ec->type);
+		__ASSERT_NO_MSG(ec->proc_class < EVENT_PROC_CLASS_COUNT);
+
+		size_t event_idx = ec->type - __start_event_types;
+
+		if (event_idx >= PROC_CLASS_EVENT_CNT) {
+			LOG_ERR("Too many event types");
+			return -ENOMEM;
+		}
+
+		event_type_proc_classes[event_idx] = ec->proc_class;
+	}
+
+#if CONFIG_DESKTOP_EVENT_MANAGER_HIGH_CLASS_WORKQ
+	k_work_q_start(&event_high_workq, event_high_workq_stack,
+		       K_THREAD_STACK_SIZEOF(event_high_workq_stack),
+		       CONFIG_DESKTOP_EVENT_MANAGER_HIGH_CLASS_WORKQ_PRIORITY);
+	k_thread_name_set(&event_high_workq.thread, "event_high_workq");
+#endif
+
+	proc_classes_ready = true;
+
+	return 0;
+}
+
+static size_t event_proc_class_get(const struct event_type *et)
+{
+	if (!IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_PROC_CLASSES)) {
+		return 0;
+	}
+
+	if (!proc_classes_ready) {
+		/* The high class work queue is not started yet, the normal
+		 * class is processed once the system work queue runs.
+		 */
+		return EVENT_PROC_CLASS_NORMAL;
+	}
+
+	return event_type_proc_classes[et - __start_event_types];
+}
+
+void *_event_mem_slab_alloc(struct event_mem_slab *mem_slab)
+{
+	void *event;
+
+	if (k_mem_slab_alloc(mem_slab->slab, &event, K_NO_WAIT)) {
+		atomic_inc(&mem_slab->alloc_fail_cnt);
+		return NULL;
+	}
+
+	atomic_val_t used = k_mem_slab_num_used_get(mem_slab->slab);
+	atomic_val_t max_used = atomic_get(&mem_slab->max_used);
+
+	while ((used > max_used) &&
+	       !atomic_cas(&mem_slab->max_used, max_used, used)) {
+		max_used = atomic_get(&mem_slab->max_used);
+	}
+
+	return event;
+}
+
+int event_manager_mem_slab_stats_get(const struct event_type *et,
+				     struct event_mem_slab_stats *stats)
+{
+	__ASSERT_NO_MSG(stats);
+	ASSERT_EVENT_ID(et);
+
+	const struct event_mem_slab *mem_slab = et->mem_slab;
+
+	if (!mem_slab) {
+		return -ENOENT;
+	}
+
+	stats->used = k_mem_slab_num_used_get(mem_slab->slab);
+	stats->max_used = atomic_get(&mem_slab->max_used);
+	stats->total = mem_slab->slab->num_blocks;
+	stats->alloc_fail_cnt = atomic_get(&mem_slab->alloc_fail_cnt);
+
+	return 0;
 }
 
 void _event_submit(struct event_header *eh)
@@ -289,9 +941,34 @@ void _event_submit(struct event_header *eh)
 
 	trace_event_submission(eh);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
-	sys_slist_append(&eventq, &eh->node);
-	k_spin_unlock(&lock, key);
+#if CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+	eh->timestamp = k_cycle_get_32();
+#endif
+
+	size_t proc_class = event_proc_class_get(eh->type_id);
+
+	if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_LOCKLESS_QUEUE)) {
+		lockless_queue_push(&eventq_lockless[proc_class], &eh->node);
+	} else {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		if (event_merge(eh)) {
+			k_spin_unlock(&lock, key);
+			event_free(eh);
+			return;
+		}
+
+		sys_slist_append(&eventq[proc_class], &eh->node);
+		k_spin_unlock(&lock, key);
+	}
+
+#if CONFIG_DESKTOP_EVENT_MANAGER_HIGH_CLASS_WORKQ
+	if (proc_classes_ready && (proc_class == EVENT_PROC_CLASS_HIGH)) {
+		k_work_submit_to_queue(&event_high_workq,
+				       &event_processor_high);
+		return;
+	}
+#endif
 
 	k_work_submit(&event_processor);
 }
@@ -300,5 +977,21 @@ int event_manager_init(void)
 {
 	log_event_init();
 
+	int err = dispatch_table_init();
+
+	if (err) {
+		return err;
+	}
+
+	err = proc_classes_init();
+	if (err) {
+		return err;
+	}
+
+	err = merge_init();
+	if (err) {
+		return err;
+	}
+
 	return trace_event_init();
 }
@@ -70,11 +70,30 @@ extern "C" {
 	_EVENT_SUBSCRIBERS_EMPTY(ename, _SUBS_PRIO_ID(_SUBS_PRIO_FINAL))
 
 
+/* Execution time statistics of a subscriber. */
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS
+#define _EVENT_SUBSCRIBER_STATS(lname, ename) _CONCAT(_CONCAT(__event_subscriber_stats_, ename), lname)
+
+#define _EVENT_SUBSCRIBER_STATS_DEFINE(lname, ename)				\
+	static struct event_subscriber_stats _EVENT_SUBSCRIBER_STATS(lname, ename);
+
+#define _EVENT_SUBSCRIBER_STATS_INIT(lname, ename)				\
+	.stats = &_EVENT_SUBSCRIBER_STATS(lname, ename),
+
+#else
+#define _EVENT_SUBSCRIBER_STATS_DEFINE(lname, ename)
+#define _EVENT_SUBSCRIBER_STATS_INIT(lname, ename)
+
+#endif /* CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS */
+
+
 /* Subscribe a listener to an event. */
 #define _EVENT_SUBSCRIBE(lname, ename, prio)								\
+	_EVENT_SUBSCRIBER_STATS_DEFINE(lname, ename)							\
 	const struct event_subscriber _CONCAT(_CONCAT(__event_subscriber_, ename), lname) __used	\
 	__attribute__((__section__(_EVENT_SUBSCRIBERS_SECTION_NAME(ename, prio)))) = {			\
 		.listener = &_CONCAT(__event_listener_, lname),						\
+		_EVENT_SUBSCRIBER_STATS_INIT(lname, ename)						\
 	}
 
 
@@ -82,6 +101,28 @@ extern "C" {
 #define _EVENT_ID(ename) (&_CONCAT(__event_type_, ename))
 
 
+/* Memory slab used to allocate events of the given type. */
+#define _EVENT_MEM_SLAB(ename) _CONCAT(__event_mem_slab_, ename)
+
+#define _EVENT_K_MEM_SLAB(ename) _CONCAT(__event_k_mem_slab_, ename)
+
+
+/* Additional level of indirection ensures that the slab name is expanded
+ * before it is concatenated by the kernel macro.
+ */
+#define _EVENT_K_MEM_SLAB_DEFINE(name, block_size, block_cnt, align)	\
+	K_MEM_SLAB_DEFINE(name, block_size, block_cnt, align)
+
+
+#define _EVENT_MEM_SLAB_DEFINE(ename, slab_cnt)					\
+	_EVENT_K_MEM_SLAB_DEFINE(_EVENT_K_MEM_SLAB(ename),			\
+				 sizeof(struct ename), slab_cnt,		\
+				 __alignof__(struct ename));			\
+	struct event_mem_slab _EVENT_MEM_SLAB(ename) = {			\
+		.slab = &_EVENT_K_MEM_SLAB(ename),				\
+	}
+
+
 /* Macro generates a function of name new_ename where ename is provided as
  * an argument. Allocator function is used to create an event of the given
  * ename type.
@@ -130,6 +171,29 @@ extern "C" {
 	}
 
 
+/* Macro generates a function of name new_ename where ename is provided as
+ * an argument. Allocator function is used to create an event of the given
+ * ename type from the memory slab dedicated to this event type.
+ */
+#define _EVENT_ALLOCATOR_SLAB_FN(ename)					\
+	static inline struct ename *_CONCAT(new_, ename)(void)		\
+	{								\
+		struct ename *event =					\
+			_event_mem_slab_alloc(&_EVENT_MEM_SLAB(ename));	\
+		BUILD_ASSERT(offsetof(struct ename, header) == 0,	\
+				 "");					\
+		if (unlikely(!event)) {					\
+			printk("Event Manager OOM error\n");		\
+			LOG_PANIC();					\
+			__ASSERT_NO_MSG(false);				\
+			sys_reboot(SYS_REBOOT_WARM);			\
+			return NULL;					\
+		}							\
+		event->header.type_id = _EVENT_ID(ename);		\
+		return event;						\
+	}
+
+
 /* Macro generates a function of name cast_ename where ename is provided as
  * an argument. Casting function is used to convert event_header pointer
  * into pointer to event matching the given ename type.
@@ -196,6 +260,22 @@ extern "C" {
 			}
 
 
+#define _EVENT_PROC_CLASS_SET(ename, cls)						\
+	const struct event_proc_class_entry _CONCAT(__event_proc_class_, ename) __used	\
+	__attribute__((__section__("event_proc_classes"))) = {				\
+		.type = _EVENT_ID(ename),						\
+		.proc_class = cls,							\
+	}
+
+
+#define _EVENT_MERGE_FN_SET(ename, merge_fn)						\
+	const struct event_merge_fn_entry _CONCAT(__event_merge_fn_, ename) __used	\
+	__attribute__((__section__("event_merge_fns"))) = {				\
+		.type = _EVENT_ID(ename),						\
+		.merge = merge_fn,							\
+	}
+
+
 #define _EVENT_LISTENER(lname, notification_fn)					\
 	const struct event_listener _CONCAT(__event_listener_, lname) __used	\
 	__attribute__((__section__("event_listeners"))) = {			\
@@ -221,7 +301,13 @@ extern "C" {
 	_EVENT_ALLOCATOR_DYNDATA_FN(ename)
 
 
-#define _EVENT_TYPE_DEFINE(ename, init_log_en, log_fn, ev_info_struct)							\
+#define _EVENT_TYPE_SLAB_DECLARE(ename)					\
+	extern struct event_mem_slab _EVENT_MEM_SLAB(ename);		\
+	_EVENT_TYPE_DECLARE_COMMON(ename);				\
+	_EVENT_ALLOCATOR_SLAB_FN(ename)
+
+
+#define _EVENT_TYPE_DEFINE_COMMON(ename, init_log_en, log_fn, ev_info_struct, mem_slab_ptr)				\
 	_EVENT_SUBSCRIBERS_DEFINE(ename);										\
 	const struct event_type _CONCAT(__event_type_, ename) __used							\
 	__attribute__((__section__("event_types"))) = {									\
@@ -239,9 +325,20 @@ extern "C" {
 		.init_log_enable		= init_log_en,								\
 		.log_event			= log_fn,								\
 		.ev_info			= ev_info_struct,							\
+		.mem_slab			= mem_slab_ptr,								\
 	}
 
 
+#define _EVENT_TYPE_DEFINE(ename, init_log_en, log_fn, ev_info_struct)			\
+	_EVENT_TYPE_DEFINE_COMMON(ename, init_log_en, log_fn, ev_info_struct, NULL)
+
+
+#define _EVENT_TYPE_SLAB_DEFINE(ename, init_log_en, log_fn, ev_info_struct, slab_cnt)	\
+	_EVENT_MEM_SLAB_DEFINE(ename, slab_cnt);					\
+	_EVENT_TYPE_DEFINE_COMMON(ename, init_log_en, log_fn, ev_info_struct,		\
+				  &_EVENT_MEM_SLAB(ename))
+
+
 #ifdef __cplusplus
 }
 #endif
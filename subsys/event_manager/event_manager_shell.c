@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <shell/shell.h>
 #include <event_manager.h>
 
@@ -89,6 +90,138 @@ static int show_subscribers(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+static int show_mem_slabs(const struct shell *shell, size_t argc,
+			  char **argv)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "Event memory slabs:\n");
+	for (const struct event_type *et = __start_event_types;
+	     (et != NULL) && (et != __stop_event_types);
+	     et++) {
+
+		struct event_mem_slab_stats stats;
+
+		if (event_manager_mem_slab_stats_get(et, &stats)) {
+			continue;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[E:%s] used:%u max_used:%u total:%u "
+			      "alloc_fail:%u\n",
+			      et->name, stats.used, stats.max_used,
+			      stats.total, stats.alloc_fail_cnt);
+	}
+
+	return 0;
+}
+
+static int listener_stats(const struct shell *shell, bool reset)
+{
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS
+	if (reset) {
+		event_manager_listener_stats_reset();
+		return 0;
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL,
+		      "Listener execution time [cycles]:\n");
+
+	for (const struct event_type *et = __start_event_types;
+	     (et != NULL) && (et != __stop_event_types);
+	     et++) {
+		for (size_t prio = SUBS_PRIO_MIN;
+		     prio <= SUBS_PRIO_MAX;
+		     prio++) {
+			for (const struct event_subscriber *es =
+					et->subs_start[prio];
+			     es != et->subs_stop[prio];
+			     es++) {
+
+				__ASSERT_NO_MSG(es != NULL);
+				struct event_subscriber_stats stats;
+
+				event_manager_listener_stats_get(es, &stats);
+
+				if (stats.call_cnt == 0) {
+					continue;
+				}
+
+				shell_fprintf(shell, SHELL_NORMAL,
+					      "|\t[E:%s] -> [L:%s] cnt:%u "
+					      "min:%u avg:%u max:%u\n",
+					      et->name, es->listener->name,
+					      stats.call_cnt,
+					      stats.min_cycles,
+					      (u32_t)(stats.total_cycles /
+						      stats.call_cnt),
+					      stats.max_cycles);
+			}
+		}
+	}
+#else
+	shell_error(shell, "Listener statistics are disabled");
+#endif
+
+	return 0;
+}
+
+static int show_listener_stats(const struct shell *shell, size_t argc,
+			       char **argv)
+{
+	return listener_stats(shell, false);
+}
+
+static int reset_listener_stats(const struct shell *shell, size_t argc,
+				char **argv)
+{
+	return listener_stats(shell, true);
+}
+
+static int show_latency(const struct shell *shell, size_t argc,
+			char **argv)
+{
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+	static const char * const class_names[] = {
+		[EVENT_PROC_CLASS_HIGH]   = "high",
+		[EVENT_PROC_CLASS_NORMAL] = "normal",
+		[EVENT_PROC_CLASS_LOW]    = "low",
+	};
+	size_t class_cnt =
+		IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_PROC_CLASSES) ?
+		EVENT_PROC_CLASS_COUNT : 1;
+
+	shell_fprintf(shell, SHELL_NORMAL, "Event processing latency:\n");
+	for (size_t c = 0; c < class_cnt; c++) {
+		const u32_t *hist = event_manager_latency_hist_get(c);
+
+		shell_fprintf(shell, SHELL_NORMAL, "Class %s:\n",
+			      (class_cnt > 1) ? class_names[c] : "all");
+
+		for (size_t b = 0; b < EVENT_MANAGER_LATENCY_HIST_BUCKET_CNT;
+		     b++) {
+			u32_t cnt = hist[b];
+
+			if (!cnt) {
+				continue;
+			}
+
+			if (b < EVENT_MANAGER_LATENCY_HIST_BUCKET_CNT - 1) {
+				shell_fprintf(shell, SHELL_NORMAL,
+					      "|\t< %u us:\t%u\n",
+					      BIT(b), cnt);
+			} else {
+				shell_fprintf(shell, SHELL_NORMAL,
+					      "|\t>= %u us:\t%u\n",
+					      BIT(b - 1), cnt);
+			}
+		}
+	}
+#else
+	shell_error(shell, "Latency histogram is disabled");
+#endif
+
+	return 0;
+}
+
 static void set_event_displaying(const struct shell *shell, size_t argc,
 				 char **argv, bool enable)
 {
@@ -168,6 +301,17 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_event_manager,
 	SHELL_CMD_ARG(show_subscribers, NULL, "Show subscribers",
 		      show_subscribers, 0, 0),
 	SHELL_CMD_ARG(show_events, NULL, "Show events", show_events, 0, 0),
+	SHELL_CMD_ARG(show_mem_slabs, NULL, "Show event memory slabs",
+		      show_mem_slabs, 0, 0),
+	SHELL_CMD_ARG(show_listener_stats, NULL,
+		      "Show listener execution time statistics",
+		      show_listener_stats, 0, 0),
+	SHELL_CMD_ARG(reset_listener_stats, NULL,
+		      "Reset listener execution time statistics",
+		      reset_listener_stats, 0, 0),
+	SHELL_CMD_ARG(show_latency, NULL,
+		      "Show event processing latency histogram",
+		      show_latency, 0, 0),
 	SHELL_CMD_ARG(disable, NULL, "Disable displaying event with given ID",
 		      disable_event_displaying, 0,
 		      sizeof(event_manager_displayed_events) * 8 - 1),
@@ -23,6 +23,14 @@ LOG_MODULE_REGISTER(download_client, CONFIG_DOWNLOAD_CLIENT_LOG_LEVEL);
 	"Range: bytes=%u-%u\r\n"                                               \
 	"\r\n"
 
+/* Open-ended range, the server sends the rest of the file. */
+#define GET_TEMPLATE_STREAM                                                    \
+	"GET /%s HTTP/1.1\r\n"                                                 \
+	"Host: %s\r\n"                                                         \
+	"Connection: keep-alive\r\n"                                           \
+	"Range: bytes=%u-\r\n"                                                 \
+	"\r\n"
+
 BUILD_ASSERT(CONFIG_DOWNLOAD_CLIENT_MAX_FRAGMENT_SIZE <=
 		 CONFIG_DOWNLOAD_CLIENT_MAX_RESPONSE_SIZE,
 		 "The response buffer must accommodate for a full non-TLS fragment");
@@ -37,6 +45,62 @@ BUILD_ASSERT(CONFIG_LOG_BUFFER_SIZE >= 2048,
 		 "Please increase log buffer sizer");
 #endif
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_PIPELINE)
+#define PIPELINE_BUF_CNT CONFIG_DOWNLOAD_CLIENT_PIPELINE_BUF_CNT
+#endif
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+/* Additional connections, shared by all client instances. */
+static struct download_client workers[
+	CONFIG_DOWNLOAD_CLIENT_PARALLEL_CONN_CNT - 1];
+static atomic_t workers_busy;
+static bool workers_initialized;
+#endif
+
+/* Buffer the response is being received into.
+ * The HTTP header is received in the buffer of the client, also when
+ * a buffer is lent, so that the body starts at the lent buffer start.
+ */
+static char *rx_buf(struct download_client *client)
+{
+	if (client->app_buf && client->has_header) {
+		return client->app_buf;
+	}
+#if defined(CONFIG_DOWNLOAD_CLIENT_PIPELINE)
+	if (client->rx_idx != 0) {
+		return client->pipeline_buf[client->rx_idx - 1];
+	}
+#endif
+	return client->buf;
+}
+
+static size_t rx_buf_size(const struct download_client *client)
+{
+	if (client->app_buf && client->has_header) {
+		return client->app_buf_size;
+	}
+
+	return CONFIG_DOWNLOAD_CLIENT_MAX_RESPONSE_SIZE;
+}
+
+/* Size of a response body which is received as a single fragment,
+ * based on the header size of the previous response.
+ */
+static size_t body_room(const struct download_client *client)
+{
+	const size_t size = CONFIG_DOWNLOAD_CLIENT_MAX_RESPONSE_SIZE;
+
+	if (client->app_buf) {
+		return MIN(client->fragment_size, client->app_buf_size);
+	}
+
+	if (client->header_len >= size) {
+		return client->fragment_size;
+	}
+
+	return MIN(client->fragment_size, size - client->header_len);
+}
+
 static int socket_timeout_set(int fd)
 {
 	int err;
@@ -225,13 +289,14 @@ cleanup:
 	return fd;
 }
 
-static int socket_send(const struct download_client *client, size_t len)
+static int socket_send(const struct download_client *client, const char *buf,
+		       size_t len)
 {
 	int sent;
 	size_t off = 0;
 
 	while (len) {
-		sent = send(client->fd, client->buf + off, len, 0);
+		sent = send(client->fd, buf + off, len, 0);
 		if (sent <= 0) {
 			return -EIO;
 		}
@@ -243,39 +308,72 @@ static int socket_send(const struct download_client *client, size_t len)
 	return 0;
 }
 
+/* Whether the rest of the range of this connection
+ * is requested at once, instead of one fragment at a time.
+ */
+static bool whole_range_request(const struct download_client *client)
+{
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+	/* The first fragment is requested alone, the file is split
+	 * in ranges once it is received.
+	 */
+	return (client->parent != NULL) || client->split;
+#else
+	return IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_STREAM);
+#endif
+}
+
 static int get_request_send(struct download_client *client)
 {
 	int err;
 	int len;
 	size_t off;
+	char *buf = rx_buf(client);
+	const size_t size = rx_buf_size(client);
 
 	__ASSERT_NO_MSG(client);
 	__ASSERT_NO_MSG(client->host);
 	__ASSERT_NO_MSG(client->file);
 
-	/* Offset of last byte in range (Content-Range) */
-	off = client->progress + client->fragment_size - 1;
+	if (whole_range_request(client) && (client->end == 0)) {
+		/* The response ends with the file. */
+		client->range_end = SIZE_MAX;
 
-	if (client->file_size != 0) {
-		/* Don't request bytes past the end of file */
-		off = MIN(off, client->file_size);
-	}
+		len = snprintf(buf, size, GET_TEMPLATE_STREAM, client->file,
+			       client->host, client->progress);
+	} else {
+		if (whole_range_request(client)) {
+			off = client->end - 1;
+		} else {
+			/* Offset of last byte in range (Content-Range).
+			 * The range is trimmed, so that the body is
+			 * received in the buffer along with the header.
+			 */
+			off = client->progress + body_room(client) - 1;
+		}
+
+		if (client->end != 0) {
+			/* Don't request bytes past the end of range */
+			off = MIN(off, client->end - 1);
+		}
+
+		client->range_end = off + 1;
 
-	len = snprintf(client->buf, CONFIG_DOWNLOAD_CLIENT_MAX_RESPONSE_SIZE,
-		       GET_TEMPLATE, client->file, client->host,
-		       client->progress, off);
+		len = snprintf(buf, size, GET_TEMPLATE, client->file,
+			       client->host, client->progress, off);
+	}
 
-	if (len < 0 || len > CONFIG_DOWNLOAD_CLIENT_MAX_RESPONSE_SIZE) {
+	if (len < 0 || len > size) {
 		LOG_ERR("Cannot create GET request, buffer too small");
 		return -ENOMEM;
 	}
 
 	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_LOG_HEADERS)) {
-		LOG_HEXDUMP_DBG(client->buf, len, "HTTP request");
+		LOG_HEXDUMP_DBG(buf, len, "HTTP request");
 	}
 
 	LOG_DBG("Sending HTTP request");
-	err = socket_send(client, len);
+	err = socket_send(client, buf, len);
 	if (err) {
 		LOG_ERR("Failed to send HTTP request, errno %d", errno);
 		return err;
@@ -284,37 +382,56 @@ static int get_request_send(struct download_client *client)
 	return 0;
 }
 
-/* Returns:
+/* Scan the bytes received from offset @p from for the end of the HTTP
+ * header. The header is scanned once, as it is received, and the payload
+ * following it is left in place in the buffer.
+ *
+ * Returns:
  *  1 while the header is being received
  *  0 if the header has been fully received
  * -1 on error
  */
-static int header_parse(struct download_client *client)
+static int header_parse(struct download_client *client, size_t from)
 {
+	static const char hdr_end[] = "\r\n\r\n";
 	char *p;
+	char c;
 	size_t hdr;
+	char *buf = rx_buf(client);
 
-	p = strstr(client->buf, "\r\n\r\n");
-	if (!p) {
-		/* Awaiting full GET response */
-		LOG_DBG("Awaiting full header in response");
-		return 1;
+	while (client->hdr_match < sizeof(hdr_end) - 1) {
+		if (from == client->offset) {
+			/* Awaiting full GET response */
+			LOG_DBG("Awaiting full header in response");
+			return 1;
+		}
+
+		c = buf[from++];
+		if (c == hdr_end[client->hdr_match]) {
+			client->hdr_match++;
+		} else {
+			client->hdr_match = (c == '\r') ? 1 : 0;
+		}
 	}
 
 	/* Offset of the end of the HTTP header in the buffer */
-	hdr = p + strlen("\r\n\r\n") - client->buf;
-
-	__ASSERT(hdr < sizeof(client->buf), "Buffer overflow");
+	hdr = from;
+	client->header_len = hdr;
 
 	LOG_DBG("GET header size: %u", hdr);
 
 	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_LOG_HEADERS)) {
-		LOG_HEXDUMP_DBG(client->buf, hdr, "GET");
+		LOG_HEXDUMP_DBG(buf, hdr, "GET");
 	}
 
+	/* Terminate the header, so that it can be searched as a string.
+	 * The last character is the final '\n', which is not needed.
+	 */
+	buf[hdr - 1] = '\0';
+
 	/* If file size is not known, read it from the header */
 	if (client->file_size == 0) {
-		p = strstr(client->buf, "Content-Range: bytes");
+		p = strstr(buf, "Content-Range: bytes");
 		if (!p) {
 			/* Cannot continue */
 			LOG_ERR("Server did not send "
@@ -333,51 +450,367 @@ static int header_parse(struct download_client *client)
 		LOG_DBG("File size = %d", client->file_size);
 	}
 
-	p = strstr(client->buf, "Connection: close");
+	if (client->end == 0) {
+		client->end = client->file_size;
+	}
+
+	client->range_end = MIN(client->range_end, client->end);
+
+	p = strstr(buf, "Connection: close");
 	if (p) {
 		LOG_WRN("Peer closed connection, will attempt to re-connect");
 		client->connection_close = true;
 	}
 
-	if (client->offset != hdr) {
-		/* The current buffer contains some payload bytes.
-		 * Copy them at the beginning of the buffer
-		 * then update the offset.
-		 */
-		LOG_WRN("Copying %u payload bytes", client->offset - hdr);
-		memcpy(client->buf, client->buf + hdr, client->offset - hdr);
+	/* The payload received with the header, if any, follows it. */
+	client->body_offset = hdr;
 
-		client->offset -= hdr;
-	} else {
-		/* Reset the offset.
-		 * The payload is received in an empty buffer.
-		 */
-		client->offset = 0;
+	return 0;
+}
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+static struct download_client *parent_get(struct download_client *dl)
+{
+	return dl->parent ? dl->parent : dl;
+}
+
+/* Whether the download this connection takes part in has been stopped,
+ * or restarted without it. Called with the parent locked.
+ */
+static bool parallel_stopped(struct download_client *dl)
+{
+	struct download_client *const parent = parent_get(dl);
+
+	if (atomic_get(&parent->stopped)) {
+		return true;
 	}
 
-	return 0;
+	if (dl == parent) {
+		return false;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(parent->conn); i++) {
+		if (parent->conn[i] == dl) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Let connections waiting for their turn check again. */
+static void parallel_wake(struct download_client *parent)
+{
+	k_sem_give(&parent->turn);
+
+	for (size_t i = 0; i < ARRAY_SIZE(parent->conn); i++) {
+		if (parent->conn[i] != NULL) {
+			k_sem_give(&parent->conn[i]->turn);
+		}
+	}
+}
+
+/* Send an event to the application of the parent, which is locked. */
+static int parallel_callback(struct download_client *dl,
+			     const struct download_client_evt *evt)
+{
+	int rc;
+	struct download_client *const parent = parent_get(dl);
+
+	if (parallel_stopped(dl)) {
+		return 1;
+	}
+
+	rc = parent->callback(evt);
+	if (rc) {
+		atomic_set(&parent->stopped, true);
+		parallel_wake(parent);
+	}
+
+	return rc;
+}
+
+static int parallel_evt_send(struct download_client *dl,
+			     const struct download_client_evt *evt)
+{
+	int rc;
+	struct download_client *const parent = parent_get(dl);
+
+	k_mutex_lock(&parent->lock, K_FOREVER);
+	rc = parallel_callback(dl, evt);
+	k_mutex_unlock(&parent->lock);
+
+	return rc;
+}
+
+static int parallel_fragment_send(struct download_client *dl,
+				  const struct download_client_evt *evt)
+{
+	int rc;
+	struct download_client *const parent = parent_get(dl);
+
+	k_mutex_lock(&parent->lock, K_FOREVER);
+
+	/* Unless the application accepts any order,
+	 * wait until all preceding fragments are delivered.
+	 */
+	while (!parent->config.out_of_order &&
+	       (evt->fragment.offset != parent->deliver_offset) &&
+	       !parallel_stopped(dl)) {
+		k_mutex_unlock(&parent->lock);
+		k_sem_take(&dl->turn, K_FOREVER);
+		k_mutex_lock(&parent->lock, K_FOREVER);
+	}
+
+	rc = parallel_callback(dl, evt);
+	if (!rc) {
+		parent->deliver_offset += evt->fragment.len;
+		parallel_wake(parent);
+	}
+
+	k_mutex_unlock(&parent->lock);
+
+	return rc;
 }
 
-static int fragment_evt_send(const struct download_client *client)
+/* Split the rest of the file in ranges, downloaded over
+ * the additional connections that are available.
+ */
+static void parallel_split(struct download_client *dl)
 {
-	__ASSERT(client->offset <= client->fragment_size,
+	size_t i;
+	size_t cnt = 0;
+	size_t start;
+	size_t slice;
+	struct download_client *conn[ARRAY_SIZE(workers)];
+	const size_t left = dl->end - dl->progress;
+
+	dl->split = true;
+
+	/* Each connection downloads one fragment at least. */
+	for (i = 0; (i < ARRAY_SIZE(workers)) &&
+		    ((cnt + 2) * dl->fragment_size <= left); i++) {
+		if (!atomic_test_and_set_bit(&workers_busy, i)) {
+			conn[cnt++] = &workers[i];
+		}
+	}
+
+	if (cnt == 0) {
+		LOG_DBG("Downloading over a single connection");
+		return;
+	}
+
+	/* Ranges are a multiple of the fragment size, so that fragments
+	 * are aligned in the file the same way for all connections.
+	 */
+	slice = ROUND_UP(ceiling_fraction(left, cnt + 1), dl->fragment_size);
+
+	k_mutex_lock(&dl->lock, K_FOREVER);
+
+	dl->end = dl->progress + slice;
+	start = dl->end;
+
+	for (i = 0; i < cnt; i++) {
+		struct download_client *const w = conn[i];
+
+		if (start >= dl->file_size) {
+			/* Rounding left nothing to download. */
+			atomic_clear_bit(&workers_busy, w - workers);
+			continue;
+		}
+
+		w->parent = dl;
+		w->host = dl->host;
+		w->file = dl->file;
+		w->config = dl->config;
+		w->file_size = dl->file_size;
+		w->progress = start;
+		w->end = MIN(start + slice, dl->file_size);
+		w->offset = 0;
+		w->body_offset = 0;
+		w->hdr_match = 0;
+		w->has_header = false;
+		w->connection_close = false;
+		k_sem_reset(&w->turn);
+
+		LOG_INF("Downloading range %u-%u over connection %u",
+			w->progress, w->end - 1, i + 1);
+
+		dl->conn[i] = w;
+		dl->active++;
+		start = w->end;
+
+		k_thread_resume(w->tid);
+	}
+
+	k_mutex_unlock(&dl->lock);
+}
+
+/* Connect an additional connection and request its range. */
+static int worker_connect(struct download_client *dl)
+{
+	int err;
+	const struct download_client_evt evt = {
+		.id = DOWNLOAD_CLIENT_EVT_ERROR,
+		.error = -ENOTCONN,
+	};
+
+	while (true) {
+		err = download_client_connect(dl, dl->host, &dl->config);
+		if (!err) {
+			err = get_request_send(dl);
+		}
+		if (!err) {
+			return 0;
+		}
+
+		if (dl->fd != -1) {
+			(void)download_client_disconnect(dl);
+		}
+
+		if (parallel_evt_send(dl, &evt)) {
+			return err;
+		}
+	}
+}
+
+static void worker_release(struct download_client *dl)
+{
+	if (dl->fd != -1) {
+		(void)download_client_disconnect(dl);
+	}
+
+	atomic_clear_bit(&workers_busy, dl - workers);
+}
+
+/* The range of a connection is complete. When all are,
+ * the download is complete.
+ */
+static void parallel_range_done(struct download_client *dl)
+{
+	struct download_client *const parent = parent_get(dl);
+	const struct download_client_evt evt = {
+		.id = DOWNLOAD_CLIENT_EVT_DONE,
+	};
+
+	k_mutex_lock(&parent->lock, K_FOREVER);
+
+	if (!parallel_stopped(dl)) {
+		parent->active--;
+		if (parent->active == 0) {
+			LOG_INF("Download complete");
+			(void)parallel_callback(dl, &evt);
+		}
+	}
+
+	k_mutex_unlock(&parent->lock);
+}
+#endif
+
+static int fragment_evt_send(struct download_client *client)
+{
+	/* In stream mode, payload received with the header
+	 * may exceed the fragment size.
+	 */
+	__ASSERT(whole_range_request(client) ||
+		 (client->offset - client->body_offset <=
+		  client->fragment_size),
 		 "Fragment overflow!");
 
-	__ASSERT(client->offset <= CONFIG_DOWNLOAD_CLIENT_MAX_RESPONSE_SIZE,
-		 "Buffer overflow!");
+	__ASSERT(client->offset <= rx_buf_size(client), "Buffer overflow!");
 
+	/* The fragment is delivered where it was received. */
 	const struct download_client_evt evt = {
 		.id = DOWNLOAD_CLIENT_EVT_FRAGMENT,
 		.fragment = {
-			.buf = client->buf,
-			.len = client->offset,
+			.buf = rx_buf(client) + client->body_offset,
+			.len = client->offset - client->body_offset,
+			.offset = client->progress -
+				  (client->offset - client->body_offset),
 		}
 	};
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_PIPELINE)
+	/* Hand the buffer over to the delivery thread and continue
+	 * in the next one, once the application has released it.
+	 */
+	k_msgq_put(&client->fragment_q, &evt.fragment, K_FOREVER);
+	k_sem_take(&client->free_bufs, K_FOREVER);
+	client->rx_idx = (client->rx_idx + 1) % PIPELINE_BUF_CNT;
+
+	return atomic_get(&client->stopped);
+#elif defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+	return parallel_fragment_send(client, &evt);
+#else
 	return client->callback(&evt);
+#endif
+}
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_PIPELINE)
+static void pipeline_thread(void *client, void *a, void *b)
+{
+	int rc;
+	struct download_client *const dl = client;
+	struct download_client_evt evt = {
+		.id = DOWNLOAD_CLIENT_EVT_FRAGMENT,
+	};
+
+	while (true) {
+		k_msgq_get(&dl->fragment_q, &evt.fragment, K_FOREVER);
+
+		/* Fragments queued after a refused one are discarded. */
+		if (!atomic_get(&dl->stopped)) {
+			rc = dl->callback(&evt);
+			if (rc) {
+				LOG_INF("Fragment refused, download stopped.");
+				atomic_set(&dl->stopped, true);
+			}
+		}
+
+		k_sem_give(&dl->free_bufs);
+	}
+}
+
+/* Wait until all queued fragments are processed by the application. */
+static void pipeline_drain(struct download_client *dl)
+{
+	if (k_current_get() == &dl->pipeline_thread) {
+		/* Called from the application callback. */
+		return;
+	}
+
+	for (size_t i = 0; i < PIPELINE_BUF_CNT - 1; i++) {
+		k_sem_take(&dl->free_bufs, K_FOREVER);
+	}
+	for (size_t i = 0; i < PIPELINE_BUF_CNT - 1; i++) {
+		k_sem_give(&dl->free_bufs);
+	}
+}
+#endif
+
+/* Send an event other than a fragment. Fragments received before
+ * are delivered to the application first.
+ *
+ * Returns non-zero if the download is to be stopped.
+ */
+static int sync_evt_send(struct download_client *dl,
+			 const struct download_client_evt *evt)
+{
+#if defined(CONFIG_DOWNLOAD_CLIENT_PIPELINE)
+	pipeline_drain(dl);
+
+	if (atomic_get(&dl->stopped)) {
+		/* The application has refused a fragment. */
+		return 1;
+	}
+#elif defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+	return parallel_evt_send(dl, evt);
+#endif
+
+	return dl->callback(evt);
 }
 
-static int error_evt_send(const struct download_client *dl, int error)
+static int error_evt_send(struct download_client *dl, int error)
 {
 	/* Error will be sent as negative. */
 	__ASSERT_NO_MSG(error > 0);
@@ -387,7 +820,7 @@ static int error_evt_send(const struct download_client *dl, int error)
 		.error = -error
 	};
 
-	return dl->callback(&evt);
+	return sync_evt_send(dl, &evt);
 }
 
 static int reconnect(struct download_client *dl)
@@ -417,14 +850,40 @@ void download_thread(void *client, void *a, void *b)
 restart_and_suspend:
 	k_thread_suspend(dl->tid);
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+	/* Additional connections connect in their own thread. */
+	if ((dl->parent != NULL) && worker_connect(dl)) {
+		worker_release(dl);
+		goto restart_and_suspend;
+	}
+#endif
+
 	while (true) {
-		__ASSERT(dl->offset < sizeof(dl->buf), "Buffer overflow");
+		char *const buf = rx_buf(dl);
+		const size_t size = rx_buf_size(dl);
+		const size_t prev_offset = dl->offset;
+		size_t room = size - dl->offset;
+
+		__ASSERT(dl->offset < size, "Buffer overflow");
+
+		if (dl->has_header) {
+			/* Receive up to the end of the fragment, without
+			 * reading past the body of the current response.
+			 */
+			room = MIN(room, dl->fragment_size -
+					 (dl->offset - dl->body_offset));
+			room = MIN(room, dl->range_end - dl->progress);
+		} else if (dl->app_buf) {
+			/* The payload received with the header must fit
+			 * in the lent buffer.
+			 */
+			room = MIN(room, dl->app_buf_size);
+		}
 
 		LOG_DBG("Receiving up to %d bytes at %p...",
-			(sizeof(dl->buf) - dl->offset), (dl->buf + dl->offset));
+			room, (buf + dl->offset));
 
-		len = recv(dl->fd, dl->buf + dl->offset,
-			   sizeof(dl->buf) - dl->offset, 0);
+		len = recv(dl->fd, buf + dl->offset, room, 0);
 
 		if ((len == 0) || (len == -1)) {
 			/* We just had an unexpected socket error or closure */
@@ -433,7 +892,7 @@ restart_and_suspend:
 			 * and it has been accounted in our progress, we have
 			 * to hand it to the application before discarding it.
 			 */
-			if ((dl->offset > 0) && (dl->has_header)) {
+			if ((dl->offset > dl->body_offset) && (dl->has_header)) {
 				rc = fragment_evt_send(dl);
 				if (rc) {
 					/* Restart and suspend */
@@ -467,7 +926,11 @@ restart_and_suspend:
 		dl->offset += len;
 
 		if (!dl->has_header) {
-			rc = header_parse(dl);
+			rc = header_parse(dl, prev_offset);
+			if ((rc > 0) && (dl->offset == size)) {
+				LOG_ERR("HTTP header does not fit in buffer");
+				rc = -1;
+			}
 			if (rc > 0) {
 				/* Wait for payload */
 				continue;
@@ -485,20 +948,27 @@ restart_and_suspend:
 
 		/* Accumulate overall file progress.
 		 *
-		 * If the last recv() call read an HTTP header,
-		 * the offset has been moved to the end of the header in
-		 * header_parse(). Thus, we accumulate the offset
-		 * to the progress.
-		 *
-		 * If the last recv() call received only a HTTP message body,
-		 * then we accumulate 'len'.
-		 *
+		 * If the last recv() call completed the HTTP header,
+		 * only the payload bytes after the header are accounted.
 		 */
-		dl->progress += MIN(dl->offset, len);
+		dl->progress += dl->offset - MAX(prev_offset, dl->body_offset);
 
-		/* Have we received a whole fragment or the whole file? */
-		if ((dl->offset < dl->fragment_size) &&
-		    (dl->progress != dl->file_size)) {
+		if (buf != rx_buf(dl)) {
+			/* The header was received in the buffer of the
+			 * client, move the payload to the lent buffer.
+			 */
+			memcpy(rx_buf(dl), buf + dl->body_offset,
+			       dl->offset - dl->body_offset);
+			dl->offset -= dl->body_offset;
+			dl->body_offset = 0;
+		}
+
+		/* Have we received a whole fragment, filled the buffer
+		 * or received the whole response?
+		 */
+		if ((dl->offset - dl->body_offset < dl->fragment_size) &&
+		    (dl->offset < rx_buf_size(dl)) &&
+		    (dl->progress != dl->range_end)) {
 			LOG_DBG("Awaiting full fragment (%u)", dl->offset);
 			continue;
 		}
@@ -516,16 +986,38 @@ restart_and_suspend:
 			break;
 		}
 
-		if (dl->progress == dl->file_size) {
+		if (dl->progress == dl->end) {
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+			parallel_range_done(dl);
+#else
 			LOG_INF("Download complete");
 			const struct download_client_evt evt = {
 				.id = DOWNLOAD_CLIENT_EVT_DONE,
 			};
-			dl->callback(&evt);
+			sync_evt_send(dl, &evt);
+#endif
 			/* Restart and suspend */
 			break;
 		}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+		if ((dl->parent == NULL) && !dl->split) {
+			parallel_split(dl);
+		}
+#endif
+
+		if (dl->progress != dl->range_end) {
+			/* Keep receiving the body of the same response
+			 * in an empty buffer. In stream mode, this is the
+			 * case until the end of file. If the server closes
+			 * the connection before, the download is resumed
+			 * from the current progress.
+			 */
+			dl->offset = 0;
+			dl->body_offset = 0;
+			continue;
+		}
+
 		/* Attempt to reconnect if the connection was closed */
 		if (dl->connection_close) {
 			dl->connection_close = false;
@@ -536,6 +1028,8 @@ restart_and_suspend:
 		/* Send a GET request for the next bytes */
 send_again:
 		dl->offset = 0;
+		dl->body_offset = 0;
+		dl->hdr_match = 0;
 		dl->has_header = false;
 
 		rc = get_request_send(dl);
@@ -550,6 +1044,12 @@ send_again:
 		}
 	}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+	if (dl->parent != NULL) {
+		worker_release(dl);
+	}
+#endif
+
 	/* Do not let the thread return, since it can't be restarted */
 	goto restart_and_suspend;
 }
@@ -573,6 +1073,42 @@ int download_client_init(struct download_client *const client,
 				download_thread, client, NULL, NULL,
 				K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_PIPELINE)
+	client->rx_idx = 0;
+	atomic_set(&client->stopped, false);
+	k_msgq_init(&client->fragment_q, (char *)client->fragment_q_buf,
+		    sizeof(client->fragment_q_buf[0]),
+		    ARRAY_SIZE(client->fragment_q_buf));
+	k_sem_init(&client->free_bufs, PIPELINE_BUF_CNT - 1,
+		   PIPELINE_BUF_CNT - 1);
+
+	/* Same priority as the download thread, so that neither of them
+	 * starves the other.
+	 */
+	k_thread_create(&client->pipeline_thread,
+			client->pipeline_thread_stack,
+			K_THREAD_STACK_SIZEOF(client->pipeline_thread_stack),
+			pipeline_thread, client, NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+#endif
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+	atomic_set(&client->stopped, false);
+	k_mutex_init(&client->lock);
+	k_sem_init(&client->turn, 0, 1);
+
+	if (!workers_initialized) {
+		workers_initialized = true;
+
+		/* Events of additional connections are sent to
+		 * the callback of the client they download for.
+		 */
+		for (size_t i = 0; i < ARRAY_SIZE(workers); i++) {
+			download_client_init(&workers[i], callback);
+		}
+	}
+#endif
+
 	return 0;
 }
 
@@ -660,11 +1196,33 @@ int download_client_start(struct download_client *client, const char *file,
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_DOWNLOAD_CLIENT_PIPELINE)
+	/* Let fragments of a stopped download be discarded. */
+	pipeline_drain(client);
+	atomic_set(&client->stopped, false);
+#endif
+
+#if defined(CONFIG_DOWNLOAD_CLIENT_PARALLEL)
+	/* Connections of a stopped download, if still running,
+	 * stop as soon as they notice they are not part of this one.
+	 */
+	k_mutex_lock(&client->lock, K_FOREVER);
+	atomic_set(&client->stopped, false);
+	memset(client->conn, 0, sizeof(client->conn));
+	client->split = false;
+	client->active = 1;
+	client->deliver_offset = from;
+	k_mutex_unlock(&client->lock);
+#endif
+
 	client->file = file;
 	client->file_size = 0;
+	client->end = 0;
 	client->progress = from;
 
 	client->offset = 0;
+	client->body_offset = 0;
+	client->hdr_match = 0;
 	client->has_header = false;
 
 	LOG_INF("Downloading: %s [%u]", log_strdup(client->file),
@@ -681,6 +1239,25 @@ int download_client_start(struct download_client *client, const char *file,
 	return 0;
 }
 
+int download_client_buf_set(struct download_client *client, void *buf,
+			    size_t len)
+{
+	if (client == NULL || (buf != NULL && len == 0)) {
+		return -EINVAL;
+	}
+
+	if ((IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_PIPELINE) ||
+	     IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_PARALLEL)) && buf != NULL) {
+		/* Fragments are received in several buffers at once. */
+		return -ENOTSUP;
+	}
+
+	client->app_buf = buf;
+	client->app_buf_size = len;
+
+	return 0;
+}
+
 void download_client_pause(struct download_client *client)
 {
 	k_thread_suspend(client->tid);
@@ -57,6 +57,29 @@ static void dfu_target_callback_handler(enum dfu_target_evt_id evt)
 	}
 }
 
+/* With parallel downloads, fragments are written at their offset when the
+ * DFU target supports it, so that connections do not wait for each other.
+ * The first fragment is delivered before the file is split in ranges, so
+ * in-order delivery can still be requested for a target which does not.
+ */
+static int fragment_write(const struct download_fragment *fragment)
+{
+	int err;
+
+	if (dlc.config.out_of_order) {
+		err = dfu_target_write_at(fragment->offset, fragment->buf,
+					  fragment->len);
+		if (err != -ENOTSUP) {
+			return err;
+		}
+
+		LOG_INF("DFU target requires fragments in order");
+		dlc.config.out_of_order = false;
+	}
+
+	return dfu_target_write(fragment->buf, fragment->len);
+}
+
 static int download_client_callback(const struct download_client_evt *event)
 {
 	static bool first_fragment = true;
@@ -114,8 +137,7 @@ static int download_client_callback(const struct download_client_evt *event)
 			}
 		}
 
-		err = dfu_target_write(event->fragment.buf,
-				       event->fragment.len);
+		err = fragment_write(&event->fragment);
 		if (err != 0) {
 			LOG_ERR("dfu_target_write error %d", err);
 			(void) download_client_disconnect(&dlc);
@@ -219,6 +241,8 @@ int fota_download_start(const char *host, const char *file, int sec_tag,
 		.port = port,
 		.sec_tag = sec_tag,
 		.apn = apn,
+		.out_of_order = IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_PARALLEL) &&
+				IS_ENABLED(CONFIG_DFU_TARGET_MCUBOOT_WRITE_AT),
 	};
 
 	if (host == NULL || file == NULL || callback == NULL) {
@@ -27,6 +27,30 @@ int nrf_cloud_encode_sensor_data(const struct nrf_cloud_sensor_data *input,
 int nrf_cloud_encode_shadow_data(const struct nrf_cloud_sensor_data *sensor,
 				 struct nrf_cloud_data *output);
 
+/**@brief Encode the sensor data into a buffer, without heap allocations.
+ *
+ * The output is the same as that of @ref nrf_cloud_encode_sensor_data,
+ * and points to @p buf, which is null-terminated.
+ *
+ * @retval -ENOMEM if the message does not fit in @p buf.
+ */
+int nrf_cloud_encode_sensor_data_buf(const struct nrf_cloud_sensor_data *sensor,
+				     char *buf, size_t size,
+				     struct nrf_cloud_data *output);
+
+/**@brief Encode the sensor data to be sent to the device shadow into a
+ * buffer, without heap allocations.
+ *
+ * The output is the same as that of @ref nrf_cloud_encode_shadow_data,
+ * and points to @p buf, which is null-terminated. The cJSON object of the
+ * sensor data is freed, unless the message does not fit.
+ *
+ * @retval -ENOMEM if the message does not fit in @p buf.
+ */
+int nrf_cloud_encode_shadow_data_buf(const struct nrf_cloud_sensor_data *sensor,
+				     char *buf, size_t size,
+				     struct nrf_cloud_data *output);
+
 /**@brief Encode the user association data based on the indicated type. */
 int nrf_cloud_decode_requested_state(const struct nrf_cloud_data *payload,
 				     enum nfsm_state *requested_state);
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef NRF_CLOUD_JSON_H__
+#define NRF_CLOUD_JSON_H__
+
+#include <stddef.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum depth of nested objects and arrays in a document. */
+#define NRF_CLOUD_JSON_NESTING_LIMIT 16
+
+/** Maximum length of the keys that can be looked up. */
+#define NRF_CLOUD_JSON_KEY_LEN_MAX 31
+
+/**@brief Type of a JSON value. */
+enum nrf_cloud_json_type {
+	NRF_CLOUD_JSON_NONE,
+	NRF_CLOUD_JSON_OBJECT,
+	NRF_CLOUD_JSON_ARRAY,
+	NRF_CLOUD_JSON_STRING,
+	NRF_CLOUD_JSON_NUMBER,
+	NRF_CLOUD_JSON_BOOL,
+	NRF_CLOUD_JSON_NULL,
+};
+
+/**@brief A JSON value, as the text it spans in the document.
+ *
+ * Nothing is copied or allocated when a document is decoded. The values
+ * point into the document, which must be kept until they are no longer used.
+ * A value with a NULL pointer is not found, and has the type
+ * NRF_CLOUD_JSON_NONE.
+ */
+struct nrf_cloud_json_val {
+	const char *ptr;
+	size_t len;
+};
+
+/**@brief Validate a JSON document and get its root value.
+ *
+ * The document ends at @p len bytes or at the first null character. Any text
+ * after the root value is ignored.
+ *
+ * @param[in]  json  The document.
+ * @param[in]  len   Maximum length of the document.
+ * @param[out] root  The root value.
+ *
+ * @retval 0        The document is valid.
+ * @retval -EINVAL  The document is not valid JSON, or is nested too deep.
+ */
+int nrf_cloud_json_parse(const char *json, size_t len,
+			 struct nrf_cloud_json_val *root);
+
+/**@brief Get the type of a value. */
+enum nrf_cloud_json_type nrf_cloud_json_type_get(
+	const struct nrf_cloud_json_val *val);
+
+/**@brief Get the first member of an object with the given key.
+ *
+ * Keys are compared case-insensitively, like cJSON_GetObjectItem() does.
+ *
+ * @param[in]  obj  An object, from a validated document.
+ * @param[in]  key  The key, of at most NRF_CLOUD_JSON_KEY_LEN_MAX characters.
+ * @param[out] val  The value of the member. Not found if the member is not.
+ *
+ * @retval 0        The member was found.
+ * @retval -ENOENT  @p obj is not an object, or has no such member.
+ */
+int nrf_cloud_json_obj_get(const struct nrf_cloud_json_val *obj,
+			   const char *key, struct nrf_cloud_json_val *val);
+
+/**@brief Copy a string value, with its escape sequences decoded.
+ *
+ * Like snprintf(), the string is truncated to fit in @p buf and
+ * null-terminated, and the length of the whole string is returned. @p buf
+ * can be NULL if @p size is 0, to get the length.
+ *
+ * @param[in]  str   A string value, from a validated document.
+ * @param[out] buf   Buffer for the string.
+ * @param[in]  size  Size of the buffer.
+ *
+ * @return Length of the decoded string, or -EINVAL if @p str is not a string.
+ */
+int nrf_cloud_json_str_get(const struct nrf_cloud_json_val *str, char *buf,
+			   size_t size);
+
+/**@brief Copy a value with the whitespace between its tokens removed.
+ *
+ * The output is truncated like for @ref nrf_cloud_json_str_get, but is not
+ * null-terminated.
+ *
+ * @param[in]  val   A value, from a validated document.
+ * @param[out] buf   Buffer for the value.
+ * @param[in]  size  Size of the buffer.
+ *
+ * @return Length of the whole value without whitespace.
+ */
+size_t nrf_cloud_json_minify(const struct nrf_cloud_json_val *val, char *buf,
+			     size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_JSON_H__ */
@@ -36,6 +36,14 @@ static nrf_cloud_event_handler_t app_event_handler;
 
 static K_MUTEX_DEFINE(state_mutex);
 
+#if CONFIG_NRF_CLOUD_ENCODE_BUF_SIZE > 0
+/* Sensor and shadow messages are encoded into this buffer when they fit.
+ * It is locked from encoding until the message has been sent.
+ */
+static char encode_buf[CONFIG_NRF_CLOUD_ENCODE_BUF_SIZE];
+static K_MUTEX_DEFINE(encode_buf_mutex);
+#endif
+
 enum nfsm_state nfsm_get_current_state(void)
 {
 	return current_state;
@@ -109,6 +117,53 @@ int nrf_cloud_disconnect(void)
 	return nct_disconnect();
 }
 
+static int sensor_data_encode(const struct nrf_cloud_sensor_data *param,
+			      bool shadow, struct nrf_cloud_data *output)
+{
+#if CONFIG_NRF_CLOUD_ENCODE_BUF_SIZE > 0
+	int err;
+
+	k_mutex_lock(&encode_buf_mutex, K_FOREVER);
+
+	if (shadow) {
+		err = nrf_cloud_encode_shadow_data_buf(param, encode_buf,
+						       sizeof(encode_buf),
+						       output);
+	} else {
+		err = nrf_cloud_encode_sensor_data_buf(param, encode_buf,
+						       sizeof(encode_buf),
+						       output);
+	}
+
+	if (err != -ENOMEM) {
+		if (err) {
+			k_mutex_unlock(&encode_buf_mutex);
+		}
+		return err;
+	}
+
+	k_mutex_unlock(&encode_buf_mutex);
+	LOG_DBG("Message does not fit in encode buffer, using cJSON");
+#endif
+
+	if (shadow) {
+		return nrf_cloud_encode_shadow_data(param, output);
+	}
+	return nrf_cloud_encode_sensor_data(param, output);
+}
+
+static void sensor_data_free(const struct nrf_cloud_data *data)
+{
+#if CONFIG_NRF_CLOUD_ENCODE_BUF_SIZE > 0
+	if (data->ptr == encode_buf) {
+		k_mutex_unlock(&encode_buf_mutex);
+		return;
+	}
+#endif
+
+	nrf_cloud_free((void *)data->ptr);
+}
+
 int nrf_cloud_shadow_update(const struct nrf_cloud_sensor_data *param)
 {
 	int err;
@@ -125,13 +180,13 @@ int nrf_cloud_shadow_update(const struct nrf_cloud_sensor_data *param)
 		return -EINVAL;
 	}
 
-	err = nrf_cloud_encode_shadow_data(param, &sensor_data.data);
+	err = sensor_data_encode(param, true, &sensor_data.data);
 	if (err) {
 		return err;
 	}
 
 	err = nct_cc_send(&sensor_data);
-	nrf_cloud_free((void *)sensor_data.data.ptr);
+	sensor_data_free(&sensor_data.data);
 
 	return err;
 }
@@ -164,14 +219,14 @@ int nrf_cloud_sensor_data_send(const struct nrf_cloud_sensor_data *param)
 		return -EINVAL;
 	}
 
-	err = nrf_cloud_encode_sensor_data(param, &sensor_data.data);
+	err = sensor_data_encode(param, false, &sensor_data.data);
 	if (err) {
 		return err;
 	}
 
 	sensor_data.id = param->tag;
 	err = nct_dc_send(&sensor_data);
-	nrf_cloud_free((void *)sensor_data.data.ptr);
+	sensor_data_free(&sensor_data.data);
 
 	return err;
 }
@@ -189,14 +244,14 @@ int nrf_cloud_sensor_data_stream(const struct nrf_cloud_sensor_data *param)
 		return -EINVAL;
 	}
 
-	err = nrf_cloud_encode_sensor_data(param, &sensor_data.data);
+	err = sensor_data_encode(param, false, &sensor_data.data);
 	if (err) {
 		return err;
 	}
 
 	sensor_data.id = param->tag;
 	err = nct_dc_stream(&sensor_data);
-	nrf_cloud_free((void *)sensor_data.data.ptr);
+	sensor_data_free(&sensor_data.data);
 
 	return err;
 }
@@ -6,6 +6,7 @@
 
 #include "nrf_cloud_codec.h"
 #include "nrf_cloud_mem.h"
+#include "nrf_cloud_json.h"
 
 #include <stdbool.h>
 #include <string.h>
@@ -65,26 +66,26 @@ static int json_add_null(cJSON *parent, const char *str)
 	return json_add_obj(parent, str, json_null);
 }
 
-static cJSON *json_object_decode(cJSON *obj, const char *str)
+static int json_decode_and_alloc(const struct nrf_cloud_json_val *obj,
+				 struct nrf_cloud_data *data)
 {
-	return obj ? cJSON_GetObjectItem(obj, str) : NULL;
-}
+	int len = nrf_cloud_json_str_get(obj, NULL, 0);
 
-static int json_decode_and_alloc(cJSON *obj, struct nrf_cloud_data *data)
-{
-	if (obj == NULL || (obj->type != cJSON_String)) {
+	if (len < 0) {
 		data->ptr = NULL;
 		return -ENOENT;
 	}
 
-	data->len = strlen(obj->valuestring);
-	data->ptr = nrf_cloud_malloc(data->len + 1);
+	data->ptr = nrf_cloud_malloc(len + 1);
 
 	if (data->ptr == NULL) {
 		return -ENOMEM;
 	}
 
-	strncpy((char *)data->ptr, obj->valuestring, data->len + 1);
+	(void)nrf_cloud_json_str_get(obj, (char *)data->ptr, len + 1);
+
+	/* An escaped null character ends the string, like in cJSON. */
+	data->len = strlen(data->ptr);
 
 	return 0;
 }
@@ -94,21 +95,14 @@ static bool compare(const char *s1, const char *s2)
 	return !strncmp(s1, s2, strlen(s2));
 }
 
-static void nrf_cloud_decode_desired_obj(cJSON *const root_obj,
-					 cJSON **desired_obj)
+static void json_desired_obj_decode(const struct nrf_cloud_json_val *root_obj,
+				    struct nrf_cloud_json_val *desired_obj)
 {
-	cJSON *state_obj;
-
-	if ((root_obj != NULL) && (desired_obj != NULL)) {
-		/* On initial pairing, a shadow delta event is sent */
-		/* which does not include the "desired" JSON key, */
-		/* "state" is used instead */
-		state_obj = json_object_decode(root_obj, "state");
-		if (state_obj == NULL) {
-			*desired_obj = json_object_decode(root_obj, "desired");
-		} else {
-			*desired_obj = state_obj;
-		}
+	/* On initial pairing, a shadow delta event is sent */
+	/* which does not include the "desired" JSON key, */
+	/* "state" is used instead */
+	if (nrf_cloud_json_obj_get(root_obj, "state", desired_obj) != 0) {
+		(void)nrf_cloud_json_obj_get(root_obj, "desired", desired_obj);
 	}
 }
 
@@ -197,6 +191,148 @@ int nrf_cloud_encode_sensor_data(const struct nrf_cloud_sensor_data *sensor,
 	return 0;
 }
 
+/* --- Encoding into a buffer, with the output of cJSON_PrintUnformatted --- */
+
+struct json_buf {
+	char *ptr;
+	size_t size;
+	size_t len;
+};
+
+static int buf_add(struct json_buf *buf, const char *str, size_t len)
+{
+	/* Keep room for the null terminator. */
+	if (len >= buf->size - buf->len) {
+		return -ENOMEM;
+	}
+
+	memcpy(&buf->ptr[buf->len], str, len);
+	buf->len += len;
+	buf->ptr[buf->len] = '\0';
+
+	return 0;
+}
+
+static int buf_add_raw(struct json_buf *buf, const char *str)
+{
+	return buf_add(buf, str, strlen(str));
+}
+
+/* Quote and escape the string like cJSON. */
+static int buf_add_str(struct json_buf *buf, const char *str)
+{
+	int ret = buf_add(buf, "\"", 1);
+
+	for (const char *c = str; (ret == 0) && (*c != '\0'); c++) {
+		char esc[7] = { '\\' };
+
+		switch (*c) {
+		case '\"':
+		case '\\':
+			esc[1] = *c;
+			break;
+		case '\b':
+			esc[1] = 'b';
+			break;
+		case '\f':
+			esc[1] = 'f';
+			break;
+		case '\n':
+			esc[1] = 'n';
+			break;
+		case '\r':
+			esc[1] = 'r';
+			break;
+		case '\t':
+			esc[1] = 't';
+			break;
+		default:
+			if ((unsigned char)*c < 32) {
+				snprintk(&esc[1], sizeof(esc) - 1, "u%04x", *c);
+				break;
+			}
+			ret = buf_add(buf, c, 1);
+			continue;
+		}
+		ret = buf_add_raw(buf, esc);
+	}
+
+	return ret ? ret : buf_add(buf, "\"", 1);
+}
+
+int nrf_cloud_encode_sensor_data_buf(const struct nrf_cloud_sensor_data *sensor,
+				     char *buf, size_t size,
+				     struct nrf_cloud_data *output)
+{
+	int ret;
+	struct json_buf json = { .ptr = buf, .size = size };
+
+	__ASSERT_NO_MSG(sensor != NULL);
+	__ASSERT_NO_MSG(sensor->data.ptr != NULL);
+	__ASSERT_NO_MSG(sensor->data.len != 0);
+	__ASSERT_NO_MSG(buf != NULL);
+	__ASSERT_NO_MSG(output != NULL);
+
+	ret = buf_add_raw(&json, "{\"appId\":");
+	ret = ret ? ret : buf_add_str(&json, sensor_type_str[sensor->type]);
+	ret = ret ? ret : buf_add_raw(&json, ",\"data\":");
+	ret = ret ? ret : buf_add_str(&json, sensor->data.ptr);
+	ret = ret ? ret : buf_add_raw(&json, ",\"messageType\":\"DATA\"}");
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	output->ptr = buf;
+	output->len = json.len;
+
+	return 0;
+}
+
+int nrf_cloud_encode_shadow_data_buf(const struct nrf_cloud_sensor_data *sensor,
+				     char *buf, size_t size,
+				     struct nrf_cloud_data *output)
+{
+	int ret;
+	struct json_buf json = { .ptr = buf, .size = size };
+	cJSON *data_obj;
+
+	__ASSERT_NO_MSG(sensor != NULL);
+	__ASSERT_NO_MSG(sensor->data.ptr != NULL);
+	__ASSERT_NO_MSG(sensor->data.len != 0);
+	__ASSERT_NO_MSG(buf != NULL);
+	__ASSERT_NO_MSG(output != NULL);
+
+	data_obj = (cJSON *)sensor->data.ptr;
+
+	ret = buf_add_raw(&json, "{\"state\":{\"reported\":{");
+	ret = ret ? ret : buf_add_str(&json, sensor_type_str[sensor->type]);
+	ret = ret ? ret : buf_add(&json, ":", 1);
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* The data object is printed without allocating. */
+	if (!cJSON_PrintPreallocated(data_obj, &buf[json.len],
+				     size - json.len, false)) {
+		return -ENOMEM;
+	}
+	json.len += strlen(&buf[json.len]);
+
+	ret = buf_add_raw(&json, "}}}");
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Consumed, as when added to the tree in the cJSON encoder. */
+	cJSON_Delete(data_obj);
+
+	output->ptr = buf;
+	output->len = json.len;
+
+	return 0;
+}
+
 int nrf_cloud_decode_requested_state(const struct nrf_cloud_data *input,
 				     enum nfsm_state *requested_state)
 {
@@ -205,52 +341,49 @@ int nrf_cloud_decode_requested_state(const struct nrf_cloud_data *input,
 	__ASSERT_NO_MSG(input->ptr != NULL);
 	__ASSERT_NO_MSG(input->len != 0);
 
-	cJSON *root_obj;
-	cJSON *desired_obj;
-	cJSON *pairing_obj;
-	cJSON *pairing_state_obj;
-	cJSON *topic_prefix_obj;
-
-	root_obj = cJSON_Parse(input->ptr);
-	if (root_obj == NULL) {
-		LOG_ERR("cJSON_Parse failed: %s",
-			log_strdup((char *)input->ptr));
+	struct nrf_cloud_json_val root_obj;
+	struct nrf_cloud_json_val desired_obj;
+	struct nrf_cloud_json_val pairing_obj;
+	struct nrf_cloud_json_val pairing_state_obj;
+	struct nrf_cloud_json_val topic_prefix_obj;
+	struct nrf_cloud_json_val config_obj;
+	char state_str[sizeof(DUA_PIN_STR)];
+
+	if (nrf_cloud_json_parse(input->ptr, input->len, &root_obj)) {
+		/* The message is not null-terminated, so it is not printed. */
+		LOG_ERR("JSON parsing failed");
+		LOG_HEXDUMP_DBG(input->ptr, input->len, "Message:");
 		return -ENOENT;
 	}
 
-	nrf_cloud_decode_desired_obj(root_obj, &desired_obj);
+	json_desired_obj_decode(&root_obj, &desired_obj);
 
-	topic_prefix_obj =
-		json_object_decode(desired_obj, "nrfcloud_mqtt_topic_prefix");
-	if (topic_prefix_obj != NULL) {
+	if (nrf_cloud_json_obj_get(&desired_obj, "nrfcloud_mqtt_topic_prefix",
+				   &topic_prefix_obj) == 0) {
 		(*requested_state) = STATE_UA_PIN_COMPLETE;
-		cJSON_Delete(root_obj);
 		return 0;
 	}
 
-	pairing_obj = json_object_decode(desired_obj, "pairing");
-	pairing_state_obj = json_object_decode(pairing_obj, "state");
+	(void)nrf_cloud_json_obj_get(&desired_obj, "pairing", &pairing_obj);
+	(void)nrf_cloud_json_obj_get(&pairing_obj, "state", &pairing_state_obj);
 
-	if (!pairing_state_obj || pairing_state_obj->type != cJSON_String) {
-		if (cJSON_HasObjectItem(desired_obj, "config") == false) {
+	/* Only the length of DUA_PIN_STR is compared. */
+	if (nrf_cloud_json_str_get(&pairing_state_obj, state_str,
+				   sizeof(state_str)) < 0) {
+		if (nrf_cloud_json_obj_get(&desired_obj, "config",
+					   &config_obj) != 0) {
 			LOG_DBG("No valid state found!");
 		}
-		cJSON_Delete(root_obj);
 		return -ENOENT;
 	}
 
-	const char *state_str = pairing_state_obj->valuestring;
-
 	if (compare(state_str, DUA_PIN_STR)) {
 		(*requested_state) = STATE_UA_PIN_WAIT;
 	} else {
 		LOG_ERR("Deprecated state. Delete device from nrfCloud and update device with JITP certificates.");
-		cJSON_Delete(root_obj);
 		return -ENOTSUP;
 	}
 
-	cJSON_Delete(root_obj);
-
 	return 0;
 }
 
@@ -261,77 +394,60 @@ int nrf_cloud_encode_config_response(struct nrf_cloud_data const *const input,
 	__ASSERT_NO_MSG(output != NULL);
 	__ASSERT_NO_MSG(input != NULL);
 
-	char *buffer = NULL;
-	cJSON *root_obj = NULL;
-	cJSON *desired_obj = NULL;
-	cJSON *null_obj = NULL;
-	cJSON *reported_obj = NULL;
-	cJSON *state_obj = NULL;
-	cJSON *config_obj = NULL;
-	cJSON *input_obj = input ? cJSON_Parse(input->ptr) : NULL;
-
-	if (input_obj == NULL) {
+	static const char resp_start[] = "{\"state\":{\"reported\":{\"config\":";
+	static const char resp_end[] = "},\"desired\":{\"config\":null}}}";
+	char *buffer;
+	size_t config_len;
+	struct nrf_cloud_json_val root_obj;
+	struct nrf_cloud_json_val state_obj;
+	struct nrf_cloud_json_val config_obj;
+	bool has_state;
+	bool config_found;
+
+	if ((input == NULL) || (input->ptr == NULL) ||
+	    nrf_cloud_json_parse(input->ptr, input->len, &root_obj)) {
 		return -ESRCH; /* invalid input or no JSON parsed */
 	}
 
 	/* A delta update will have the config inside of state */
-	state_obj = cJSON_DetachItemFromObject(input_obj, "state");
-	config_obj = cJSON_DetachItemFromObject(
-		state_obj ? state_obj : input_obj, "config");
-	cJSON_Delete(input_obj);
+	has_state = (nrf_cloud_json_obj_get(&root_obj, "state",
+					    &state_obj) == 0);
+	config_found = (nrf_cloud_json_obj_get(has_state ? &state_obj : &root_obj,
+					       "config", &config_obj) == 0);
 
 	if (has_config) {
-		*has_config = (config_obj != NULL);
+		*has_config = config_found;
 	}
 
 	/* If this is not a delta update, no response data is required */
-	if ((state_obj == NULL) || (config_obj == NULL)) {
-		cJSON_Delete(state_obj);
-		cJSON_Delete(config_obj);
-
+	if (!has_state || !config_found) {
 		output->ptr = NULL;
 		output->len = 0;
 		return 0;
 	}
 
-	/* Prepare JSON response for the delta */
-	root_obj = cJSON_CreateObject();
-	desired_obj = cJSON_CreateObject();
-	null_obj = cJSON_CreateNull();
-	reported_obj = cJSON_CreateObject();
-
-	if ((root_obj == NULL) || (desired_obj == NULL) || (null_obj == NULL) ||
-		(reported_obj == NULL)) {
-		cJSON_Delete(root_obj);
-		cJSON_Delete(desired_obj);
-		cJSON_Delete(null_obj);
-		cJSON_Delete(reported_obj);
-		cJSON_Delete(config_obj);
-		cJSON_Delete(state_obj);
-		return -ENOMEM;
-	}
-
-	/* Add delta config to reported */
-	(void)json_add_obj(reported_obj, "config", config_obj);
-	(void)json_add_obj(root_obj, "reported", reported_obj);
-
-	/* Add a null config to desired */
-	(void)json_add_obj(desired_obj, "config", null_obj);
-	(void)json_add_obj(root_obj, "desired", desired_obj);
-
-	/* Cleanup received state obj and re-use for the response */
-	cJSON_Delete(state_obj);
-	state_obj = cJSON_CreateObject();
-	(void)json_add_obj(state_obj, "state", root_obj);
-	buffer = cJSON_PrintUnformatted(state_obj);
-	cJSON_Delete(state_obj);
+	/* Report the delta config, and set a null config as desired. The
+	 * config is copied as it is, without the whitespace.
+	 */
+	config_len = nrf_cloud_json_minify(&config_obj, NULL, 0);
+	output->len = (sizeof(resp_start) - 1) + config_len +
+		      (sizeof(resp_end) - 1);
 
+	buffer = nrf_cloud_malloc(output->len + 1);
 	if (buffer == NULL) {
+		output->ptr = NULL;
+		output->len = 0;
 		return -ENOMEM;
 	}
 
+	memcpy(buffer, resp_start, sizeof(resp_start) - 1);
+	(void)nrf_cloud_json_minify(&config_obj,
+				    &buffer[sizeof(resp_start) - 1],
+				    config_len);
+	memcpy(&buffer[sizeof(resp_start) - 1 + config_len], resp_end,
+	       sizeof(resp_end));
+
 	output->ptr = buffer;
-	output->len = strlen(buffer);
 
 	return 0;
 }
@@ -461,64 +577,57 @@ int nrf_cloud_decode_data_endpoint(const struct nrf_cloud_data *input,
 	__ASSERT_NO_MSG(rx_endpoint != NULL);
 
 	int err;
-	cJSON *root_obj;
-	cJSON *m_endpoint_obj = NULL;
-	cJSON *desired_obj = NULL;
-
-	root_obj = cJSON_Parse(input->ptr);
-	if (root_obj == NULL) {
+	struct nrf_cloud_json_val root_obj;
+	struct nrf_cloud_json_val m_endpoint_obj = { 0 };
+	struct nrf_cloud_json_val desired_obj;
+	struct nrf_cloud_json_val pairing_obj;
+	struct nrf_cloud_json_val pairing_state_obj;
+	struct nrf_cloud_json_val topic_obj;
+	struct nrf_cloud_json_val tx_obj;
+	struct nrf_cloud_json_val rx_obj;
+	char state_str[sizeof(PAIRED_STR)];
+
+	if (nrf_cloud_json_parse(input->ptr, input->len, &root_obj)) {
 		return -ENOENT;
 	}
 
-	nrf_cloud_decode_desired_obj(root_obj, &desired_obj);
+	json_desired_obj_decode(&root_obj, &desired_obj);
 
 	if (m_endpoint != NULL) {
-		m_endpoint_obj = json_object_decode(
-			desired_obj, "nrfcloud_mqtt_topic_prefix");
+		(void)nrf_cloud_json_obj_get(&desired_obj,
+					     "nrfcloud_mqtt_topic_prefix",
+					     &m_endpoint_obj);
 	}
 
-	cJSON *pairing_obj = json_object_decode(desired_obj, "pairing");
-	cJSON *pairing_state_obj = json_object_decode(pairing_obj, "state");
-	cJSON *topic_obj = json_object_decode(pairing_obj, "topics");
+	(void)nrf_cloud_json_obj_get(&desired_obj, "pairing", &pairing_obj);
 
-	if ((pairing_state_obj == NULL) || (topic_obj == NULL) ||
-	    (pairing_state_obj->type != cJSON_String)) {
-		cJSON_Delete(root_obj);
+	if ((nrf_cloud_json_obj_get(&pairing_obj, "state",
+				    &pairing_state_obj) != 0) ||
+	    (nrf_cloud_json_obj_get(&pairing_obj, "topics", &topic_obj) != 0) ||
+	    (nrf_cloud_json_str_get(&pairing_state_obj, state_str,
+				    sizeof(state_str)) < 0)) {
 		return -ENOENT;
 	}
 
-	const char *state_str = pairing_state_obj->valuestring;
-
 	if (!compare(state_str, PAIRED_STR)) {
-		cJSON_Delete(root_obj);
 		return -ENOENT;
 	}
 
-	if (m_endpoint_obj != NULL) {
-		err = json_decode_and_alloc(m_endpoint_obj, m_endpoint);
+	if (m_endpoint_obj.ptr != NULL) {
+		err = json_decode_and_alloc(&m_endpoint_obj, m_endpoint);
 		if (err) {
-			cJSON_Delete(root_obj);
 			return err;
 		}
 	}
 
-	cJSON *tx_obj = json_object_decode(topic_obj, "d2c");
-
-	err = json_decode_and_alloc(tx_obj, tx_endpoint);
-	if (err) {
-		cJSON_Delete(root_obj);
-		return err;
-	}
-
-	cJSON *rx_obj = json_object_decode(topic_obj, "c2d");
+	(void)nrf_cloud_json_obj_get(&topic_obj, "d2c", &tx_obj);
 
-	err = json_decode_and_alloc(rx_obj, rx_endpoint);
+	err = json_decode_and_alloc(&tx_obj, tx_endpoint);
 	if (err) {
-		cJSON_Delete(root_obj);
 		return err;
 	}
 
-	cJSON_Delete(root_obj);
+	(void)nrf_cloud_json_obj_get(&topic_obj, "c2d", &rx_obj);
 
-	return err;
+	return json_decode_and_alloc(&rx_obj, rx_endpoint);
 }
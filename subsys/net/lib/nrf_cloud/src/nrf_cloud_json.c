@@ -0,0 +1,534 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include "nrf_cloud_json.h"
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr.h>
+
+/* Output of a decoded string, which counts what does not fit. */
+struct str_out {
+	char *buf;
+	size_t size;
+	size_t len;
+};
+
+static void out_add(struct str_out *out, char c)
+{
+	if (out->len < out->size) {
+		out->buf[out->len] = c;
+	}
+	out->len++;
+}
+
+static void out_end(struct str_out *out)
+{
+	if (out->size != 0) {
+		out->buf[MIN(out->len, out->size - 1)] = '\0';
+	}
+}
+
+static bool is_ws(char c)
+{
+	return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+}
+
+static const char *ws_skip(const char *p, const char *end)
+{
+	while ((p < end) && is_ws(*p)) {
+		p++;
+	}
+
+	return p;
+}
+
+static bool hex4_decode(const char *p, const char *end, u32_t *val)
+{
+	if ((end - p) < 4) {
+		return false;
+	}
+
+	*val = 0;
+	for (int i = 0; i < 4; i++) {
+		char c = p[i];
+
+		if (!isxdigit((unsigned char)c)) {
+			return false;
+		}
+		*val = (*val << 4) | (isdigit((unsigned char)c) ?
+			(c - '0') : (tolower((unsigned char)c) - 'a' + 10));
+	}
+
+	return true;
+}
+
+static void utf8_add(struct str_out *out, u32_t cp)
+{
+	if (cp < 0x80) {
+		out_add(out, cp);
+	} else if (cp < 0x800) {
+		out_add(out, 0xC0 | (cp >> 6));
+		out_add(out, 0x80 | (cp & 0x3F));
+	} else if (cp < 0x10000) {
+		out_add(out, 0xE0 | (cp >> 12));
+		out_add(out, 0x80 | ((cp >> 6) & 0x3F));
+		out_add(out, 0x80 | (cp & 0x3F));
+	} else {
+		out_add(out, 0xF0 | (cp >> 18));
+		out_add(out, 0x80 | ((cp >> 12) & 0x3F));
+		out_add(out, 0x80 | ((cp >> 6) & 0x3F));
+		out_add(out, 0x80 | (cp & 0x3F));
+	}
+}
+
+/* Decode a \u escape sequence, after the 'u', and a second one if the first
+ * is the high half of a UTF-16 surrogate pair. Returns a pointer past the
+ * sequence, or NULL if it is not valid.
+ */
+static const char *unicode_decode(const char *p, const char *end,
+				  struct str_out *out)
+{
+	u32_t cp;
+	u32_t low;
+
+	if (!hex4_decode(p, end, &cp)) {
+		return NULL;
+	}
+	p += 4;
+
+	if ((cp >= 0xDC00) && (cp <= 0xDFFF)) {
+		return NULL;
+	}
+
+	if ((cp >= 0xD800) && (cp <= 0xDBFF)) {
+		if (((end - p) < 2) || (p[0] != '\\') || (p[1] != 'u') ||
+		    !hex4_decode(p + 2, end, &low) ||
+		    (low < 0xDC00) || (low > 0xDFFF)) {
+			return NULL;
+		}
+		p += 6;
+		cp = 0x10000 + (((cp & 0x3FF) << 10) | (low & 0x3FF));
+	}
+
+	utf8_add(out, cp);
+
+	return p;
+}
+
+/* Scan a string from its opening quote, and decode it to 'out' if that is
+ * not NULL. Returns a pointer past the closing quote, or NULL if the string
+ * is not valid.
+ */
+static const char *str_scan(const char *p, const char *end,
+			    struct str_out *out)
+{
+	struct str_out discard = { 0 };
+
+	if (out == NULL) {
+		out = &discard;
+	}
+
+	if ((p == end) || (*p != '"')) {
+		return NULL;
+	}
+	p++;
+
+	while (p < end) {
+		char c = *p++;
+
+		if (c == '"') {
+			out_end(out);
+			return p;
+		}
+
+		if ((unsigned char)c < 0x20) {
+			return NULL;
+		}
+
+		if (c != '\\') {
+			out_add(out, c);
+			continue;
+		}
+
+		if (p == end) {
+			return NULL;
+		}
+
+		c = *p++;
+		switch (c) {
+		case '"':
+		case '\\':
+		case '/':
+			out_add(out, c);
+			break;
+		case 'b':
+			out_add(out, '\b');
+			break;
+		case 'f':
+			out_add(out, '\f');
+			break;
+		case 'n':
+			out_add(out, '\n');
+			break;
+		case 'r':
+			out_add(out, '\r');
+			break;
+		case 't':
+			out_add(out, '\t');
+			break;
+		case 'u':
+			p = unicode_decode(p, end, out);
+			if (p == NULL) {
+				return NULL;
+			}
+			break;
+		default:
+			return NULL;
+		}
+	}
+
+	return NULL;
+}
+
+static const char *digits_scan(const char *p, const char *end)
+{
+	const char *start = p;
+
+	while ((p < end) && isdigit((unsigned char)*p)) {
+		p++;
+	}
+
+	return (p == start) ? NULL : p;
+}
+
+static const char *number_scan(const char *p, const char *end)
+{
+	if ((p < end) && (*p == '-')) {
+		p++;
+	}
+
+	if ((p < end) && (*p == '0')) {
+		p++;
+	} else {
+		p = digits_scan(p, end);
+		if (p == NULL) {
+			return NULL;
+		}
+	}
+
+	if ((p < end) && (*p == '.')) {
+		p = digits_scan(p + 1, end);
+		if (p == NULL) {
+			return NULL;
+		}
+	}
+
+	if ((p < end) && ((*p == 'e') || (*p == 'E'))) {
+		p++;
+		if ((p < end) && ((*p == '+') || (*p == '-'))) {
+			p++;
+		}
+		p = digits_scan(p, end);
+	}
+
+	return p;
+}
+
+static const char *literal_scan(const char *p, const char *end,
+				const char *literal)
+{
+	size_t len = strlen(literal);
+
+	if (((size_t)(end - p) < len) || (memcmp(p, literal, len) != 0)) {
+		return NULL;
+	}
+
+	return p + len;
+}
+
+static const char *value_scan(const char *p, const char *end, int depth);
+
+/* Scan an object or array from its opening bracket. */
+static const char *container_scan(const char *p, const char *end, int depth)
+{
+	bool is_obj = (*p == '{');
+	char close = is_obj ? '}' : ']';
+
+	if (depth >= NRF_CLOUD_JSON_NESTING_LIMIT) {
+		return NULL;
+	}
+
+	p = ws_skip(p + 1, end);
+	if ((p < end) && (*p == close)) {
+		return p + 1;
+	}
+
+	for (;;) {
+		if (is_obj) {
+			p = str_scan(p, end, NULL);
+			if (p == NULL) {
+				return NULL;
+			}
+			p = ws_skip(p, end);
+			if ((p == end) || (*p != ':')) {
+				return NULL;
+			}
+			p = ws_skip(p + 1, end);
+		}
+
+		p = value_scan(p, end, depth + 1);
+		if (p == NULL) {
+			return NULL;
+		}
+
+		p = ws_skip(p, end);
+		if (p == end) {
+			return NULL;
+		}
+		if (*p == close) {
+			return p + 1;
+		}
+		if (*p != ',') {
+			return NULL;
+		}
+		p = ws_skip(p + 1, end);
+	}
+}
+
+/* Scan a value, from its first character. Returns a pointer past it, or
+ * NULL if it is not valid.
+ */
+static const char *value_scan(const char *p, const char *end, int depth)
+{
+	if (p == end) {
+		return NULL;
+	}
+
+	switch (*p) {
+	case '{':
+	case '[':
+		return container_scan(p, end, depth);
+	case '"':
+		return str_scan(p, end, NULL);
+	case 't':
+		return literal_scan(p, end, "true");
+	case 'f':
+		return literal_scan(p, end, "false");
+	case 'n':
+		return literal_scan(p, end, "null");
+	default:
+		return number_scan(p, end);
+	}
+}
+
+/* Skip a string of a validated document, from its opening quote. */
+static const char *str_skip(const char *p, const char *end)
+{
+	for (p++; p < end; p++) {
+		if (*p == '\\') {
+			p++;
+		} else if (*p == '"') {
+			return p + 1;
+		}
+	}
+
+	return end;
+}
+
+/* Skip a value of a validated document, without validating it again. */
+static const char *value_skip(const char *p, const char *end)
+{
+	int depth = 0;
+
+	if (*p == '"') {
+		return str_skip(p, end);
+	}
+
+	if ((*p != '{') && (*p != '[')) {
+		while ((p < end) && !is_ws(*p) && (*p != ',') &&
+		       (*p != '}') && (*p != ']')) {
+			p++;
+		}
+		return p;
+	}
+
+	do {
+		if (*p == '"') {
+			p = str_skip(p, end);
+			continue;
+		}
+
+		if ((*p == '{') || (*p == '[')) {
+			depth++;
+		} else if ((*p == '}') || (*p == ']')) {
+			depth--;
+		}
+		p++;
+	} while ((depth > 0) && (p < end));
+
+	return p;
+}
+
+static bool key_equal(const char *key, size_t key_len, const char *str)
+{
+	if (key_len != strlen(str)) {
+		return false;
+	}
+
+	for (size_t i = 0; i < key_len; i++) {
+		if (tolower((unsigned char)key[i]) !=
+		    tolower((unsigned char)str[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int nrf_cloud_json_parse(const char *json, size_t len,
+			 struct nrf_cloud_json_val *root)
+{
+	const char *end = json + strnlen(json, len);
+	const char *p = ws_skip(json, end);
+	const char *val_end = value_scan(p, end, 0);
+
+	if (val_end == NULL) {
+		root->ptr = NULL;
+		root->len = 0;
+		return -EINVAL;
+	}
+
+	root->ptr = p;
+	root->len = val_end - p;
+
+	return 0;
+}
+
+enum nrf_cloud_json_type nrf_cloud_json_type_get(
+	const struct nrf_cloud_json_val *val)
+{
+	if ((val->ptr == NULL) || (val->len == 0)) {
+		return NRF_CLOUD_JSON_NONE;
+	}
+
+	switch (val->ptr[0]) {
+	case '{':
+		return NRF_CLOUD_JSON_OBJECT;
+	case '[':
+		return NRF_CLOUD_JSON_ARRAY;
+	case '"':
+		return NRF_CLOUD_JSON_STRING;
+	case 't':
+	case 'f':
+		return NRF_CLOUD_JSON_BOOL;
+	case 'n':
+		return NRF_CLOUD_JSON_NULL;
+	default:
+		return NRF_CLOUD_JSON_NUMBER;
+	}
+}
+
+int nrf_cloud_json_obj_get(const struct nrf_cloud_json_val *obj,
+			   const char *key, struct nrf_cloud_json_val *val)
+{
+	char key_buf[NRF_CLOUD_JSON_KEY_LEN_MAX + 1];
+	struct str_out key_out = {
+		.buf = key_buf,
+		.size = sizeof(key_buf),
+	};
+	const char *end;
+	const char *p;
+
+	__ASSERT_NO_MSG(strlen(key) <= NRF_CLOUD_JSON_KEY_LEN_MAX);
+
+	val->ptr = NULL;
+	val->len = 0;
+
+	if (nrf_cloud_json_type_get(obj) != NRF_CLOUD_JSON_OBJECT) {
+		return -ENOENT;
+	}
+
+	end = obj->ptr + obj->len;
+	p = ws_skip(obj->ptr + 1, end);
+
+	/* The object has been validated, so the members need not be. */
+	while ((p < end) && (*p == '"')) {
+		const char *val_start;
+		const char *val_end;
+
+		key_out.len = 0;
+		p = str_scan(p, end, &key_out);
+		if (p == NULL) {
+			return -ENOENT;
+		}
+
+		/* Past the colon. */
+		val_start = ws_skip(ws_skip(p, end) + 1, end);
+		val_end = value_skip(val_start, end);
+
+		if (key_equal(key_buf, key_out.len, key)) {
+			val->ptr = val_start;
+			val->len = val_end - val_start;
+			return 0;
+		}
+
+		/* Past the comma. */
+		p = ws_skip(ws_skip(val_end, end) + 1, end);
+	}
+
+	return -ENOENT;
+}
+
+int nrf_cloud_json_str_get(const struct nrf_cloud_json_val *str, char *buf,
+			   size_t size)
+{
+	struct str_out out = {
+		.buf = buf,
+		.size = size,
+	};
+
+	if ((nrf_cloud_json_type_get(str) != NRF_CLOUD_JSON_STRING) ||
+	    (str_scan(str->ptr, str->ptr + str->len, &out) == NULL)) {
+		return -EINVAL;
+	}
+
+	return (int)out.len;
+}
+
+size_t nrf_cloud_json_minify(const struct nrf_cloud_json_val *val, char *buf,
+			     size_t size)
+{
+	struct str_out out = {
+		.buf = buf,
+		.size = size,
+	};
+	bool in_str = false;
+	bool escaped = false;
+
+	for (size_t i = 0; i < val->len; i++) {
+		char c = val->ptr[i];
+
+		if (in_str) {
+			if (escaped) {
+				escaped = false;
+			} else if (c == '\\') {
+				escaped = true;
+			} else if (c == '"') {
+				in_str = false;
+			}
+		} else if (c == '"') {
+			in_str = true;
+		} else if (is_ws(c)) {
+			continue;
+		}
+
+		out_add(&out, c);
+	}
+
+	return out.len;
+}
@@ -6,6 +6,7 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <errno.h>
 #include <shell/shell.h>
 #include <shell/shell_rtt.h>
 #include <profiler.h>
@@ -106,6 +107,20 @@ static int disable_event_profiling(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+static int display_dropped_records(const struct shell *shell, size_t argc,
+				   char **argv)
+{
+	if (!IS_ENABLED(CONFIG_PROFILER_NORDIC)) {
+		shell_error(shell, "Not supported by the profiler backend");
+		return -ENOTSUP;
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "Dropped records: %u\n",
+		      profiler_nordic_dropped_records_get());
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
 	SHELL_CMD_ARG(list, NULL, "Display list of events",
 			display_registered_events, 0, 0),
@@ -115,6 +130,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
 	SHELL_CMD_ARG(disable, NULL, "Disable profiling of event with given ID",
 			disable_event_profiling, 1,
 			sizeof(profiler_enabled_events) * 8),
+	SHELL_CMD_ARG(dropped, NULL, "Display number of dropped records",
+			display_dropped_records, 0, 0),
 	SHELL_SUBCMD_SET_END
 );
 SHELL_CMD_REGISTER(profiler, &sub_profiler, "Profiler commands", NULL);
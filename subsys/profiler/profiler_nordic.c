@@ -10,10 +10,11 @@
 #include <sys/util.h>
 #include <sys/byteorder.h>
 #include <zephyr.h>
-#include <SEGGER_RTT.h>
 #include <profiler.h>
 #include <string.h>
 
+#include "profiler_nordic_transport.h"
+
 
 /* By default, when there is no shell, all events are profiled. */
 #ifndef CONFIG_SHELL
@@ -21,9 +22,51 @@ u32_t profiler_enabled_events = 0xffffffff;
 #endif
 
 
+/* Size of the event type ID field in a record. */
+#define TYPE_ID_SIZE		sizeof(u8_t)
+/* Maximum size of a 32-bit value encoded as a varint. */
+#define VARINT_MAX_SIZE		5
+
+#ifdef CONFIG_SRAM_BASE_ADDRESS
+#define MEM_ADDRESS_BASE	CONFIG_SRAM_BASE_ADDRESS
+#else
+#define MEM_ADDRESS_BASE	0
+#endif
+
+#ifdef CONFIG_ARM
+#define MEMORY_BARRIER()	__DMB()
+#else
+#define MEMORY_BARRIER()	__sync_synchronize()
+#endif
+
+#ifdef CONFIG_PROFILER_NORDIC_RING_BUFFER
+#define RING_BUFFER_SIZE	CONFIG_PROFILER_NORDIC_RING_BUFFER_SIZE
+#define RING_BUFFER_MASK	(RING_BUFFER_SIZE - 1)
+/* Size of the record length field in the ring buffer. */
+#define RING_HEADER_SIZE	sizeof(u8_t)
+
+BUILD_ASSERT((RING_BUFFER_SIZE & RING_BUFFER_MASK) == 0,
+	     "Ring buffer size must be a power of two");
+BUILD_ASSERT(CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN <= UCHAR_MAX,
+	     "Record length must fit in the ring buffer header");
+
+/* Records staged for the profiler thread. Each record is preceded by
+ * its length, which is written last and marks the record as committed.
+ * Indexes are free running and masked on access.
+ */
+static u8_t ring_buf[RING_BUFFER_SIZE];
+static atomic_t ring_reserve_idx;
+static atomic_t ring_read_idx;
+#endif
+
 static K_SEM_DEFINE(profiler_sem, 0, 1);
 static bool protocol_running;
 static bool sending_events;
+static u32_t last_timestamp;
+static atomic_t dropped_records;
+/* Event type IDs assigned and descriptions completed. */
+static atomic_t descr_reserved;
+static atomic_t descr_ready;
 
 enum nordic_command {
 	NORDIC_COMMAND_START	= 1,
@@ -46,17 +89,13 @@ static char *arg_types_encodings[] = {
 
 u8_t profiler_num_events;
 
-static u8_t buffer_data[CONFIG_PROFILER_NORDIC_DATA_BUFFER_SIZE];
-static u8_t buffer_info[CONFIG_PROFILER_NORDIC_INFO_BUFFER_SIZE];
-static u8_t buffer_commands[CONFIG_PROFILER_NORDIC_COMMAND_BUFFER_SIZE];
-
 static k_tid_t protocol_thread_id;
 
 static K_THREAD_STACK_DEFINE(profiler_nordic_stack,
 			     CONFIG_PROFILER_NORDIC_STACK_SIZE);
 static struct k_thread profiler_nordic_thread;
 
-static void send_system_description(void)
+void profiler_nordic_description_send(void)
 {
 	size_t num_bytes_send;
 
@@ -65,89 +104,219 @@ static void send_system_description(void)
 	 */
 	u8_t ne = profiler_num_events;
 
-	__DMB();
+	MEMORY_BARRIER();
 	char end_line = '\n';
 
+	if (IS_ENABLED(CONFIG_PROFILER_NORDIC_COMPACT_ENCODING)) {
+		/* Header informing the host about the record encoding. */
+		char header[32];
+		size_t len = snprintf(header, sizeof(header), "#compact,%u\n",
+				      (u32_t)MEM_ADDRESS_BASE);
+
+		__ASSERT_NO_MSG(len < sizeof(header));
+		num_bytes_send = profiler_nordic_transport_info_write(
+				  (const u8_t *)header,
+				  len);
+		__ASSERT_NO_MSG(num_bytes_send > 0);
+	}
+
 	for (size_t t = 0; t < ne; t++) {
-		num_bytes_send = SEGGER_RTT_WriteNoLock(
-				  CONFIG_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-				  descr[t],
+		num_bytes_send = profiler_nordic_transport_info_write(
+				  (const u8_t *)descr[t],
 				  strlen(descr[t]));
 		__ASSERT_NO_MSG(num_bytes_send > 0);
-		num_bytes_send = SEGGER_RTT_WriteNoLock(
-				  CONFIG_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-				  &end_line,
+		num_bytes_send = profiler_nordic_transport_info_write(
+				  (const u8_t *)&end_line,
 				  1);
 		__ASSERT_NO_MSG(num_bytes_send > 0);
 	}
-	num_bytes_send = SEGGER_RTT_WriteNoLock(
-			  CONFIG_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-			  &end_line,
+	num_bytes_send = profiler_nordic_transport_info_write(
+			  (const u8_t *)&end_line,
 			  1);
 	__ASSERT_NO_MSG(num_bytes_send > 0);
 }
 
+static inline u32_t zigzag_encode(s32_t value)
+{
+	return ((u32_t)value << 1) ^ (u32_t)(value >> 31);
+}
+
+static size_t varint_encode(u8_t *dst, u32_t value)
+{
+	size_t len = 0;
+
+	while (value >= 0x80) {
+		dst[len++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	dst[len++] = value;
+
+	return len;
+}
+
+/* Encode the record timestamp and write the record to the transport.
+ * Called with interrupts locked, or from the profiler thread only
+ * when the ring buffer is used.
+ */
+static size_t record_write(u8_t *record, size_t len)
+{
+	u8_t *start = record;
+	u32_t timestamp = 0;
+
+	if (IS_ENABLED(CONFIG_PROFILER_NORDIC_COMPACT_ENCODING)) {
+		/* Records may be sent in a different order than
+		 * timestamps were taken, hence the signed delta.
+		 */
+		u8_t type_id = record[0];
+		u8_t delta[VARINT_MAX_SIZE];
+		size_t delta_len;
+
+		timestamp = sys_get_le32(start + TYPE_ID_SIZE);
+		delta_len = varint_encode(delta, zigzag_encode(
+				(s32_t)(timestamp - last_timestamp)));
+		start += TYPE_ID_SIZE + VARINT_MAX_SIZE - delta_len;
+		memcpy(start, delta, delta_len);
+		start -= TYPE_ID_SIZE;
+		start[0] = type_id;
+	}
+
+	size_t num_bytes_send = profiler_nordic_transport_data_write(
+			start,
+			record + len - start);
+
+	if (num_bytes_send > 0) {
+		last_timestamp = timestamp;
+	}
+
+	return num_bytes_send;
+}
+
+#ifdef CONFIG_PROFILER_NORDIC_RING_BUFFER
+static bool ring_buffer_put(const u8_t *record, size_t len)
+{
+	atomic_val_t reserve_idx;
+	size_t total_len = RING_HEADER_SIZE + len;
+
+	/* Reserve space, the read index only moves forward in between,
+	 * so free space can only be underestimated.
+	 */
+	do {
+		reserve_idx = atomic_get(&ring_reserve_idx);
+		if ((u32_t)(reserve_idx + total_len -
+			    atomic_get(&ring_read_idx)) > RING_BUFFER_SIZE) {
+			return false;
+		}
+	} while (!atomic_cas(&ring_reserve_idx, reserve_idx,
+			     reserve_idx + total_len));
+
+	for (size_t i = 0; i < len; i++) {
+		ring_buf[(reserve_idx + RING_HEADER_SIZE + i) &
+			 RING_BUFFER_MASK] = record[i];
+	}
+
+	/* Commit the record once its content is visible. */
+	MEMORY_BARRIER();
+	ring_buf[reserve_idx & RING_BUFFER_MASK] = len;
+
+	return true;
+}
+
+static void ring_buffer_flush(void)
+{
+	u8_t record[CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN];
+	atomic_val_t read_idx = atomic_get(&ring_read_idx);
+
+	while (read_idx != atomic_get(&ring_reserve_idx)) {
+		size_t len = ring_buf[read_idx & RING_BUFFER_MASK];
+
+		if (len == 0) {
+			/* Record reserved, but not yet committed. */
+			break;
+		}
+
+		MEMORY_BARRIER();
+		for (size_t i = 0; i < len; i++) {
+			record[i] = ring_buf[(read_idx + RING_HEADER_SIZE + i) &
+					     RING_BUFFER_MASK];
+		}
+
+		if (record_write(record, len) == 0) {
+			/* Transport is full, retry in the next period. */
+			break;
+		}
+
+		/* Clear the record. Stale data could otherwise be taken as
+		 * the header of a record that is not yet committed.
+		 */
+		for (size_t i = 0; i < RING_HEADER_SIZE + len; i++) {
+			ring_buf[(read_idx + i) & RING_BUFFER_MASK] = 0;
+		}
+
+		read_idx += RING_HEADER_SIZE + len;
+		MEMORY_BARRIER();
+		atomic_set(&ring_read_idx, read_idx);
+	}
+}
+#endif
+
 static void profiler_nordic_thread_fn(void)
 {
 	while (protocol_running) {
 		u8_t read_data;
 		enum nordic_command command;
 
-		if (SEGGER_RTT_Read(
-		     CONFIG_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
-		     &read_data, sizeof(read_data))) {
+		if (profiler_nordic_transport_command_read(&read_data,
+							   sizeof(read_data))) {
 			command = (enum nordic_command)read_data;
 			switch (command) {
 			case NORDIC_COMMAND_START:
+			{
+				int key = irq_lock();
+
+				/* Host starts decoding timestamp deltas
+				 * from zero.
+				 */
+				if (!sending_events) {
+					last_timestamp = 0;
+				}
 				sending_events = true;
+				irq_unlock(key);
 				break;
+			}
 			case NORDIC_COMMAND_STOP:
 				sending_events = false;
 				break;
 			case NORDIC_COMMAND_INFO:
-				send_system_description();
+				profiler_nordic_description_send();
 				break;
 			default:
 				__ASSERT_NO_MSG(false);
 				break;
 			}
 		}
+
+#ifdef CONFIG_PROFILER_NORDIC_RING_BUFFER
+		ring_buffer_flush();
+		k_sleep(K_MSEC(CONFIG_PROFILER_NORDIC_RING_BUFFER_FLUSH_PERIOD));
+#else
 		k_sleep(K_MSEC(500));
+#endif
 	}
 	k_sem_give(&profiler_sem);
 }
 
 int profiler_init(void)
 {
+	int ret = profiler_nordic_transport_init();
+
+	if (ret) {
+		return ret;
+	}
+
 	protocol_running = true;
 	if (IS_ENABLED(CONFIG_PROFILER_NORDIC_START_LOGGING_ON_SYSTEM_START)) {
 		sending_events = true;
 	}
-	int ret;
-
-	ret = SEGGER_RTT_ConfigUpBuffer(
-		CONFIG_PROFILER_NORDIC_RTT_CHANNEL_DATA,
-		"Nordic profiler data",
-		buffer_data,
-		CONFIG_PROFILER_NORDIC_DATA_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
-
-	ret = SEGGER_RTT_ConfigUpBuffer(
-		CONFIG_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-		"Nordic profiler info",
-		buffer_info,
-		CONFIG_PROFILER_NORDIC_INFO_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
-
-	ret = SEGGER_RTT_ConfigDownBuffer(
-		CONFIG_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
-		"Nordic profiler command",
-		buffer_commands,
-		CONFIG_PROFILER_NORDIC_COMMAND_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
 
 	protocol_thread_id =  k_thread_create(&profiler_nordic_thread,
 			profiler_nordic_stack,
@@ -171,15 +340,33 @@ const char *profiler_get_event_descr(size_t profiler_event_id)
 	return descr[profiler_event_id];
 }
 
+static void descriptions_publish(void)
+{
+	/* Descriptions are published in order of IDs, when all previous
+	 * descriptions are complete.
+	 */
+	u32_t missing = ~(u32_t)atomic_get(&descr_ready);
+	u8_t ready_cnt = missing ? (find_lsb_set(missing) - 1) : 32;
+	u8_t cur_cnt = __atomic_load_n(&profiler_num_events, __ATOMIC_SEQ_CST);
+
+	while ((cur_cnt < ready_cnt) &&
+	       !__atomic_compare_exchange_n(&profiler_num_events, &cur_cnt,
+					    ready_cnt, false, __ATOMIC_SEQ_CST,
+					    __ATOMIC_SEQ_CST)) {
+		/* cur_cnt is updated on failure. */
+	}
+}
+
 u16_t profiler_register_event_type(const char *name, const char **args,
 				   const enum profiler_arg *arg_types,
 				   u8_t arg_cnt)
 {
-	/* Lock to make sure that this function can be called
-	 * from multiple threads
+	/* Atomic ID assignment makes this function safe to call from
+	 * multiple threads without locking the scheduler.
 	 */
-	k_sched_lock();
-	u8_t ne = profiler_num_events;
+	u8_t ne = atomic_inc(&descr_reserved);
+
+	__ASSERT_NO_MSG(ne < CONFIG_MAX_NUMBER_OF_CUSTOM_EVENTS);
 	size_t temp = snprintf(descr[ne],
 			CONFIG_MAX_LENGTH_OF_CUSTOM_EVENTS_DESCRIPTIONS,
 			"%s,%d", name, ne);
@@ -210,15 +397,35 @@ u16_t profiler_register_event_type(const char *name, const char **args,
 	/* Memory barrier to make sure that data is visible
 	 * before being accessed
 	 */
-	__DMB();
-	profiler_num_events++;
-	k_sched_unlock();
+	MEMORY_BARRIER();
+	atomic_set_bit(&descr_ready, ne);
+	descriptions_publish();
 
 	return ne;
 }
 
+u32_t profiler_nordic_dropped_records_get(void)
+{
+	return atomic_get(&dropped_records);
+}
+
 void profiler_log_start(struct log_event_buf *buf)
 {
+	if (IS_ENABLED(CONFIG_PROFILER_NORDIC_COMPACT_ENCODING)) {
+		/* Reserve space for event type ID and timestamp delta.
+		 * The delta can only be computed when the record is sent,
+		 * until then the absolute timestamp is kept in its place.
+		 */
+		BUILD_ASSERT(TYPE_ID_SIZE + VARINT_MAX_SIZE <=
+			     CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN,
+			     "Custom event buffer is too small");
+		sys_put_le32(k_cycle_get_32(),
+			     buf->payload_start + TYPE_ID_SIZE);
+		buf->payload = buf->payload_start + TYPE_ID_SIZE +
+			       VARINT_MAX_SIZE;
+		return;
+	}
+
 	/* Adding one to pointer to make space for event type ID */
 	__ASSERT_NO_MSG(sizeof(u8_t) <= CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN);
 	buf->payload = buf->payload_start + sizeof(u8_t);
@@ -227,16 +434,49 @@ void profiler_log_start(struct log_event_buf *buf)
 
 void profiler_log_encode_u32(struct log_event_buf *buf, u32_t data)
 {
+	if (IS_ENABLED(CONFIG_PROFILER_NORDIC_COMPACT_ENCODING)) {
+		/* Signedness is not known here. Zigzag encoding keeps both
+		 * small unsigned and small negative values short.
+		 */
+		__ASSERT_NO_MSG(buf->payload - buf->payload_start +
+				VARINT_MAX_SIZE
+				<= CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN);
+		buf->payload += varint_encode(buf->payload,
+					      zigzag_encode((s32_t)data));
+		return;
+	}
+
 	__ASSERT_NO_MSG(buf->payload - buf->payload_start + sizeof(data)
 			 <= CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN);
 	sys_put_le32(data, buf->payload);
 	buf->payload += sizeof(data);
 }
 
+void profiler_log_encode_string(struct log_event_buf *buf,
+				const char *string)
+{
+	/* Length byte followed by the characters, without terminator. */
+	size_t room = CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN -
+		      (buf->payload - buf->payload_start);
+
+	__ASSERT_NO_MSG(room >= sizeof(u8_t));
+	size_t len = MIN(strlen(string), MIN(room - 1, UINT8_MAX));
+
+	*buf->payload++ = len;
+	memcpy(buf->payload, string, len);
+	buf->payload += len;
+}
+
 void profiler_log_add_mem_address(struct log_event_buf *buf,
 				  const void *mem_address)
 {
-	profiler_log_encode_u32(buf, (u32_t)mem_address);
+	if (IS_ENABLED(CONFIG_PROFILER_NORDIC_COMPACT_ENCODING)) {
+		/* Offset from RAM start is shorter, host adds the base. */
+		profiler_log_encode_u32(buf,
+				(u32_t)mem_address - (u32_t)MEM_ADDRESS_BASE);
+	} else {
+		profiler_log_encode_u32(buf, (u32_t)mem_address);
+	}
 }
 
 void profiler_log_send(struct log_event_buf *buf, u16_t event_type_id)
@@ -244,16 +484,23 @@ void profiler_log_send(struct log_event_buf *buf, u16_t event_type_id)
 	__ASSERT_NO_MSG(event_type_id <= UCHAR_MAX);
 	if (sending_events) {
 		u8_t type_id = event_type_id & UCHAR_MAX;
+		size_t len = buf->payload - buf->payload_start;
 
 		buf->payload_start[0] = type_id;
+
+#ifdef CONFIG_PROFILER_NORDIC_RING_BUFFER
+		/* Stage the record, timestamp is encoded while flushing. */
+		if (!ring_buffer_put(buf->payload_start, len)) {
+			atomic_inc(&dropped_records);
+		}
+#else
 		int key = irq_lock();
 
-		u8_t num_bytes_send = SEGGER_RTT_WriteNoLock(
-				CONFIG_PROFILER_NORDIC_RTT_CHANNEL_DATA,
-				buf->payload_start,
-				buf->payload - buf->payload_start);
-		ARG_UNUSED(num_bytes_send);
+		if (record_write(buf->payload_start, len) == 0) {
+			/* Record skipped, the transport cannot take it. */
+			atomic_inc(&dropped_records);
+		}
 		irq_unlock(key);
-		__ASSERT_NO_MSG(num_bytes_send > 0);
+#endif
 	}
 }
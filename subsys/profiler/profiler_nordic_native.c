@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <zephyr.h>
+
+#include "cmdline.h"
+#include "soc.h"
+
+#include "profiler_nordic_transport.h"
+
+#define DEFAULT_DATA_PATH	"profiler_data.bin"
+#define DEFAULT_INFO_PATH	"profiler_info.txt"
+
+
+static const char *data_path = DEFAULT_DATA_PATH;
+static const char *info_path = DEFAULT_INFO_PATH;
+static const char *commands_path;
+
+static int data_fd = -1;
+static int info_fd = -1;
+static int commands_fd = -1;
+
+
+static int output_open(const char *path)
+{
+	/* FIFO is opened the same way as a regular file. Opening blocks
+	 * until the host opens the other end.
+	 */
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if (fd < 0) {
+		printk("Cannot open profiler output %s (%d)\n", path, errno);
+	}
+
+	return fd;
+}
+
+int profiler_nordic_transport_init(void)
+{
+	/* Host closing the pipe must not terminate the application. */
+	signal(SIGPIPE, SIG_IGN);
+
+	data_fd = output_open(data_path);
+	if (data_fd < 0) {
+		return -EIO;
+	}
+
+	info_fd = output_open(info_path);
+	if (info_fd < 0) {
+		close(data_fd);
+		data_fd = -1;
+		return -EIO;
+	}
+
+	if (commands_path) {
+		commands_fd = open(commands_path, O_RDONLY | O_NONBLOCK);
+		if (commands_fd < 0) {
+			printk("Cannot open profiler commands %s (%d)\n",
+			       commands_path, errno);
+		}
+	}
+
+	return 0;
+}
+
+static size_t fd_write(int fd, const u8_t *data, size_t len)
+{
+	if (fd < 0) {
+		return 0;
+	}
+
+	ssize_t ret = write(fd, data, len);
+
+	return (ret < 0) ? 0 : ret;
+}
+
+size_t profiler_nordic_transport_data_write(const u8_t *data, size_t len)
+{
+	/* The write may block if the host reads the pipe slowly, but the
+	 * simulated time does not advance, so the measurements stay valid.
+	 */
+	return fd_write(data_fd, data, len);
+}
+
+size_t profiler_nordic_transport_info_write(const u8_t *data, size_t len)
+{
+	return fd_write(info_fd, data, len);
+}
+
+size_t profiler_nordic_transport_command_read(u8_t *data, size_t len)
+{
+	if (commands_fd < 0) {
+		return 0;
+	}
+
+	ssize_t ret = read(commands_fd, data, len);
+
+	return (ret < 0) ? 0 : ret;
+}
+
+static void profiler_native_exit(void)
+{
+	if (info_fd < 0) {
+		return;
+	}
+
+	/* Without a command channel the host cannot request descriptions,
+	 * so they are stored when the application exits.
+	 */
+	if (!commands_path) {
+		profiler_nordic_description_send();
+	}
+
+	close(data_fd);
+	close(info_fd);
+	if (commands_fd >= 0) {
+		close(commands_fd);
+	}
+}
+
+static void profiler_native_options(void)
+{
+	static struct args_struct_t profiler_options[] = {
+		{
+			.option = "profiler-data",
+			.name = "path",
+			.type = 's',
+			.dest = (void *)&data_path,
+			.descript = "File or FIFO for profiler event records "
+				    "(default: " DEFAULT_DATA_PATH ")"
+		},
+		{
+			.option = "profiler-info",
+			.name = "path",
+			.type = 's',
+			.dest = (void *)&info_path,
+			.descript = "File or FIFO for profiler event type "
+				    "descriptions (default: "
+				    DEFAULT_INFO_PATH ")"
+		},
+		{
+			.option = "profiler-commands",
+			.name = "path",
+			.type = 's',
+			.dest = (void *)&commands_path,
+			.descript = "FIFO with profiler host commands. If not "
+				    "set, descriptions are stored on exit"
+		},
+		ARG_TABLE_ENDMARKER
+	};
+
+	native_add_command_line_opts(profiler_options);
+}
+
+NATIVE_TASK(profiler_native_options, PRE_BOOT_1, 1);
+NATIVE_TASK(profiler_native_exit, ON_EXIT, 1);
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <zephyr.h>
+#include <SEGGER_RTT.h>
+
+#include "profiler_nordic_transport.h"
+
+
+static u8_t buffer_data[CONFIG_PROFILER_NORDIC_DATA_BUFFER_SIZE];
+static u8_t buffer_info[CONFIG_PROFILER_NORDIC_INFO_BUFFER_SIZE];
+static u8_t buffer_commands[CONFIG_PROFILER_NORDIC_COMMAND_BUFFER_SIZE];
+
+int profiler_nordic_transport_init(void)
+{
+	int ret;
+
+	ret = SEGGER_RTT_ConfigUpBuffer(
+		CONFIG_PROFILER_NORDIC_RTT_CHANNEL_DATA,
+		"Nordic profiler data",
+		buffer_data,
+		CONFIG_PROFILER_NORDIC_DATA_BUFFER_SIZE,
+		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	__ASSERT_NO_MSG(ret >= 0);
+
+	ret = SEGGER_RTT_ConfigUpBuffer(
+		CONFIG_PROFILER_NORDIC_RTT_CHANNEL_INFO,
+		"Nordic profiler info",
+		buffer_info,
+		CONFIG_PROFILER_NORDIC_INFO_BUFFER_SIZE,
+		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	__ASSERT_NO_MSG(ret >= 0);
+
+	ret = SEGGER_RTT_ConfigDownBuffer(
+		CONFIG_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
+		"Nordic profiler command",
+		buffer_commands,
+		CONFIG_PROFILER_NORDIC_COMMAND_BUFFER_SIZE,
+		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	__ASSERT_NO_MSG(ret >= 0);
+
+	return 0;
+}
+
+size_t profiler_nordic_transport_data_write(const u8_t *data, size_t len)
+{
+	return SEGGER_RTT_WriteNoLock(CONFIG_PROFILER_NORDIC_RTT_CHANNEL_DATA,
+				      data, len);
+}
+
+size_t profiler_nordic_transport_info_write(const u8_t *data, size_t len)
+{
+	return SEGGER_RTT_WriteNoLock(CONFIG_PROFILER_NORDIC_RTT_CHANNEL_INFO,
+				      data, len);
+}
+
+size_t profiler_nordic_transport_command_read(u8_t *data, size_t len)
+{
+	return SEGGER_RTT_Read(CONFIG_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
+			       data, len);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+/** @file
+ * @brief Nordic profiler transport interface.
+ *
+ * The Nordic profiler protocol uses three channels: data (event records),
+ * info (event type descriptions) and commands (sent by the host).
+ * A transport implements these channels over a physical link.
+ */
+
+#ifndef _PROFILER_NORDIC_TRANSPORT_H_
+#define _PROFILER_NORDIC_TRANSPORT_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Initialize the transport.
+ *
+ * @return 0 if the operation was successful. Otherwise, a (negative)
+ *	   error code is returned.
+ */
+int profiler_nordic_transport_init(void);
+
+/** @brief Write a record to the data channel.
+ *
+ * The function is called with interrupts locked. The record is either
+ * written as a whole or dropped.
+ *
+ * @param data Pointer to the record.
+ * @param len  Length of the record.
+ *
+ * @return Number of bytes written, 0 if the record was dropped.
+ */
+size_t profiler_nordic_transport_data_write(const u8_t *data, size_t len);
+
+/** @brief Write data to the info channel.
+ *
+ * @param data Pointer to the data.
+ * @param len  Length of the data.
+ *
+ * @return Number of bytes written.
+ */
+size_t profiler_nordic_transport_info_write(const u8_t *data, size_t len);
+
+/** @brief Read data from the command channel.
+ *
+ * The function does not block.
+ *
+ * @param data Pointer to the buffer for the data.
+ * @param len  Size of the buffer.
+ *
+ * @return Number of bytes read.
+ */
+size_t profiler_nordic_transport_command_read(u8_t *data, size_t len);
+
+/** @brief Send descriptions of registered event types on the info channel.
+ *
+ * Implemented by the profiler, can be used by the transport to send
+ * the descriptions without a command from the host.
+ */
+void profiler_nordic_description_send(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PROFILER_NORDIC_TRANSPORT_H_ */
@@ -133,6 +133,18 @@ void profiler_log_encode_u32(struct log_event_buf *buf, u32_t data)
 	buf->payload = SEGGER_SYSVIEW_EncodeU32(buf->payload, data);
 }
 
+void profiler_log_encode_string(struct log_event_buf *buf,
+				const char *string)
+{
+	/* One length byte is used for strings shorter than 255 characters. */
+	size_t room = CONFIG_PROFILER_CUSTOM_EVENT_BUF_LEN -
+		      (buf->payload - buf->payload_start);
+
+	__ASSERT_NO_MSG(room >= sizeof(u8_t));
+	buf->payload = SEGGER_SYSVIEW_EncodeString(buf->payload, string,
+						   MIN(room - 1, 254));
+}
+
 void profiler_log_add_mem_address(struct log_event_buf *buf,
 				  const void *event_mem_address)
 {
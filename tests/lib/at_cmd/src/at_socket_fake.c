@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <zephyr.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <net/socket.h>
+
+#include "at_socket_fake.h"
+
+#define FAKE_AT_FD 1
+
+#define ECHO_CMD "AT+ECHO="
+
+struct fake_msg {
+	char data[64];
+	bool is_response;
+};
+
+K_MSGQ_DEFINE(fake_msgq, sizeof(struct fake_msg), 4, 4);
+
+static atomic_t in_flight;
+static atomic_t sent_count;
+static atomic_t overlap_count;
+
+int fake_at_socket(int family, int type, int proto)
+{
+	if ((family != AF_LTE) || (type != SOCK_DGRAM) ||
+	    (proto != NPROTO_AT)) {
+		errno = EAFNOSUPPORT;
+		return -1;
+	}
+
+	return FAKE_AT_FD;
+}
+
+ssize_t fake_at_send(int sock, const void *buf, size_t len, int flags)
+{
+	struct fake_msg msg = { .is_response = true };
+	char cmd[32];
+
+	if ((sock != FAKE_AT_FD) || (len >= sizeof(cmd))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	atomic_inc(&sent_count);
+
+	if (!atomic_cas(&in_flight, 0, 1)) {
+		atomic_inc(&overlap_count);
+		return len;
+	}
+
+	memcpy(cmd, buf, len);
+	cmd[len] = '\0';
+
+	if (strncmp(cmd, ECHO_CMD, strlen(ECHO_CMD)) == 0) {
+		snprintf(msg.data, sizeof(msg.data), "+ECHO: %s\r\nOK\r\n",
+			 &cmd[strlen(ECHO_CMD)]);
+	} else if (strcmp(cmd, "AT+ERROR") == 0) {
+		strcpy(msg.data, "ERROR\r\n");
+	} else if (strcmp(cmd, "AT+CME") == 0) {
+		strcpy(msg.data, "+CME ERROR: 10\r\n");
+	} else {
+		strcpy(msg.data, "OK\r\n");
+	}
+
+	k_msgq_put(&fake_msgq, &msg, K_FOREVER);
+
+	return len;
+}
+
+ssize_t fake_at_recv(int sock, void *buf, size_t max_len, int flags)
+{
+	struct fake_msg msg;
+	size_t len;
+
+	k_msgq_get(&fake_msgq, &msg, K_FOREVER);
+
+	if (msg.is_response) {
+		k_busy_wait(FAKE_AT_LATENCY_US);
+		atomic_set(&in_flight, 0);
+	}
+
+	len = MIN(strlen(msg.data) + 1, max_len);
+	memcpy(buf, msg.data, len);
+
+	return len;
+}
+
+int fake_at_close(int sock)
+{
+	return 0;
+}
+
+void fake_at_notify(const char *notif)
+{
+	struct fake_msg msg = { .is_response = false };
+
+	strncpy(msg.data, notif, sizeof(msg.data) - 1);
+	k_msgq_put(&fake_msgq, &msg, K_FOREVER);
+}
+
+u32_t fake_at_sent_count_get(void)
+{
+	return atomic_set(&sent_count, 0);
+}
+
+u32_t fake_at_overlap_count_get(void)
+{
+	return atomic_get(&overlap_count);
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef AT_SOCKET_FAKE_H__
+#define AT_SOCKET_FAKE_H__
+
+#include <zephyr/types.h>
+
+/* A fake AT socket, which answers each command after a fixed latency:
+ *
+ * "AT+ECHO=<x>" gets "+ECHO: <x>" and OK.
+ * "AT+ERROR" gets ERROR.
+ * "AT+CME" gets +CME ERROR: 10.
+ * Any other command gets OK.
+ *
+ * Like the modem, it handles one command at a time. A command sent before
+ * the previous one is answered is counted as overlapping, and not answered.
+ */
+
+/** Time the fake modem takes to process a command, in microseconds. */
+#define FAKE_AT_LATENCY_US 200
+
+/** Send a notification to the AT socket. */
+void fake_at_notify(const char *notif);
+
+/** Number of commands received since the last call. */
+u32_t fake_at_sent_count_get(void);
+
+/** Number of commands received before the previous one was answered. */
+u32_t fake_at_overlap_count_get(void);
+
+#endif /* AT_SOCKET_FAKE_H__ */
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef FAKE_SOCKET_H__
+#define FAKE_SOCKET_H__
+
+#include <sys/types.h>
+
+/* Replaces the socket API used by the AT command driver with a fake AT
+ * socket, see at_socket_fake.c.
+ */
+#define AF_LTE     102
+#define SOCK_DGRAM 2
+#define NPROTO_AT  513
+
+#define socket fake_at_socket
+#define send   fake_at_send
+#define recv   fake_at_recv
+#define close  fake_at_close
+
+int fake_at_socket(int family, int type, int proto);
+ssize_t fake_at_send(int sock, const void *buf, size_t len, int flags);
+ssize_t fake_at_recv(int sock, void *buf, size_t max_len, int flags);
+int fake_at_close(int sock);
+
+#endif /* FAKE_SOCKET_H__ */
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <modem/at_cmd.h>
+
+#include "at_socket_fake.h"
+
+#define BENCHMARK_CMD_COUNT 100
+
+#define TIMEOUT K_SECONDS(5)
+
+static K_SEM_DEFINE(cmd_done, 0, BENCHMARK_CMD_COUNT);
+static K_SEM_DEFINE(notif_done, 0, 1);
+
+static struct at_cmd_async *done_order[BENCHMARK_CMD_COUNT];
+static size_t done_count;
+static char responses[4][32];
+static char last_notif[32];
+
+static void done_handler(struct at_cmd_async *cmd, const char *response)
+{
+	if (done_count < ARRAY_SIZE(responses)) {
+		strncpy(responses[done_count], response,
+			sizeof(responses[0]) - 1);
+	}
+
+	done_order[done_count++] = cmd;
+	k_sem_give(&cmd_done);
+}
+
+static void notif_handler(const char *response)
+{
+	strncpy(last_notif, response, sizeof(last_notif) - 1);
+	k_sem_give(&notif_done);
+}
+
+static void wait_done(size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		zassert_equal(k_sem_take(&cmd_done, TIMEOUT), 0,
+			      "Command not completed");
+	}
+
+	zassert_equal(fake_at_overlap_count_get(), 0,
+		      "Command sent before the previous one was answered");
+}
+
+static void async_reset(struct at_cmd_async *cmds, size_t count)
+{
+	memset(cmds, 0, count * sizeof(*cmds));
+	memset(responses, 0, sizeof(responses));
+	done_count = 0;
+	fake_at_sent_count_get();
+
+	for (size_t i = 0; i < count; i++) {
+		cmds[i].handler = done_handler;
+	}
+}
+
+static void test_async_batch(void)
+{
+	static struct at_cmd_async cmds[3];
+
+	async_reset(cmds, ARRAY_SIZE(cmds));
+	cmds[0].cmd = "AT+ECHO=1";
+	cmds[1].cmd = "AT+CFUN=4";
+	cmds[2].cmd = "AT+ECHO=2";
+
+	zassert_equal(at_cmd_write_async(cmds, ARRAY_SIZE(cmds)), 0,
+		      "Not queued");
+	wait_done(ARRAY_SIZE(cmds));
+
+	for (size_t i = 0; i < ARRAY_SIZE(cmds); i++) {
+		zassert_equal(done_order[i], &cmds[i], "Completed out of order");
+		zassert_equal(cmds[i].code, 0, "Command failed");
+		zassert_equal(cmds[i].state, AT_CMD_OK, "Command failed");
+	}
+
+	zassert_equal(strcmp(responses[0], "+ECHO: 1\r\n"), 0,
+		      "Wrong response");
+	zassert_equal(strcmp(responses[1], ""), 0, "Wrong response");
+	zassert_equal(strcmp(responses[2], "+ECHO: 2\r\n"), 0,
+		      "Wrong response");
+	zassert_equal(fake_at_sent_count_get(), 3, "Wrong number sent");
+
+	/* Without handler. */
+	cmds[0].handler = NULL;
+	zassert_equal(at_cmd_write_async(cmds, 1), 0, "Not queued");
+	zassert_equal(at_cmd_write("AT", NULL, 0, NULL), 0, "Command failed");
+	zassert_equal(fake_at_sent_count_get(), 2, "Wrong number sent");
+
+	zassert_equal(at_cmd_write_async(NULL, 1), -EINVAL, "NULL accepted");
+	zassert_equal(at_cmd_write_async(cmds, 0), -EINVAL, "Empty accepted");
+	cmds[0].cmd = NULL;
+	zassert_equal(at_cmd_write_async(cmds, 1), -EINVAL, "NULL accepted");
+}
+
+static void test_async_batch_error(void)
+{
+	static struct at_cmd_async cmds[4];
+
+	async_reset(cmds, ARRAY_SIZE(cmds));
+	cmds[0].cmd = "AT+CFUN=4";
+	cmds[1].cmd = "AT+CME";
+	cmds[2].cmd = "AT+CFUN=1";
+	cmds[3].cmd = "AT+ECHO=3";
+
+	zassert_equal(at_cmd_write_async(cmds, 3), 0, "Not queued");
+	/* Another batch is not cancelled. */
+	zassert_equal(at_cmd_write_async(&cmds[3], 1), 0, "Not queued");
+	wait_done(ARRAY_SIZE(cmds));
+
+	for (size_t i = 0; i < ARRAY_SIZE(cmds); i++) {
+		zassert_equal(done_order[i], &cmds[i], "Completed out of order");
+	}
+
+	zassert_equal(cmds[0].code, 0, "Command failed");
+	zassert_equal(cmds[1].code, 10, "Wrong error");
+	zassert_equal(cmds[1].state, AT_CMD_ERROR_CME, "Wrong error");
+	zassert_equal(cmds[2].code, -ECANCELED, "Not cancelled");
+	zassert_equal(cmds[2].state, AT_CMD_ERROR, "Not cancelled");
+	zassert_equal(strcmp(responses[2], ""), 0, "Wrong response");
+	zassert_equal(cmds[3].code, 0, "Command failed");
+	zassert_equal(strcmp(responses[3], "+ECHO: 3\r\n"), 0,
+		      "Wrong response");
+	zassert_equal(fake_at_sent_count_get(), 3, "Cancelled command sent");
+}
+
+static void test_async_with_sync(void)
+{
+	static struct at_cmd_async cmds[3];
+	char buf[32];
+	int err;
+
+	async_reset(cmds, ARRAY_SIZE(cmds));
+	cmds[0].cmd = "AT+ECHO=1";
+	cmds[1].cmd = "AT+ECHO=2";
+	cmds[2].cmd = "AT+ECHO=3";
+
+	/* The synchronous command waits for the batch, and gets its own
+	 * response. Notifications are received meanwhile.
+	 */
+	zassert_equal(at_cmd_write_async(cmds, ARRAY_SIZE(cmds)), 0,
+		      "Not queued");
+	fake_at_notify("+CEREG: 1");
+
+	err = at_cmd_write("AT+ECHO=4", buf, sizeof(buf), NULL);
+	zassert_equal(err, 0, "Command failed");
+	zassert_equal(strcmp(buf, "+ECHO: 4\r\n"), 0, "Wrong response");
+
+	wait_done(ARRAY_SIZE(cmds));
+	zassert_equal(strcmp(responses[2], "+ECHO: 3\r\n"), 0,
+		      "Wrong response");
+
+	zassert_equal(k_sem_take(&notif_done, TIMEOUT), 0,
+		      "Notification not received");
+	zassert_equal(strcmp(last_notif, "+CEREG: 1"), 0,
+		      "Wrong notification");
+
+	zassert_equal(fake_at_sent_count_get(), 4, "Wrong number sent");
+
+	/* The synchronous command waits for a batch that fails. */
+	async_reset(cmds, 1);
+	cmds[0].cmd = "AT+ERROR";
+	zassert_equal(at_cmd_write_async(cmds, 1), 0, "Not queued");
+	err = at_cmd_write("AT+ECHO=5", buf, sizeof(buf), NULL);
+	zassert_equal(err, 0, "Command failed");
+	zassert_equal(strcmp(buf, "+ECHO: 5\r\n"), 0, "Wrong response");
+	wait_done(1);
+	zassert_equal(cmds[0].code, -ENOEXEC, "Wrong error");
+
+	zassert_equal(fake_at_sent_count_get(), 2, "Wrong number sent");
+}
+
+static struct at_cmd_async work_cmds[2];
+static K_SEM_DEFINE(work_cmds_done, 0, ARRAY_SIZE(work_cmds));
+static K_SEM_DEFINE(work_done, 0, 1);
+static int work_err;
+
+static void work_fn(struct k_work *work)
+{
+	work_err = at_cmd_write_async(work_cmds, ARRAY_SIZE(work_cmds));
+
+	for (size_t i = 0; (work_err == 0) && (i < ARRAY_SIZE(work_cmds));
+	     i++) {
+		work_err = k_sem_take(&work_cmds_done, TIMEOUT);
+	}
+
+	k_sem_give(&work_done);
+}
+
+static void test_async_done_on_work_queue(void)
+{
+	static struct k_work work;
+
+	/* The done semaphore is given by the AT socket thread, so a batch can
+	 * be waited for on the system work queue, which calls the handlers.
+	 */
+	memset(work_cmds, 0, sizeof(work_cmds));
+	work_cmds[0].cmd = "AT+ECHO=1";
+	work_cmds[0].done = &work_cmds_done;
+	work_cmds[1].cmd = "AT+ECHO=2";
+	work_cmds[1].done = &work_cmds_done;
+
+	k_work_init(&work, work_fn);
+	k_work_submit(&work);
+
+	zassert_equal(k_sem_take(&work_done, TIMEOUT), 0, "Work not done");
+	zassert_equal(work_err, 0, "Batch not completed");
+	zassert_equal(work_cmds[1].code, 0, "Command failed");
+	zassert_equal(fake_at_sent_count_get(), 2, "Wrong number sent");
+}
+
+#define STREAM_ROUNDS 50
+
+static struct at_cmd_async stream_cmds[2][2];
+static atomic_t stream_rounds;
+
+static void stream_handler(struct at_cmd_async *cmd, const char *response)
+{
+	struct at_cmd_async *batch = cmd->user_data;
+
+	/* Queue the batch again when its last command is done, so that there
+	 * is always another batch queued.
+	 */
+	if ((cmd == &batch[1]) &&
+	    (atomic_inc(&stream_rounds) < STREAM_ROUNDS)) {
+		(void)at_cmd_write_async(batch, 2);
+	}
+}
+
+static void test_async_sync_not_starved(void)
+{
+	u32_t rounds;
+
+	memset(stream_cmds, 0, sizeof(stream_cmds));
+	atomic_set(&stream_rounds, 0);
+
+	for (size_t i = 0; i < ARRAY_SIZE(stream_cmds); i++) {
+		for (size_t j = 0; j < ARRAY_SIZE(stream_cmds[i]); j++) {
+			stream_cmds[i][j].cmd = "AT+CFUN?";
+			stream_cmds[i][j].handler = stream_handler;
+			stream_cmds[i][j].user_data = stream_cmds[i];
+		}
+	}
+
+	zassert_equal(at_cmd_write_async(stream_cmds[0], 2), 0, "Not queued");
+	zassert_equal(at_cmd_write_async(stream_cmds[1], 2), 0, "Not queued");
+
+	/* Sent after the batch being sent, not after the whole stream. */
+	zassert_equal(at_cmd_write("AT", NULL, 0, NULL), 0, "Command failed");
+	rounds = atomic_get(&stream_rounds);
+	zassert_true(rounds < STREAM_ROUNDS,
+		     "Blocking write waited for %u batches", rounds);
+
+	/* Both batches stop being queued again. */
+	while (atomic_get(&stream_rounds) < STREAM_ROUNDS + 1) {
+		k_sleep(K_MSEC(1));
+	}
+	k_sleep(K_MSEC(10));
+
+	zassert_equal(fake_at_overlap_count_get(), 0,
+		      "Command sent before the previous one was answered");
+	(void)fake_at_sent_count_get();
+}
+
+/* Compare the command rate of a thread that waits for each result with the
+ * rate of a queued batch. The fake modem takes the same time for each command
+ * in both cases, so the difference is the time it is idle between commands.
+ */
+static void test_async_benchmark(void)
+{
+	static struct at_cmd_async cmds[BENCHMARK_CMD_COUNT];
+	u32_t start;
+	u32_t sync_us;
+	u32_t async_us;
+
+	start = k_cycle_get_32();
+	for (size_t i = 0; i < BENCHMARK_CMD_COUNT; i++) {
+		zassert_equal(at_cmd_write("AT+CFUN?", NULL, 0, NULL), 0,
+			      "Command failed");
+	}
+	sync_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	async_reset(cmds, ARRAY_SIZE(cmds));
+	for (size_t i = 0; i < ARRAY_SIZE(cmds); i++) {
+		cmds[i].cmd = "AT+CFUN?";
+	}
+
+	start = k_cycle_get_32();
+	zassert_equal(at_cmd_write_async(cmds, ARRAY_SIZE(cmds)), 0,
+		      "Not queued");
+	wait_done(ARRAY_SIZE(cmds));
+	async_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cmds); i++) {
+		zassert_equal(cmds[i].code, 0, "Command failed");
+	}
+
+	TC_PRINT("%d commands, %d us modem latency each\n",
+		 BENCHMARK_CMD_COUNT, FAKE_AT_LATENCY_US);
+	TC_PRINT("at_cmd_write: %u us, %u commands/s\n", sync_us,
+		 (u32_t)(BENCHMARK_CMD_COUNT * USEC_PER_SEC / MAX(sync_us, 1)));
+	TC_PRINT("at_cmd_write_async: %u us, %u commands/s\n", async_us,
+		 (u32_t)(BENCHMARK_CMD_COUNT * USEC_PER_SEC / MAX(async_us, 1)));
+}
+
+void test_main(void)
+{
+	zassert_equal(at_cmd_init(), 0, "Initialization failed");
+	at_cmd_set_notification_handler(notif_handler);
+
+	ztest_test_suite(at_cmd,
+			 ztest_unit_test(test_async_batch),
+			 ztest_unit_test(test_async_batch_error),
+			 ztest_unit_test(test_async_with_sync),
+			 ztest_unit_test(test_async_done_on_work_queue),
+			 ztest_unit_test(test_async_sync_not_starved),
+			 ztest_unit_test(test_async_benchmark)
+	);
+
+	ztest_run_test_suite(at_cmd);
+}
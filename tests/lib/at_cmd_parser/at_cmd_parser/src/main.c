@@ -15,6 +15,10 @@
 #define EMPTYPARAMLINE_PARAM_COUNT  6
 #define CERTIFICATE_PARAM_COUNT     5
 
+#define XMONITOR_PARAM_COUNT        17
+#define BUF_LIST_VALUES_SIZE        128
+#define BENCHMARK_ITERATIONS        1000
+
 const char *singleline = "+CEREG: 2,\"76C1\",\"0102DA04\", 7\r\n";
 const char *multiline =  "+CGEQOSRDP: 0,0,,\r\n"
 			 "+CGEQOSRDP: 1,2,,\r\n"
@@ -29,9 +33,31 @@ const char *certificate = "%CMNG: 12345678, 0, \"978C...02C4\","
 			  "...bW9aAa4"
 			  "-----END CERTIFICATE-----\"\r\n";
 
+const char *xmonitor = "%XMONITOR: 1,\"EDAV\",\"EDAV\",\"24202\",\"0901\",7,"
+		       "20,\"02024720\",402,6400,53,24,\"\",\"11100000\","
+		       "\"00010011\",\"01011111\"\r\n";
+
 static struct at_param_list test_list;
 static struct at_param_list test_list2;
 
+/* Allocations, counted by wrapping the allocation functions at link time. */
+static u32_t alloc_count;
+
+void *__real_k_malloc(size_t size);
+void *__real_k_calloc(size_t nmemb, size_t size);
+
+void *__wrap_k_malloc(size_t size)
+{
+	alloc_count++;
+	return __real_k_malloc(size);
+}
+
+void *__wrap_k_calloc(size_t nmemb, size_t size)
+{
+	alloc_count++;
+	return __real_k_calloc(nmemb, size);
+}
+
 static void test_params_fail_on_invalid_input_setup(void)
 {
 	at_params_list_init(&test_list, TEST_PARAMS);
@@ -727,6 +753,164 @@ static void test_at_cmd_test_teardown(void)
 	at_params_list_free(&test_list2);
 }
 
+/* Check that two lists hold the same parameters. */
+static void params_compare(const struct at_param_list *list,
+			   const struct at_param_list *ref)
+{
+	char buf[256];
+	char ref_buf[256];
+	size_t len;
+	size_t ref_len;
+	u32_t val;
+	u32_t ref_val;
+
+	zassert_equal(at_params_valid_count_get(ref),
+		      at_params_valid_count_get(list),
+		      "Params valid count should be the same");
+
+	for (size_t i = 0; i < ref->param_count; i++) {
+		enum at_param_type type = at_params_type_get(ref, i);
+
+		zassert_equal(type, at_params_type_get(list, i),
+			      "Param type should be the same");
+
+		zassert_equal(0, at_params_size_get(ref, i, &ref_len),
+			      "Get size should not fail");
+		zassert_equal(0, at_params_size_get(list, i, &len),
+			      "Get size should not fail");
+		zassert_equal(ref_len, len, "Param size should be the same");
+
+		if (type == AT_PARAM_TYPE_STRING) {
+			zassert_equal(0, at_params_string_get(ref, i, ref_buf,
+							      &ref_len),
+				      "Get string should not fail");
+			zassert_equal(0, at_params_string_get(list, i, buf,
+							      &len),
+				      "Get string should not fail");
+			zassert_mem_equal(ref_buf, buf, len,
+					  "String should be the same");
+		} else if (type == AT_PARAM_TYPE_ARRAY) {
+			zassert_equal(0, at_params_array_get(ref, i,
+						(u32_t *)ref_buf, &ref_len),
+				      "Get array should not fail");
+			zassert_equal(0, at_params_array_get(list, i,
+						(u32_t *)buf, &len),
+				      "Get array should not fail");
+			zassert_mem_equal(ref_buf, buf, len,
+					  "Array should be the same");
+		} else if ((type == AT_PARAM_TYPE_NUM_SHORT) ||
+			   (type == AT_PARAM_TYPE_NUM_INT)) {
+			zassert_equal(0, at_params_int_get(ref, i, &ref_val),
+				      "Get int should not fail");
+			zassert_equal(0, at_params_int_get(list, i, &val),
+				      "Get int should not fail");
+			zassert_equal(ref_val, val,
+				      "Number should be the same");
+		}
+	}
+}
+
+static void test_params_buf_list(void)
+{
+	static u8_t buf[AT_PARAMS_LIST_BUF_SIZE(XMONITOR_PARAM_COUNT,
+						BUF_LIST_VALUES_SIZE)];
+	static u8_t small_buf[AT_PARAMS_LIST_BUF_SIZE(XMONITOR_PARAM_COUNT,
+						      16)];
+	const char *const strings[] = {
+		singleline, multiline, pduline, singleparamline,
+		emptyparamline, certificate, xmonitor,
+		"+CEDRXP: 4,\"1000\",\"0101\",\"1011\"\r\n",
+		"%CMNG: (0-2147483647),(0-6)\r\n",
+	};
+	struct at_param_list list;
+	struct at_param_list ref;
+	u32_t count;
+	int err;
+
+	zassert_equal(0, at_params_list_init_buf(&list, XMONITOR_PARAM_COUNT,
+						 buf, sizeof(buf)),
+		      "Not able to initialize params list");
+	zassert_equal(0, at_params_list_init(&ref, XMONITOR_PARAM_COUNT),
+		      "Not able to initialize params list");
+
+	for (size_t i = 0; i < ARRAY_SIZE(strings); i++) {
+		err = at_parser_params_from_str(strings[i], NULL, &ref);
+
+		count = alloc_count;
+		zassert_equal(err, at_parser_params_from_str(strings[i], NULL,
+							     &list),
+			      "Parsing should give the same result");
+		zassert_equal(count, alloc_count,
+			      "Parsing into a buffer should not allocate");
+
+		params_compare(&list, &ref);
+	}
+
+	at_params_list_free(&ref);
+	at_params_list_free(&list);
+
+	/* The values of the notification do not fit. */
+	zassert_equal(0, at_params_list_init_buf(&list, XMONITOR_PARAM_COUNT,
+						 small_buf, sizeof(small_buf)),
+		      "Not able to initialize params list");
+	zassert_equal(-ENOMEM, at_parser_params_from_str(xmonitor, NULL,
+							 &list),
+		      "at_parser_params_from_str should return -ENOMEM");
+	zassert_equal(0, at_parser_params_from_str("+CSCON: 1\r\n", NULL,
+						   &list),
+		      "at_parser_params_from_str should return 0");
+	at_params_list_free(&list);
+}
+
+/* Compare parsing a notification into an allocated list and into a buffer. */
+static void test_params_parse_benchmark(void)
+{
+	static u8_t buf[AT_PARAMS_LIST_BUF_SIZE(XMONITOR_PARAM_COUNT,
+						BUF_LIST_VALUES_SIZE)];
+	struct at_param_list list;
+	u32_t start;
+	u32_t cycles;
+	u32_t count;
+
+	zassert_equal(0, at_params_list_init(&list, XMONITOR_PARAM_COUNT),
+		      "Not able to initialize params list");
+
+	count = alloc_count;
+	start = k_cycle_get_32();
+	for (size_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		zassert_equal(0, at_parser_params_from_str(xmonitor, NULL,
+							   &list),
+			      "Parsing should not fail");
+	}
+	cycles = k_cycle_get_32() - start;
+	count = alloc_count - count;
+
+	TC_PRINT("Allocated list: %u cycles, %u allocations per parse\n",
+		 cycles / BENCHMARK_ITERATIONS, count / BENCHMARK_ITERATIONS);
+
+	at_params_list_free(&list);
+
+	zassert_equal(0, at_params_list_init_buf(&list, XMONITOR_PARAM_COUNT,
+						 buf, sizeof(buf)),
+		      "Not able to initialize params list");
+
+	count = alloc_count;
+	start = k_cycle_get_32();
+	for (size_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		zassert_equal(0, at_parser_params_from_str(xmonitor, NULL,
+							   &list),
+			      "Parsing should not fail");
+	}
+	cycles = k_cycle_get_32() - start;
+	count = alloc_count - count;
+
+	TC_PRINT("List in a buffer: %u cycles, %u allocations per parse\n",
+		 cycles / BENCHMARK_ITERATIONS, count / BENCHMARK_ITERATIONS);
+	zassert_equal(0, count, "Parsing into a buffer should not allocate");
+
+	at_params_list_free(&list);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(at_cmd_parser,
@@ -757,7 +941,9 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 				test_at_cmd_test,
 				test_at_cmd_test_setup,
-				test_at_cmd_test_teardown)
+				test_at_cmd_test_teardown),
+			 ztest_unit_test(test_params_buf_list),
+			 ztest_unit_test(test_params_parse_benchmark)
 			);
 
 	ztest_run_test_suite(at_cmd_parser);
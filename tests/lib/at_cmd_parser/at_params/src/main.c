@@ -414,6 +414,71 @@ static void test_params_list_management_teardown(void)
 	at_params_list_free(&test_list);
 }
 
+static void test_params_list_buf(void)
+{
+	static u8_t buf[AT_PARAMS_LIST_BUF_SIZE(TEST_PARAMS, 12)];
+	struct at_param_list list;
+	u32_t array[2] = { 1, 2 };
+	char tmp_str[8];
+	size_t len;
+
+	zassert_equal(-EINVAL, at_params_list_init_buf(NULL, TEST_PARAMS, buf,
+						       sizeof(buf)),
+		      "Init function initializes with NULL parameter");
+	zassert_equal(-EINVAL, at_params_list_init_buf(&list, TEST_PARAMS,
+						       NULL, sizeof(buf)),
+		      "Init function initializes with NULL buffer");
+	zassert_equal(-ENOMEM, at_params_list_init_buf(&list, TEST_PARAMS,
+						       buf, 8),
+		      "Init function initializes with too small buffer");
+
+	zassert_equal(0, at_params_list_init_buf(&list, TEST_PARAMS, buf,
+						 sizeof(buf)),
+		      "Not able to initialize params list");
+	zassert_equal(TEST_PARAMS, list.param_count,
+		      "Params count should be the same as TEST_PARAMS");
+	zassert_equal(0, at_params_valid_count_get(&list),
+		      "Params valid count should return 0");
+
+	/* 4 bytes for the string, 8 for the array. */
+	zassert_equal(0, at_params_string_put(&list, 0, "abc", 3),
+		      "at_params_string_put should return 0");
+	zassert_equal(0, at_params_array_put(&list, 1, array, sizeof(array)),
+		      "at_params_array_put should return 0");
+	/* Larger than the space left for alignment. */
+	zassert_equal(-ENOMEM, at_params_string_put(&list, 2,
+						    "defghijklmnopqrs",
+						    sizeof(void *) + 1),
+		      "at_params_string_put should return -ENOMEM");
+	zassert_equal(0, at_params_int_put(&list, 2, 1),
+		      "at_params_int_put should return 0");
+
+	len = sizeof(tmp_str);
+	zassert_equal(0, at_params_string_get(&list, 0, tmp_str, &len),
+		      "at_params_string_get should return 0");
+	zassert_equal(3, len, "String length should be 3");
+	zassert_mem_equal("abc", tmp_str, len, "String should be abc");
+
+	memset(array, 0, sizeof(array));
+	len = sizeof(array);
+	zassert_equal(0, at_params_array_get(&list, 1, array, &len),
+		      "at_params_array_get should return 0");
+	zassert_equal(2, array[1], "Array should be copied");
+
+	/* Clearing the list frees the values. */
+	at_params_list_clear(&list);
+	zassert_equal(0, at_params_string_put(&list, 0, "efghijk", 7),
+		      "at_params_string_put should return 0");
+	zassert_equal(0, at_params_array_put(&list, 1, array, sizeof(u32_t)),
+		      "at_params_array_put should return 0");
+
+	at_params_list_free(&list);
+	zassert_equal(0, list.param_count,
+		      "Params list count is not 0 after free");
+	zassert_equal_ptr(NULL, list.params,
+			  "Params is not NULL after free");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(at_cmd_parser,
@@ -449,7 +514,8 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 					test_params_list_management,
 					test_params_list_management_setup,
-					test_params_list_management_teardown)
+					test_params_list_management_teardown),
+			 ztest_unit_test(test_params_list_buf)
 			);
 
 	ztest_run_test_suite(at_cmd_parser);
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <ztest.h>
+#include <stdio.h>
+#include <string.h>
+#include <modem/at_cmd.h>
+#include <modem/at_notif.h>
+
+#define CEREG_NOTIF "+CEREG: 1,\"002F\",\"0012BEEF\",7,,,\"11100000\""
+#define CSCON_NOTIF "+CSCON: 0"
+
+static at_cmd_handler_t dispatch;
+
+static int cereg_cnt;
+static int cscon_cnt;
+static int all_cnt;
+static const char *last_notif;
+
+/* Replaces the AT command driver, which dispatches the notifications. */
+void at_cmd_set_notification_handler(at_cmd_handler_t handler)
+{
+	dispatch = handler;
+}
+
+static void cereg_handler(void *context, const char *response)
+{
+	cereg_cnt++;
+	last_notif = response;
+}
+
+static void cscon_handler(void *context, const char *response)
+{
+	cscon_cnt++;
+}
+
+static void all_handler(void *context, const char *response)
+{
+	all_cnt++;
+}
+
+/* Counts in the context. */
+static void ctx_handler(void *context, const char *response)
+{
+	(*(int *)context)++;
+}
+
+static void self_deregister_handler(void *context, const char *response)
+{
+	cereg_cnt++;
+	zassert_equal(at_notif_deregister_prefix_handler(context, "+CEREG",
+			self_deregister_handler), 0, "Deregistration failed");
+}
+
+static void counters_reset(void)
+{
+	cereg_cnt = 0;
+	cscon_cnt = 0;
+	all_cnt = 0;
+	last_notif = NULL;
+}
+
+static void test_prefix_dispatch(void)
+{
+	counters_reset();
+
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CEREG",
+			cereg_handler), 0, "Registration failed");
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CSCON",
+			cscon_handler), 0, "Registration failed");
+	zassert_equal(at_notif_register_handler(NULL, all_handler), 0,
+		      "Registration failed");
+
+	dispatch(CEREG_NOTIF);
+	zassert_equal(cereg_cnt, 1, "Not dispatched");
+	zassert_equal(cscon_cnt, 0, "Dispatched to other prefix");
+	zassert_equal(all_cnt, 1, "Not dispatched to all");
+	zassert_equal(strcmp(last_notif, CEREG_NOTIF), 0, "Wrong notification");
+
+	/* Without a space after the colon, or without parameters. */
+	dispatch("+CEREG:5");
+	dispatch("+CEREG\r\n");
+	zassert_equal(cereg_cnt, 3, "Not dispatched");
+
+	/* Other notifications that start with the prefix. */
+	dispatch("+CEREGX: 1");
+	dispatch("+CERE: 1");
+	dispatch("%XSIM: 1");
+	dispatch("");
+	zassert_equal(cereg_cnt, 3, "Dispatched to other prefix");
+	zassert_equal(cscon_cnt, 0, "Dispatched to other prefix");
+	zassert_equal(all_cnt, 7, "Not dispatched to all");
+
+	dispatch(CSCON_NOTIF);
+	zassert_equal(cscon_cnt, 1, "Not dispatched");
+
+	zassert_equal(at_notif_deregister_prefix_handler(NULL, "+CEREG",
+			cereg_handler), 0, "Deregistration failed");
+	zassert_equal(at_notif_deregister_prefix_handler(NULL, "+CSCON",
+			cscon_handler), 0, "Deregistration failed");
+	zassert_equal(at_notif_deregister_handler(NULL, all_handler), 0,
+		      "Deregistration failed");
+
+	dispatch(CEREG_NOTIF);
+	zassert_equal(cereg_cnt, 3, "Dispatched after deregistration");
+	zassert_equal(all_cnt, 8, "Dispatched after deregistration");
+}
+
+static void test_handler_combinations(void)
+{
+	int ctx_a = 0;
+	int ctx_b = 0;
+
+	/* The same handler, with different contexts and prefixes. */
+	zassert_equal(at_notif_register_prefix_handler(&ctx_a, "+CEREG",
+			ctx_handler), 0, "Registration failed");
+	zassert_equal(at_notif_register_prefix_handler(&ctx_a, "+CSCON",
+			ctx_handler), 0, "Registration failed");
+	zassert_equal(at_notif_register_prefix_handler(&ctx_b, "+CEREG",
+			ctx_handler), 0, "Registration failed");
+
+	/* Registered twice, called once. */
+	zassert_equal(at_notif_register_prefix_handler(&ctx_b, "+CEREG",
+			ctx_handler), 0, "Registration failed");
+
+	dispatch(CEREG_NOTIF);
+	dispatch(CSCON_NOTIF);
+	zassert_equal(ctx_a, 2, "Wrong dispatch count");
+	zassert_equal(ctx_b, 1, "Wrong dispatch count");
+
+	zassert_equal(at_notif_deregister_prefix_handler(&ctx_a, "+CEREG",
+			ctx_handler), 0, "Deregistration failed");
+
+	dispatch(CEREG_NOTIF);
+	dispatch(CSCON_NOTIF);
+	zassert_equal(ctx_a, 3, "Wrong dispatch count");
+	zassert_equal(ctx_b, 2, "Wrong dispatch count");
+
+	/* Not registered. */
+	zassert_equal(at_notif_deregister_prefix_handler(&ctx_a, "+CEREG",
+			ctx_handler), 0, "Deregistration failed");
+	zassert_equal(at_notif_deregister_prefix_handler(&ctx_a, "%CESQ",
+			ctx_handler), 0, "Deregistration failed");
+
+	zassert_equal(at_notif_deregister_prefix_handler(&ctx_a, "+CSCON",
+			ctx_handler), 0, "Deregistration failed");
+	zassert_equal(at_notif_deregister_prefix_handler(&ctx_b, "+CEREG",
+			ctx_handler), 0, "Deregistration failed");
+}
+
+static void test_dispatch_count(void)
+{
+	u32_t count;
+
+	zassert_equal(at_notif_dispatch_count_get("+CEREG", &count), -ENOENT,
+		      "Counted without handlers");
+
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CEREG",
+			cereg_handler), 0, "Registration failed");
+
+	zassert_equal(at_notif_dispatch_count_get("+CEREG", &count), 0,
+		      "Not counted");
+	zassert_equal(count, 0, "Wrong count");
+
+	for (int i = 0; i < 5; i++) {
+		dispatch(CEREG_NOTIF);
+	}
+	dispatch(CSCON_NOTIF);
+
+	zassert_equal(at_notif_dispatch_count_get("+CEREG", &count), 0,
+		      "Not counted");
+	zassert_equal(count, 5, "Wrong count");
+
+	zassert_equal(at_notif_deregister_prefix_handler(NULL, "+CEREG",
+			cereg_handler), 0, "Deregistration failed");
+	zassert_equal(at_notif_dispatch_count_get("+CEREG", &count), -ENOENT,
+		      "Counted without handlers");
+
+	zassert_equal(at_notif_dispatch_count_get(NULL, &count), -EINVAL,
+		      "NULL prefix accepted");
+	zassert_equal(at_notif_dispatch_count_get("+CEREG", NULL), -EINVAL,
+		      "NULL count accepted");
+}
+
+static void test_invalid_prefix(void)
+{
+	zassert_equal(at_notif_register_prefix_handler(NULL, NULL,
+			cereg_handler), -EINVAL, "NULL prefix accepted");
+	zassert_equal(at_notif_register_prefix_handler(NULL, "",
+			cereg_handler), -EINVAL, "Empty prefix accepted");
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CEREG:",
+			cereg_handler), -EINVAL, "Prefix with colon accepted");
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CEREG 1",
+			cereg_handler), -EINVAL, "Prefix with space accepted");
+	zassert_equal(at_notif_register_prefix_handler(NULL,
+			"+ABCDEFGHIJKLMNOP", cereg_handler), -EINVAL,
+		      "Too long prefix accepted");
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CEREG", NULL),
+		      -EINVAL, "NULL handler accepted");
+	zassert_equal(at_notif_deregister_prefix_handler(NULL, NULL,
+			cereg_handler), -EINVAL, "NULL prefix accepted");
+}
+
+/* Fill the table in an order that is not sorted, to check the search. */
+static void test_prefix_table(void)
+{
+	static const char *const prefixes[CONFIG_AT_NOTIF_PREFIX_COUNT_MAX] = {
+		"+CSCON", "%CESQ", "+CEREG", "+CMT", "%XSIM", "+CEDRXP",
+		"%XT3412", "+A",
+	};
+	static int counts[CONFIG_AT_NOTIF_PREFIX_COUNT_MAX];
+	char notif[32];
+
+	for (int i = 0; i < ARRAY_SIZE(prefixes); i++) {
+		zassert_equal(at_notif_register_prefix_handler(&counts[i],
+				prefixes[i], ctx_handler), 0,
+			      "Registration failed");
+	}
+
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CGEV",
+			cereg_handler), -ENOBUFS, "Table not full");
+
+	/* A registered prefix can still get more handlers. */
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CEREG",
+			cereg_handler), 0, "Registration failed");
+	zassert_equal(at_notif_deregister_prefix_handler(NULL, "+CEREG",
+			cereg_handler), 0, "Deregistration failed");
+
+	for (int i = 0; i < ARRAY_SIZE(prefixes); i++) {
+		for (int j = 0; j <= i; j++) {
+			snprintf(notif, sizeof(notif), "%s: %d", prefixes[i], j);
+			dispatch(notif);
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(prefixes); i++) {
+		zassert_equal(counts[i], i + 1, "Wrong dispatch count");
+		zassert_equal(at_notif_deregister_prefix_handler(&counts[i],
+				prefixes[i], ctx_handler), 0,
+			      "Deregistration failed");
+	}
+
+	/* All removed from the table. */
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CGEV",
+			cereg_handler), 0, "Registration failed");
+	zassert_equal(at_notif_deregister_prefix_handler(NULL, "+CGEV",
+			cereg_handler), 0, "Deregistration failed");
+}
+
+static void test_deregister_in_handler(void)
+{
+	counters_reset();
+
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CEREG",
+			self_deregister_handler), 0, "Registration failed");
+	zassert_equal(at_notif_register_prefix_handler(NULL, "+CEREG",
+			cereg_handler), 0, "Registration failed");
+
+	dispatch(CEREG_NOTIF);
+	dispatch(CEREG_NOTIF);
+	zassert_equal(cereg_cnt, 3, "Wrong dispatch count");
+
+	zassert_equal(at_notif_deregister_prefix_handler(NULL, "+CEREG",
+			cereg_handler), 0, "Deregistration failed");
+}
+
+void test_main(void)
+{
+	zassert_equal(at_notif_init(), 0, "Initialization failed");
+	zassert_not_null(dispatch, "Dispatcher not set");
+
+	ztest_test_suite(at_notif,
+			 ztest_unit_test(test_prefix_dispatch),
+			 ztest_unit_test(test_handler_combinations),
+			 ztest_unit_test(test_dispatch_count),
+			 ztest_unit_test(test_invalid_prefix),
+			 ztest_unit_test(test_prefix_table),
+			 ztest_unit_test(test_deregister_in_handler)
+	);
+
+	ztest_run_test_suite(at_notif);
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <ztest.h>
+#include <string.h>
+#include <modem/at_cmd.h>
+#include <modem/at_notif.h>
+#include <modem/modem_info.h>
+
+#define XMONITOR_RSP "%XMONITOR: 1,\"Telia N\",\"Telia N\",\"24202\","	\
+	"\"0901\",7,20,\"012BEEF2\",252,6400,53,24,\"\",\"11100000\","	\
+	"\"00101001\",\"01011111\"\r\n"
+#define XMONITOR_RSP_NOT_REGISTERED "%XMONITOR: 2\r\n"
+
+struct fake_cmd {
+	const char *cmd;
+	const char *rsp;
+	int count;
+};
+
+static struct fake_cmd fake_cmds[] = {
+	{ "AT%XMONITOR", XMONITOR_RSP },
+	{ "AT%XCBAND=?", "%XCBAND: (1,2,3,4,12,13,20)\r\n" },
+	{ "AT+CEMODE?", "+CEMODE: 2\r\n" },
+	{ "AT+CGDCONT?", "+CGDCONT: 0,\"IP\",\"telia.iot\",\"10.160.1.10\","
+			 "0,0\r\n" },
+	{ "AT%XSYSTEMMODE?", "%XSYSTEMMODE: 1,0,1,0\r\n" },
+	{ "AT+CCLK?", "+CCLK: \"20/10/18,12:30:00+08\"\r\n" },
+	{ "AT%XSIM?", "%XSIM: 1\r\n" },
+	{ "AT+CRSM=176,12258,0,0,10",
+	  "+CRSM: 144,0,\"98740520200000112233\"\r\n" },
+	{ "AT+CIMI", "242011234567890\r\n" },
+	{ "AT+CGMR", "mfw_nrf9160_1.2.0\r\n" },
+	{ "AT%XVBAT", "%XVBAT: 3600\r\n" },
+	{ "AT+CGSN", "352656100367872\r\n" },
+};
+
+static struct modem_param_info modem_param;
+static at_notif_handler_t cereg_handler;
+static at_notif_handler_t xsim_handler;
+static int xsim_subscriptions;
+static bool xsim_rejected;
+
+/* Replaces the AT command driver, the modem answers from the table. */
+int at_cmd_write(const char *const cmd, char *buf, size_t buf_len,
+		 enum at_cmd_state *state)
+{
+	if (strcmp(cmd, "AT%XSIM=1") == 0) {
+		xsim_subscriptions++;
+		return xsim_rejected ? -EIO : 0;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(fake_cmds); i++) {
+		if (strcmp(cmd, fake_cmds[i].cmd) == 0) {
+			fake_cmds[i].count++;
+			strncpy(buf, fake_cmds[i].rsp, buf_len);
+			return 0;
+		}
+	}
+
+	return -EIO;
+}
+
+int at_notif_register_prefix_handler(void *context, const char *prefix,
+				     at_notif_handler_t handler)
+{
+	if (strcmp(prefix, "+CEREG") == 0) {
+		cereg_handler = handler;
+	} else if (strcmp(prefix, "%XSIM") == 0) {
+		xsim_handler = handler;
+	}
+
+	return 0;
+}
+
+static int cmd_count(const char *cmd)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(fake_cmds); i++) {
+		if (strcmp(cmd, fake_cmds[i].cmd) == 0) {
+			return fake_cmds[i].count;
+		}
+	}
+
+	return -1;
+}
+
+static int total_count(void)
+{
+	int total = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(fake_cmds); i++) {
+		total += fake_cmds[i].count;
+	}
+
+	return total;
+}
+
+static void counts_reset(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(fake_cmds); i++) {
+		fake_cmds[i].count = 0;
+	}
+}
+
+static void test_params_get(void)
+{
+	struct network_param *network = &modem_param.network;
+
+	zassert_equal(modem_info_params_init(&modem_param), 0,
+		      "Initialization failed");
+	zassert_not_null(cereg_handler, "+CEREG handler not registered");
+	zassert_not_null(xsim_handler, "%XSIM handler not registered");
+
+	counts_reset();
+	zassert_equal(modem_info_params_get(&modem_param), 0,
+		      "Parameters not obtained");
+
+	/* Every command is sent once, with %XMONITOR for the operator,
+	 * tracking area, band and cell.
+	 */
+	zassert_equal(total_count(), ARRAY_SIZE(fake_cmds), "Wrong count");
+	for (size_t i = 0; i < ARRAY_SIZE(fake_cmds); i++) {
+		zassert_equal(fake_cmds[i].count, 1, "Command not sent once");
+	}
+
+	zassert_equal(strcmp(network->current_operator.value_string, "24202"),
+		      0, "Wrong operator");
+	zassert_equal(network->mcc.value, 242, "Wrong MCC");
+	zassert_equal(network->mnc.value, 2, "Wrong MNC");
+	zassert_equal(network->area_code.value, 0x0901, "Wrong area code");
+	zassert_equal(strcmp(network->cellid_hex.value_string, "012BEEF2"), 0,
+		      "Wrong cell ID");
+	zassert_equal(network->cellid_dec, 0x012BEEF2, "Wrong cell ID");
+	zassert_equal(network->current_band.value, 20, "Wrong band");
+	zassert_equal(strncmp(network->sup_band.value_string,
+			      "(1,2,3,4,12,13,20)", 18), 0, "Wrong bands");
+	zassert_equal(network->ue_mode.value, 2, "Wrong mode");
+	zassert_equal(strcmp(network->ip_address.value_string, "10.160.1.10"),
+		      0, "Wrong IP address");
+	zassert_equal(strcmp(network->apn.value_string, "telia.iot"), 0,
+		      "Wrong APN");
+	zassert_equal(network->lte_mode.value, 1, "Wrong LTE-M mode");
+	zassert_equal(network->nbiot_mode.value, 0, "Wrong NB-IoT mode");
+	zassert_equal(network->gps_mode.value, 1, "Wrong GPS mode");
+	zassert_equal(modem_param.sim.uicc.value, 1, "Wrong UICC state");
+	zassert_equal(modem_param.device.battery.value, 3600,
+		      "Wrong battery voltage");
+	zassert_equal(strcmp(modem_param.device.imei.value_string,
+			     "352656100367872"), 0, "Wrong IMEI");
+
+	/* Without the cache, everything is read again. */
+	counts_reset();
+	zassert_equal(modem_info_params_get(&modem_param), 0,
+		      "Parameters not obtained");
+	zassert_equal(total_count(), ARRAY_SIZE(fake_cmds), "Wrong count");
+}
+
+static void test_params_snapshot(void)
+{
+	xsim_subscriptions = 0;
+	zassert_equal(modem_info_params_init(&modem_param), 0,
+		      "Initialization failed");
+	zassert_equal(xsim_subscriptions, 1, "%XSIM not subscribed to");
+
+	counts_reset();
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), 0,
+		      "Parameters not obtained");
+	zassert_equal(total_count(), ARRAY_SIZE(fake_cmds),
+		      "Not everything read after initialization");
+
+	/* Only the battery voltage and the date and time are always read. */
+	counts_reset();
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), 0,
+		      "Parameters not obtained");
+	zassert_equal(total_count(), 2, "Wrong count");
+	zassert_equal(cmd_count("AT%XVBAT"), 1, "Battery voltage not read");
+	zassert_equal(cmd_count("AT+CCLK?"), 1, "Date and time not read");
+	zassert_equal(strcmp(modem_param.network.current_operator.value_string,
+			     "24202"), 0, "Cached operator lost");
+
+	/* The tracking area and cell are taken from the notification, the
+	 * IP address is read again. Values read in the same millisecond as a
+	 * notification are not cached, so wait after it.
+	 */
+	cereg_handler(NULL, "+CEREG: 5,\"0902\",\"012BEEF3\",7");
+	k_sleep(K_MSEC(2));
+	counts_reset();
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), 0,
+		      "Parameters not obtained");
+	zassert_equal(total_count(), 3, "Wrong count");
+	zassert_equal(cmd_count("AT%XMONITOR"), 0, "Cell read again");
+	zassert_equal(cmd_count("AT+CGDCONT?"), 1, "IP address not read");
+	zassert_equal(modem_param.network.area_code.value, 0x0902,
+		      "Area code not notified");
+	zassert_equal(strcmp(modem_param.network.cellid_hex.value_string,
+			     "012BEEF3"), 0, "Cell ID not notified");
+	zassert_equal(modem_param.network.cellid_dec, 0x012BEEF3,
+		      "Cell ID not notified");
+	zassert_equal(strcmp(modem_param.network.current_operator.value_string,
+			     "24202"), 0, "Cached operator lost");
+
+	/* Without the cell, the values that change with it are read. */
+	cereg_handler(NULL, "+CEREG: 2");
+	k_sleep(K_MSEC(2));
+	counts_reset();
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), 0,
+		      "Parameters not obtained");
+	zassert_equal(total_count(), 4, "Wrong count");
+	zassert_equal(cmd_count("AT%XMONITOR"), 1, "Cell not read");
+	zassert_equal(cmd_count("AT+CGDCONT?"), 1, "IP address not read");
+	zassert_equal(modem_param.network.area_code.value, 0x0901,
+		      "Area code not read");
+
+	xsim_handler(NULL, "%XSIM: 1");
+	k_sleep(K_MSEC(2));
+	counts_reset();
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), 0,
+		      "Parameters not obtained");
+	zassert_equal(total_count(), 5, "Wrong count");
+	zassert_equal(cmd_count("AT+CRSM=176,12258,0,0,10"), 1,
+		      "ICCID not read");
+	zassert_equal(cmd_count("AT+CIMI"), 1, "IMSI not read");
+	zassert_equal(cmd_count("AT%XSIM?"), 1, "UICC state not read");
+
+	/* The network values expire, the device values do not. */
+	k_sleep(K_MSEC(CONFIG_MODEM_INFO_PARAMS_MAX_AGE * MSEC_PER_SEC + 100));
+	counts_reset();
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), 0,
+		      "Parameters not obtained");
+	zassert_equal(total_count(), 7, "Wrong count");
+	zassert_equal(cmd_count("AT%XCBAND=?"), 0, "Bands read again");
+	zassert_equal(cmd_count("AT+CGMR"), 0, "Firmware version read again");
+	zassert_equal(cmd_count("AT+CGSN"), 0, "IMEI read again");
+	zassert_equal(cmd_count("AT+CRSM=176,12258,0,0,10"), 0,
+		      "ICCID read again without %XSIM");
+	zassert_equal(cmd_count("AT+CIMI"), 0,
+		      "IMSI read again without %XSIM");
+}
+
+static void test_params_snapshot_xsim_rejected(void)
+{
+	xsim_rejected = true;
+	zassert_equal(modem_info_params_init(&modem_param), 0,
+		      "Initialization failed with %XSIM rejected");
+	xsim_rejected = false;
+
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), 0,
+		      "Parameters not obtained");
+
+	/* Without %XSIM notifications, the ICCID and IMSI expire. */
+	k_sleep(K_MSEC(CONFIG_MODEM_INFO_PARAMS_MAX_AGE * MSEC_PER_SEC + 100));
+	counts_reset();
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), 0,
+		      "Parameters not obtained");
+	zassert_equal(cmd_count("AT+CRSM=176,12258,0,0,10"), 1,
+		      "ICCID not read again");
+	zassert_equal(cmd_count("AT+CIMI"), 1, "IMSI not read again");
+	zassert_equal(cmd_count("AT+CGMR"), 0, "Firmware version read again");
+}
+
+static void test_params_snapshot_not_registered(void)
+{
+	zassert_equal(modem_info_params_init(&modem_param), 0,
+		      "Initialization failed");
+
+	fake_cmds[0].rsp = XMONITOR_RSP_NOT_REGISTERED;
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), -EAGAIN,
+		      "Network data obtained without registration");
+
+	/* The network data is read again, but nothing else. */
+	fake_cmds[0].rsp = XMONITOR_RSP;
+	counts_reset();
+	zassert_equal(modem_info_params_snapshot_get(&modem_param), 0,
+		      "Parameters not obtained");
+	zassert_equal(total_count(), 3, "Wrong count");
+	zassert_equal(cmd_count("AT%XMONITOR"), 1, "Cell not read");
+}
+
+void test_main(void)
+{
+	zassert_equal(modem_info_init(), 0, "Initialization failed");
+
+	ztest_test_suite(modem_info,
+			 ztest_unit_test(test_params_get),
+			 ztest_unit_test(test_params_snapshot),
+			 ztest_unit_test(test_params_snapshot_xsim_rejected),
+			 ztest_unit_test(test_params_snapshot_not_registered)
+	);
+
+	ztest_run_test_suite(modem_info);
+}
@@ -142,6 +142,9 @@ void test_sha256_string(const uint8_t * input, uint32_t input_len, const uint8_t
 	int expected_rc = eq ? 0 : -EHASHINV;
 	zassert_equal(expected_rc, rc, "bl_sha256_verify returned %d instead of %d", rc, expected_rc);
 
+	rc = bl_sha256_verify_external(input, input_len, test_vector);
+	zassert_equal(expected_rc, rc, "bl_sha256_verify_external returned %d instead of %d", rc, expected_rc);
+
 	run_count++;
 }
 const uint8_t input3[] = "test vector should fail";
@@ -0,0 +1,14 @@
+/* Flash operations on the RAM partition of pm_config.h, see src/main.c. */
+#ifndef NRFX_NVMC_H__
+#define NRFX_NVMC_H__
+#include <zephyr/types.h>
+
+typedef int nrfx_err_t;
+#define NRFX_SUCCESS 0
+
+nrfx_err_t nrfx_nvmc_page_erase(u32_t address);
+void nrfx_nvmc_word_write(u32_t address, u32_t value);
+void nrfx_nvmc_words_write(u32_t address, void const *src, u32_t num_words);
+u32_t nrfx_nvmc_flash_page_size_get(void);
+
+#endif /* NRFX_NVMC_H__ */
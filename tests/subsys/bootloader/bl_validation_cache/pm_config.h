@@ -0,0 +1,8 @@
+/* Places the cache partition in RAM, see src/main.c. */
+#ifndef PM_CONFIG_H__
+#define PM_CONFIG_H__
+#include <zephyr/types.h>
+extern u8_t cache_flash[];
+#define PM_B0_CACHE_ADDRESS ((u32_t)cache_flash)
+#define PM_B0_CACHE_SIZE 0x400
+#endif /* PM_CONFIG_H__ */
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <string.h>
+#include <ztest.h>
+#include <pm_config.h>
+#include <nrfx_nvmc.h>
+#include <bl_validation_cache.h>
+
+#define PAGE_SIZE 0x100
+#define NUM_WORDS (PM_B0_CACHE_SIZE / 4)
+/* Times a word can be written between erases. */
+#define MAX_WORD_WRITES 2
+
+#define ADDR_S0 0x8000
+#define ADDR_S1 0x48000
+#define FW_SIZE 0x30000
+
+u8_t cache_flash[PM_B0_CACHE_SIZE] __aligned(4);
+
+static u8_t word_writes[NUM_WORDS];
+static u32_t erase_cnt;
+
+static const u8_t hash_a[32] = {
+	0xa5, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+};
+static u8_t hash_b[32];
+
+/* The cache is written like NOR flash: bits can only be cleared, and only by
+ * a limited number of writes, until the page is erased.
+ */
+nrfx_err_t nrfx_nvmc_page_erase(u32_t address)
+{
+	u32_t offset = address - PM_B0_CACHE_ADDRESS;
+
+	zassert_true(offset < PM_B0_CACHE_SIZE, "Erase outside partition");
+	zassert_equal(offset % PAGE_SIZE, 0, "Erase not page aligned");
+
+	memset(&cache_flash[offset], 0xff, PAGE_SIZE);
+	memset(&word_writes[offset / 4], 0, PAGE_SIZE / 4);
+	erase_cnt++;
+
+	return NRFX_SUCCESS;
+}
+
+void nrfx_nvmc_word_write(u32_t address, u32_t value)
+{
+	u32_t offset = address - PM_B0_CACHE_ADDRESS;
+	u32_t *word = (u32_t *)&cache_flash[offset];
+
+	zassert_true(offset < PM_B0_CACHE_SIZE, "Write outside partition");
+	zassert_equal(offset % 4, 0, "Write not word aligned");
+	zassert_true(++word_writes[offset / 4] <= MAX_WORD_WRITES,
+		     "Word written too many times");
+
+	*word &= value;
+}
+
+void nrfx_nvmc_words_write(u32_t address, void const *src, u32_t num_words)
+{
+	const u8_t *src_bytes = src;
+
+	for (u32_t i = 0; i < num_words; i++) {
+		u32_t value;
+
+		memcpy(&value, &src_bytes[i * 4], 4);
+		nrfx_nvmc_word_write(address + i * 4, value);
+	}
+}
+
+u32_t nrfx_nvmc_flash_page_size_get(void)
+{
+	return PAGE_SIZE;
+}
+
+static void setup(void)
+{
+	memset(cache_flash, 0xff, sizeof(cache_flash));
+	memset(word_writes, 0, sizeof(word_writes));
+	erase_cnt = 0;
+	memcpy(hash_b, hash_a, sizeof(hash_b));
+	hash_b[31] ^= 1;
+}
+
+static bool find(u32_t address, u32_t version, const u8_t *hash,
+		 u32_t *key_idx)
+{
+	return bl_validation_cache_find(address, FW_SIZE, version, hash,
+					key_idx);
+}
+
+static void test_empty(void)
+{
+	u32_t key_idx;
+
+	zassert_false(find(ADDR_S0, 1, hash_a, &key_idx), "Found in empty");
+	zassert_equal(erase_cnt, 0, "Erased on lookup");
+}
+
+static void test_store_find(void)
+{
+	u32_t key_idx = 0;
+	int err;
+
+	err = bl_validation_cache_store(ADDR_S0, FW_SIZE, 1, hash_a, 2);
+	zassert_equal(err, 0, "Store failed: %d", err);
+
+	zassert_true(find(ADDR_S0, 1, hash_a, &key_idx), "Not found");
+	zassert_equal(key_idx, 2, "Wrong key index");
+
+	/* Lookups do not consume the record. */
+	zassert_true(find(ADDR_S0, 1, hash_a, &key_idx), "Not found again");
+	zassert_false(find(ADDR_S1, 1, hash_a, &key_idx), "Found at S1");
+	zassert_equal(erase_cnt, 0, "Erased when not full");
+}
+
+static void test_mismatch_invalidates(void)
+{
+	u32_t key_idx;
+
+	zassert_equal(bl_validation_cache_store(ADDR_S0, FW_SIZE, 1, hash_a, 0),
+		      0, "Store failed");
+	zassert_false(find(ADDR_S0, 2, hash_a, &key_idx), "Version changed");
+	zassert_false(find(ADDR_S0, 1, hash_a, &key_idx), "Not invalidated");
+
+	zassert_equal(bl_validation_cache_store(ADDR_S0, FW_SIZE, 1, hash_a, 0),
+		      0, "Store failed");
+	zassert_false(find(ADDR_S0, 1, hash_b, &key_idx), "Hash changed");
+	zassert_false(find(ADDR_S0, 1, hash_a, &key_idx), "Not invalidated");
+
+	zassert_equal(bl_validation_cache_store(ADDR_S0, FW_SIZE, 1, hash_a, 0),
+		      0, "Store failed");
+	zassert_false(bl_validation_cache_find(ADDR_S0, FW_SIZE + 4, 1, hash_a,
+					       &key_idx), "Size changed");
+	zassert_false(find(ADDR_S0, 1, hash_a, &key_idx), "Not invalidated");
+}
+
+static void test_invalidate(void)
+{
+	u32_t key_idx;
+
+	zassert_equal(bl_validation_cache_store(ADDR_S0, FW_SIZE, 1, hash_a, 0),
+		      0, "Store failed");
+	zassert_equal(bl_validation_cache_store(ADDR_S1, FW_SIZE, 2, hash_b, 1),
+		      0, "Store failed");
+
+	bl_validation_cache_invalidate(ADDR_S0);
+
+	zassert_false(find(ADDR_S0, 1, hash_a, &key_idx), "Not invalidated");
+	zassert_true(find(ADDR_S1, 2, hash_b, &key_idx), "Other invalidated");
+	zassert_equal(key_idx, 1, "Wrong key index");
+
+	/* Nothing to invalidate. */
+	bl_validation_cache_invalidate(ADDR_S0);
+}
+
+static void test_replace(void)
+{
+	u32_t key_idx;
+
+	zassert_equal(bl_validation_cache_store(ADDR_S0, FW_SIZE, 1, hash_a, 0),
+		      0, "Store failed");
+	zassert_equal(bl_validation_cache_store(ADDR_S1, FW_SIZE, 1, hash_a, 0),
+		      0, "Store failed");
+	zassert_equal(bl_validation_cache_store(ADDR_S0, FW_SIZE, 2, hash_b, 1),
+		      0, "Store failed");
+
+	zassert_true(find(ADDR_S0, 2, hash_b, &key_idx), "New record missing");
+	zassert_equal(key_idx, 1, "Wrong key index");
+	zassert_true(find(ADDR_S1, 1, hash_a, &key_idx), "Other record lost");
+	zassert_false(find(ADDR_S0, 1, hash_a, &key_idx), "Old record valid");
+}
+
+static void test_partial_record(void)
+{
+	u32_t key_idx;
+
+	zassert_equal(bl_validation_cache_store(ADDR_S0, FW_SIZE, 1, hash_a, 0),
+		      0, "Store failed");
+
+	/* Interrupt the store before its last word is written. */
+	for (int i = NUM_WORDS - 1; i >= 0; i--) {
+		u32_t *word = (u32_t *)&cache_flash[i * 4];
+
+		if (*word != 0xFFFFFFFF) {
+			*word = 0xFFFFFFFF;
+			break;
+		}
+	}
+
+	zassert_false(find(ADDR_S0, 1, hash_a, &key_idx),
+		      "Partial record valid");
+
+	zassert_equal(bl_validation_cache_store(ADDR_S0, FW_SIZE, 1, hash_a, 3),
+		      0, "Store failed");
+	zassert_true(find(ADDR_S0, 1, hash_a, &key_idx), "Not found");
+	zassert_equal(key_idx, 3, "Wrong key index");
+}
+
+static void test_full(void)
+{
+	u32_t key_idx;
+	u32_t version;
+
+	/* Fill the partition, and then some. */
+	for (version = 1; erase_cnt == 0; version++) {
+		zassert_equal(bl_validation_cache_store(ADDR_S0, FW_SIZE,
+				version, hash_a, 0), 0, "Store failed");
+		zassert_true(find(ADDR_S0, version, hash_a, &key_idx),
+			     "Not found");
+	}
+
+	zassert_equal(erase_cnt, PM_B0_CACHE_SIZE / PAGE_SIZE,
+		      "Partition not erased once");
+	zassert_true(find(ADDR_S0, version - 1, hash_a, &key_idx),
+		     "Lost after erase");
+
+	zassert_equal(bl_validation_cache_store(ADDR_S1, FW_SIZE, 1, hash_b, 0),
+		      0, "Store failed");
+	zassert_true(find(ADDR_S1, 1, hash_b, &key_idx), "Not found");
+	zassert_true(find(ADDR_S0, version - 1, hash_a, &key_idx),
+		     "Other record lost");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_bl_validation_cache,
+			 ztest_unit_test_setup_teardown(test_empty,
+				setup, unit_test_noop),
+			 ztest_unit_test_setup_teardown(test_store_find,
+				setup, unit_test_noop),
+			 ztest_unit_test_setup_teardown(test_mismatch_invalidates,
+				setup, unit_test_noop),
+			 ztest_unit_test_setup_teardown(test_invalidate,
+				setup, unit_test_noop),
+			 ztest_unit_test_setup_teardown(test_replace,
+				setup, unit_test_noop),
+			 ztest_unit_test_setup_teardown(test_partial_record,
+				setup, unit_test_noop),
+			 ztest_unit_test_setup_teardown(test_full,
+				setup, unit_test_noop)
+	);
+	ztest_run_test_suite(test_bl_validation_cache);
+}
@@ -16,6 +16,7 @@ static size_t offset_get_out_param;
 static int write_retval;
 static int write_param_len;
 static void const *write_param_buf;
+static size_t write_at_param_offset;
 static int done_retval;
 static int init_retval;
 static bool identify_retval;
@@ -43,6 +44,15 @@ int dfu_target_mcuboot_write(const void *const buf, size_t len)
 	return write_retval;
 }
 
+int dfu_target_mcuboot_write_at(size_t offset, const void *const buf,
+				size_t len)
+{
+	write_at_param_offset = offset;
+	write_param_buf = buf;
+	write_param_len = len;
+	return write_retval;
+}
+
 int dfu_target_mcuboot_done(bool successful)
 {
 	return done_retval;
@@ -179,10 +189,37 @@ static void test_write(void)
 	zassert_true(err < 0, "Did not get error when writing uninitialized");
 }
 
+static void test_write_at(void)
+{
+	int err;
+	int mybuf[100];
+
+	init();
+	write_retval = 0;
+	err = dfu_target_write_at(0x800, mybuf, sizeof(mybuf));
+	zassert_equal(err, 0, NULL);
+	zassert_equal(write_at_param_offset, 0x800, NULL);
+	zassert_equal_ptr(write_param_buf, mybuf, NULL);
+	zassert_equal(write_param_len, sizeof(mybuf), NULL);
+
+	write_retval = -42;
+	err = dfu_target_write_at(0, mybuf, sizeof(mybuf));
+	zassert_equal(err, -42, "Did not get error from dfu target");
+	write_retval = 0;
+
+	err = dfu_target_write_at(0, NULL, sizeof(mybuf));
+	zassert_true(err < 0, "Did not get error when writing NULL");
+
+	done(); /* De-initialize */
+	err = dfu_target_write_at(0, mybuf, sizeof(mybuf));
+	zassert_true(err < 0, "Did not get error when writing uninitialized");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(dfu_target_test,
 			 ztest_unit_test(test_write),
+			 ztest_unit_test(test_write_at),
 			 ztest_unit_test(test_offset_get),
 			 ztest_unit_test(test_done),
 			 ztest_unit_test(test_init)
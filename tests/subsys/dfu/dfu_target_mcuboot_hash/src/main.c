@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+#include <string.h>
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <ztest.h>
+#include <sys/byteorder.h>
+#include <tinycrypt/sha256.h>
+#include <bl_crypto.h>
+#include <dfu_target_mcuboot_hash.h>
+
+#define HDR_SIZE 32
+#define BODY_SIZE 1000
+#define SIG_LEN 72
+
+/* SHA-256 of the header, the body, and the protected TLVs, if any. */
+static const u8_t digest[] = {
+	0x2e, 0x49, 0x03, 0xb1, 0xe9, 0x46, 0xfb, 0xd9,
+	0x1b, 0x46, 0xfe, 0x4a, 0xf5, 0xad, 0xe4, 0xe1,
+	0xff, 0x0c, 0x04, 0x99, 0x7a, 0xf9, 0x43, 0x42,
+	0x57, 0xbb, 0x5f, 0x6b, 0xc4, 0xce, 0xc8, 0x77,
+};
+
+static const u8_t digest_protected[] = {
+	0x46, 0x4b, 0x3c, 0x53, 0x00, 0xd4, 0xe0, 0xc1,
+	0xa1, 0x6a, 0xd2, 0xa7, 0xe3, 0x11, 0x59, 0x9b,
+	0xb6, 0x9a, 0x0a, 0xfa, 0xa1, 0xb8, 0x9a, 0xa5,
+	0x86, 0xe9, 0x2e, 0xe7, 0xdc, 0x85, 0xfb, 0x8b,
+};
+
+static u8_t image[512 + BODY_SIZE];
+static size_t image_len;
+
+/* bl_crypto is not available on the test platforms, use TinyCrypt. */
+BUILD_ASSERT(sizeof(struct tc_sha256_state_struct) <= sizeof(bl_sha256_ctx_t),
+	     "TinyCrypt context does not fit");
+
+int bl_sha256_init(bl_sha256_ctx_t *ctx)
+{
+	return tc_sha256_init((struct tc_sha256_state_struct *)ctx) ==
+		TC_CRYPTO_SUCCESS ? 0 : -EINVAL;
+}
+
+int bl_sha256_update(bl_sha256_ctx_t *ctx, const u8_t *data, u32_t data_len)
+{
+	return tc_sha256_update((struct tc_sha256_state_struct *)ctx, data,
+				data_len) == TC_CRYPTO_SUCCESS ? 0 : -EINVAL;
+}
+
+int bl_sha256_finalize(bl_sha256_ctx_t *ctx, u8_t *output)
+{
+	return tc_sha256_final(output, (struct tc_sha256_state_struct *)ctx) ==
+		TC_CRYPTO_SUCCESS ? 0 : -EINVAL;
+}
+
+static u8_t *tlv_add(u8_t *p, u8_t type, const u8_t *data, u16_t len)
+{
+	p[0] = type;
+	p[1] = 0;
+	sys_put_le16(len, &p[2]);
+	if (data != NULL) {
+		memcpy(&p[4], data, len);
+	} else {
+		memset(&p[4], type, len);
+	}
+
+	return p + 4 + len;
+}
+
+/* Build an MCUBoot image with a known body and the given digest TLV. */
+static void image_build(bool protected_tlv, const u8_t *sha256)
+{
+	static const u8_t prot_data[] = {0x01, 0x02, 0x03, 0x04};
+	u8_t *p = image;
+	u8_t *info;
+
+	memset(image, 0, sizeof(image));
+	sys_put_le32(0x96f3b83d, &image[0]);
+	sys_put_le16(HDR_SIZE, &image[8]);
+	sys_put_le16(protected_tlv ? 12 : 0, &image[10]);
+	sys_put_le32(BODY_SIZE, &image[12]);
+	image[20] = 1; /* Major version. */
+	p += HDR_SIZE;
+
+	for (size_t i = 0; i < BODY_SIZE; i++) {
+		*p++ = (i * 31 + 7) & 0xff;
+	}
+
+	if (protected_tlv) {
+		sys_put_le16(0x6908, &p[0]);
+		sys_put_le16(12, &p[2]);
+		p = tlv_add(p + 4, 0x50, prot_data, sizeof(prot_data));
+	}
+
+	info = p;
+	sys_put_le16(0x6907, &info[0]);
+	p = tlv_add(p + 4, 0x01, NULL, 32);
+	p = tlv_add(p, 0x10, sha256, 32);
+	p = tlv_add(p, 0x22, NULL, SIG_LEN);
+	sys_put_le16(p - info, &info[2]);
+
+	image_len = p - image;
+}
+
+/* Feed the image in fragments of the given size, as it is written. */
+static int image_verify(size_t len, size_t fragment_size)
+{
+	int err = dfu_target_mcuboot_hash_init();
+
+	zassert_equal(err, 0, NULL);
+
+	for (size_t off = 0; off < len; off += fragment_size) {
+		err = dfu_target_mcuboot_hash_update(&image[off],
+					MIN(fragment_size, len - off));
+		zassert_equal(err, 0, NULL);
+	}
+
+	return dfu_target_mcuboot_hash_verify();
+}
+
+static void test_valid_image(void)
+{
+	static const size_t fragment_sizes[] = {1, 3, 31, 32, 33, 512, 4096};
+
+	image_build(false, digest);
+
+	for (int i = 0; i < ARRAY_SIZE(fragment_sizes); i++) {
+		zassert_equal(image_verify(image_len, fragment_sizes[i]), 0,
+			      "Valid image rejected, fragment size %d",
+			      fragment_sizes[i]);
+	}
+}
+
+static void test_protected_tlv(void)
+{
+	image_build(true, digest_protected);
+
+	zassert_equal(image_verify(image_len, 7), 0,
+		      "Protected TLVs are not hashed");
+	zassert_equal(image_verify(image_len, image_len), 0, NULL);
+}
+
+static void test_corrupt_body(void)
+{
+	image_build(false, digest);
+	image[HDR_SIZE + BODY_SIZE / 2] ^= 0x01;
+
+	zassert_equal(image_verify(image_len, 512), -EHASHINV,
+		      "Corrupt image accepted");
+}
+
+static void test_corrupt_header(void)
+{
+	image_build(false, digest);
+	image[20] = 2;
+
+	zassert_equal(image_verify(image_len, 512), -EHASHINV,
+		      "Corrupt header accepted");
+}
+
+static void test_wrong_digest(void)
+{
+	image_build(true, digest);
+
+	zassert_equal(image_verify(image_len, 512), -EHASHINV,
+		      "Wrong digest accepted");
+}
+
+static void test_truncated(void)
+{
+	image_build(false, digest);
+
+	zassert_equal(image_verify(image_len - 1, 512), -EINVAL,
+		      "Truncated image accepted");
+	zassert_equal(image_verify(HDR_SIZE + BODY_SIZE, 512), -EINVAL,
+		      "Image without TLVs accepted");
+	zassert_equal(image_verify(HDR_SIZE / 2, 512), -EINVAL,
+		      "Partial header accepted");
+}
+
+static void test_not_mcuboot(void)
+{
+	image_build(false, digest);
+	image[0] = 0;
+
+	zassert_equal(image_verify(image_len, 512), -EINVAL,
+		      "Image without MCUBoot magic accepted");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(lib_dfu_target_mcuboot_hash_test,
+	     ztest_unit_test(test_valid_image),
+	     ztest_unit_test(test_protected_tlv),
+	     ztest_unit_test(test_corrupt_body),
+	     ztest_unit_test(test_corrupt_header),
+	     ztest_unit_test(test_wrong_digest),
+	     ztest_unit_test(test_truncated),
+	     ztest_unit_test(test_not_mcuboot)
+	 );
+
+	ztest_run_test_suite(lib_dfu_target_mcuboot_hash_test);
+}
@@ -0,0 +1,7 @@
+/* generated file copied to simplify building the test */
+#ifndef PM_CONFIG_H__
+#define PM_CONFIG_H__
+#define PM_MCUBOOT_SECONDARY_ID 1
+#define PM_MCUBOOT_SECONDARY_ADDRESS 0x80000
+#define PM_MCUBOOT_SECONDARY_SIZE 0x2000
+#endif /* PM_CONFIG_H__ */
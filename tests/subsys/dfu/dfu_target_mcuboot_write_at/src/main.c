@@ -0,0 +1,525 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <string.h>
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <ztest.h>
+#include <device.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+#include <dfu/flash_img.h>
+#include <storage/stream_flash.h>
+#include <dfu/mcuboot.h>
+#include <settings/settings.h>
+#include <pm_config.h>
+#include <dfu/dfu_target.h>
+#include <dfu_target_mcuboot.h>
+
+#define FLASH_DEV_NAME "FAKE_FLASH"
+#define PAGE_SIZE 1024
+#define CHUNK_SIZE CONFIG_DFU_TARGET_MCUBOOT_CHUNK_SIZE
+/* Size of the blocks written to flash by the DFU target. */
+#define BLOCK_SIZE 16
+/* Three chunks, the last one and its last block are not full. */
+#define IMAGE_SIZE (2 * CHUNK_SIZE + 1000)
+
+static u8_t image[IMAGE_SIZE];
+
+/* Flash area of the secondary slot, which must be erased before it is
+ * written again.
+ */
+static u8_t flash[PM_MCUBOOT_SECONDARY_SIZE];
+static size_t page_size = PAGE_SIZE;
+static int rewrites;
+static int flash_writes;
+
+static const struct flash_area fake_fa = {
+	.fa_id = PM_MCUBOOT_SECONDARY_ID,
+	.fa_off = PM_MCUBOOT_SECONDARY_ADDRESS,
+	.fa_size = PM_MCUBOOT_SECONDARY_SIZE,
+	.fa_dev_name = FLASH_DEV_NAME,
+};
+
+static const struct flash_driver_api fake_flash_api;
+
+static int fake_flash_init(struct device *dev)
+{
+	return 0;
+}
+
+DEVICE_AND_API_INIT(fake_flash, FLASH_DEV_NAME, fake_flash_init, NULL, NULL,
+		    POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE,
+		    &fake_flash_api);
+
+int flash_area_open(u8_t id, const struct flash_area **fa)
+{
+	zassert_equal(id, PM_MCUBOOT_SECONDARY_ID, "Wrong flash area");
+	*fa = &fake_fa;
+	return 0;
+}
+
+int flash_area_read(const struct flash_area *fa, off_t off, void *dst,
+		    size_t len)
+{
+	memcpy(dst, &flash[off], len);
+	return 0;
+}
+
+int flash_area_write(const struct flash_area *fa, off_t off, const void *src,
+		     size_t len)
+{
+	zassert_true(off + len <= sizeof(flash), "Write outside of the area");
+	zassert_equal(off % 4, 0, "Unaligned write");
+	zassert_equal(len % 4, 0, "Unaligned write");
+
+	for (size_t i = 0; i < len; i++) {
+		if (flash[off + i] != 0xff) {
+			rewrites++;
+		}
+	}
+
+	memcpy(&flash[off], src, len);
+	flash_writes++;
+	return 0;
+}
+
+int flash_area_erase(const struct flash_area *fa, off_t off, size_t len)
+{
+	zassert_equal(off % page_size, 0, "Erase not at a page");
+	zassert_equal(len % page_size, 0, "Erase not of whole pages");
+
+	(void)memset(&flash[off], 0xff, len);
+	return 0;
+}
+
+u8_t flash_area_align(const struct flash_area *fa)
+{
+	return 4;
+}
+
+int z_impl_flash_get_page_info_by_offs(struct device *dev, off_t offset,
+				       struct flash_pages_info *info)
+{
+	info->start_offset = ROUND_DOWN(offset, page_size);
+	info->size = page_size;
+	info->index = offset / page_size;
+	return 0;
+}
+
+/* The flash_img stream writes through to the flash area, and erases each
+ * page when it reaches it.
+ */
+int stream_flash_init(struct stream_flash_ctx *ctx, struct device *fdev,
+		      u8_t *buf, size_t buf_len, size_t offset, size_t size,
+		      stream_flash_callback_t cb)
+{
+	zassert_equal(offset % page_size, 0, "Stream not at a page");
+
+	ctx->fdev = fdev;
+	ctx->offset = offset;
+	ctx->available = size;
+	ctx->bytes_written = 0;
+	return 0;
+}
+
+int flash_img_init(struct flash_img_context *ctx)
+{
+	ctx->flash_area = &fake_fa;
+	return stream_flash_init(&ctx->stream, NULL, ctx->buf,
+				 sizeof(ctx->buf), fake_fa.fa_off,
+				 fake_fa.fa_size, NULL);
+}
+
+size_t flash_img_bytes_written(struct flash_img_context *ctx)
+{
+	return ctx->stream.bytes_written;
+}
+
+int flash_img_buffered_write(struct flash_img_context *ctx, const u8_t *data,
+			     size_t len, bool flush)
+{
+	off_t off = ctx->stream.offset - fake_fa.fa_off +
+		    ctx->stream.bytes_written;
+
+	zassert_true(len <= ctx->stream.available, "Write outside of stream");
+
+	for (size_t i = 0; i < len; i++, off++) {
+		if (off % page_size == 0) {
+			(void)memset(&flash[off], 0xff, page_size);
+		}
+		flash[off] = data[i];
+	}
+
+	ctx->stream.bytes_written += len;
+	ctx->stream.available -= len;
+	return 0;
+}
+
+static int upgrade_requests;
+
+int boot_request_upgrade(int permanent)
+{
+	upgrade_requests++;
+	return 0;
+}
+
+/* Settings storage, which survives a reset. */
+static struct {
+	char name[32];
+	u8_t data[64];
+	size_t len;
+} stored[2];
+static struct settings_handler *handler;
+static int chunk_stores;
+
+int settings_subsys_init(void)
+{
+	return 0;
+}
+
+int settings_register(struct settings_handler *cf)
+{
+	handler = cf;
+	return 0;
+}
+
+int settings_save_one(const char *name, const void *value, size_t val_len)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(stored); i++) {
+		if ((stored[i].len == 0) || !strcmp(stored[i].name, name)) {
+			zassert_true(val_len <= sizeof(stored[i].data),
+				     "Value too long");
+			strcpy(stored[i].name, name);
+			memcpy(stored[i].data, value, val_len);
+			stored[i].len = val_len;
+			if (strstr(name, "chunks") != NULL) {
+				chunk_stores++;
+			}
+			return 0;
+		}
+	}
+
+	return -ENOMEM;
+}
+
+static ssize_t read_cb(void *cb_arg, void *data, size_t len)
+{
+	size_t i = (size_t)cb_arg;
+
+	len = MIN(len, stored[i].len);
+	memcpy(data, stored[i].data, len);
+	return len;
+}
+
+int settings_load(void)
+{
+	size_t prefix = strlen(handler->name) + 1;
+
+	for (size_t i = 0; i < ARRAY_SIZE(stored); i++) {
+		if (stored[i].len != 0) {
+			handler->h_set(&stored[i].name[prefix], stored[i].len,
+				       read_cb, (void *)i);
+		}
+	}
+
+	return 0;
+}
+
+static size_t offset_get(void)
+{
+	size_t offset;
+
+	zassert_equal(dfu_target_mcuboot_offset_get(&offset), 0,
+		      "Offset not obtained");
+	return offset;
+}
+
+static void write_at(size_t offset, size_t len)
+{
+	zassert_equal(dfu_target_mcuboot_write_at(offset, &image[offset], len),
+		      0, "Write failed");
+}
+
+static void write(size_t offset, size_t len)
+{
+	zassert_equal(dfu_target_mcuboot_write(&image[offset], len), 0,
+		      "Write failed");
+}
+
+static void image_check(void)
+{
+	zassert_mem_equal(flash, image, IMAGE_SIZE, "Wrong data in flash");
+	for (size_t i = IMAGE_SIZE; i < ROUND_UP(IMAGE_SIZE, BLOCK_SIZE); i++) {
+		zassert_equal(flash[i], 0xff, "Last block not padded");
+	}
+	zassert_equal(rewrites, 0, "Flash written again without erase");
+}
+
+static void setup(void)
+{
+	for (size_t i = 0; i < sizeof(image); i++) {
+		image[i] = (u8_t)(i * 7 + 3);
+	}
+
+	/* Neither erased nor the image. */
+	(void)memset(flash, 0, sizeof(flash));
+	(void)memset(stored, 0, sizeof(stored));
+	page_size = PAGE_SIZE;
+	rewrites = 0;
+	upgrade_requests = 0;
+	chunk_stores = 0;
+
+	zassert_equal(dfu_target_mcuboot_init(IMAGE_SIZE, NULL), 0,
+		      "Initialization failed");
+}
+
+static void teardown(void)
+{
+	(void)dfu_target_mcuboot_done(false);
+}
+
+static void test_out_of_order(void)
+{
+	write_at(2 * CHUNK_SIZE, IMAGE_SIZE - 2 * CHUNK_SIZE);
+	zassert_equal(offset_get(), 0, "First chunk not written yet");
+
+	write_at(0, CHUNK_SIZE);
+	zassert_equal(offset_get(), CHUNK_SIZE, "Wrong offset");
+
+	write_at(CHUNK_SIZE, CHUNK_SIZE);
+	zassert_equal(offset_get(), IMAGE_SIZE, "Wrong offset");
+
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	zassert_equal(upgrade_requests, 1, "Upgrade not requested");
+	image_check();
+}
+
+static void test_unaligned(void)
+{
+	/* Pieces of odd sizes, which start and end inside blocks and cross
+	 * chunk borders, written backwards.
+	 */
+	static const size_t sizes[] = { 7, 13, 1, 300, 1021, 2, 29 };
+	size_t offsets[ARRAY_SIZE(sizes) * 8];
+	size_t cnt = 0;
+	size_t offset = 0;
+
+	while (offset < IMAGE_SIZE) {
+		offsets[cnt] = offset;
+		offset += MIN(sizes[cnt % ARRAY_SIZE(sizes)],
+			      IMAGE_SIZE - offset);
+		cnt++;
+	}
+
+	for (size_t i = cnt; i > 0; i--) {
+		size_t end = (i < cnt) ? offsets[i] : IMAGE_SIZE;
+
+		zassert_equal(offset_get(), 0, "Image complete too early");
+		write_at(offsets[i - 1], end - offsets[i - 1]);
+	}
+
+	zassert_equal(offset_get(), IMAGE_SIZE, "Image not complete");
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	image_check();
+}
+
+static void test_retried_range(void)
+{
+	/* More bytes than the chunk holds, but not all of it. */
+	write_at(0, CHUNK_SIZE / 2);
+	write_at(0, CHUNK_SIZE / 2);
+	write_at(100, CHUNK_SIZE / 2);
+	write_at(3, 7);
+	zassert_equal(offset_get(), 0, "Chunk complete after retries");
+
+	/* Retried data which is already in flash is not written again. */
+	flash_writes = 0;
+	write_at(16, 32);
+	zassert_equal(flash_writes, 0, "Data written again");
+
+	write_at(CHUNK_SIZE / 2 - 5, CHUNK_SIZE / 2 + 5);
+	zassert_equal(offset_get(), CHUNK_SIZE, "Chunk not complete");
+
+	write_at(CHUNK_SIZE, IMAGE_SIZE - CHUNK_SIZE);
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	image_check();
+}
+
+static void test_partial_blocks_freed(void)
+{
+	/* The partly received blocks are dropped when the whole blocks are
+	 * written, so they do not use up the blocks that can be partly
+	 * received at a time.
+	 */
+	for (size_t i = 0; i < 4; i++) {
+		for (size_t j = 0; j < 8; j++) {
+			write_at(j * BLOCK_SIZE + 1, 2);
+		}
+		write_at(0, 8 * BLOCK_SIZE);
+	}
+
+	write_at(CHUNK_SIZE + 1, 2);
+	write_at(0, IMAGE_SIZE);
+	zassert_equal(offset_get(), IMAGE_SIZE, "Image not complete");
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	image_check();
+}
+
+static void test_done_missing_chunk(void)
+{
+	write_at(0, CHUNK_SIZE);
+	write_at(2 * CHUNK_SIZE, IMAGE_SIZE - 2 * CHUNK_SIZE);
+	write_at(CHUNK_SIZE, CHUNK_SIZE - 1);
+
+	zassert_equal(dfu_target_mcuboot_done(true), -EINVAL,
+		      "Done with a missing chunk");
+	zassert_equal(upgrade_requests, 0, "Upgrade requested");
+
+	write_at(2 * CHUNK_SIZE - 1, 1);
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	zassert_equal(upgrade_requests, 1, "Upgrade not requested");
+	image_check();
+}
+
+static void test_resume(void)
+{
+	write_at(0, CHUNK_SIZE);
+	write_at(CHUNK_SIZE, CHUNK_SIZE / 2);
+
+	/* Reset, the settings are loaded again. */
+	zassert_equal(dfu_target_mcuboot_init(IMAGE_SIZE, NULL), 0,
+		      "Initialization failed");
+	zassert_equal(offset_get(), CHUNK_SIZE, "Progress not restored");
+
+	/* The complete chunk is skipped, the incomplete one is erased and
+	 * written again.
+	 */
+	flash_writes = 0;
+	write_at(0, CHUNK_SIZE);
+	zassert_equal(flash_writes, 0, "Complete chunk written again");
+
+	write_at(CHUNK_SIZE, IMAGE_SIZE - CHUNK_SIZE);
+	zassert_equal(offset_get(), IMAGE_SIZE, "Image not complete");
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	image_check();
+}
+
+static void test_chunks_stored_in_batches(void)
+{
+	/* Less than CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS_BYTES. */
+	write_at(2 * CHUNK_SIZE, IMAGE_SIZE - 2 * CHUNK_SIZE);
+	zassert_equal(chunk_stores, 0, "Chunks stored too early");
+
+	write_at(0, CHUNK_SIZE);
+	zassert_equal(chunk_stores, 1, "Chunks not stored");
+
+	/* Reset, both chunks are stored as complete. */
+	zassert_equal(dfu_target_mcuboot_init(IMAGE_SIZE, NULL), 0,
+		      "Initialization failed");
+	flash_writes = 0;
+	write_at(0, CHUNK_SIZE);
+	write_at(2 * CHUNK_SIZE, IMAGE_SIZE - 2 * CHUNK_SIZE);
+	zassert_equal(flash_writes, 0, "Stored chunks written again");
+
+	write_at(CHUNK_SIZE, CHUNK_SIZE);
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	image_check();
+}
+
+static void test_progress_resume(void)
+{
+	/* Stored after CONFIG_DFU_TARGET_MCUBOOT_SAVE_PROGRESS_BYTES. */
+	write(0, 1500);
+	write(1500, 700);
+
+	/* Reset, writing resumes at the page of the stored offset. */
+	zassert_equal(dfu_target_mcuboot_init(IMAGE_SIZE, NULL), 0,
+		      "Initialization failed");
+	zassert_equal(offset_get(), PAGE_SIZE, "Progress not restored");
+
+	write(PAGE_SIZE, 1000);
+	zassert_equal(offset_get(), PAGE_SIZE + 1000, "Wrong offset");
+	write(PAGE_SIZE + 1000, IMAGE_SIZE - PAGE_SIZE - 1000);
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	zassert_equal(upgrade_requests, 1, "Upgrade not requested");
+	image_check();
+}
+
+static void test_progress_resume_corrupt(void)
+{
+	write(0, 1500);
+	write(1500, 1100);
+
+	/* The data written after the first store does not match. */
+	flash[2 * PAGE_SIZE] ^= 0xff;
+
+	zassert_equal(dfu_target_mcuboot_init(IMAGE_SIZE, NULL), 0,
+		      "Initialization failed");
+	zassert_equal(offset_get(), PAGE_SIZE, "Corrupt data not written again");
+
+	write(PAGE_SIZE, IMAGE_SIZE - PAGE_SIZE);
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	image_check();
+}
+
+static void test_progress_resume_old_format(void)
+{
+	/* Only the offset, as stored by earlier versions. */
+	size_t bytes_written = 2100;
+
+	write(0, bytes_written);
+	zassert_equal(settings_save_one("dfu/mcuboot/flash_img",
+					&bytes_written, sizeof(bytes_written)),
+		      0, "Progress not stored");
+
+	zassert_equal(dfu_target_mcuboot_init(IMAGE_SIZE, NULL), 0,
+		      "Initialization failed");
+	zassert_equal(offset_get(), 2 * PAGE_SIZE, "Progress not restored");
+
+	write(2 * PAGE_SIZE, IMAGE_SIZE - 2 * PAGE_SIZE);
+	zassert_equal(dfu_target_mcuboot_done(true), 0, "Done failed");
+	image_check();
+}
+
+static void test_chunk_not_page_aligned(void)
+{
+	page_size = 2 * CHUNK_SIZE;
+	zassert_equal(dfu_target_mcuboot_init(IMAGE_SIZE, NULL), -EINVAL,
+		      "Chunks smaller than a page accepted");
+	page_size = PAGE_SIZE;
+}
+
+void test_main(void)
+{
+	ztest_test_suite(dfu_target_mcuboot_write_at,
+			 ztest_unit_test_setup_teardown(test_out_of_order,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(test_unaligned,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(test_retried_range,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(test_partial_blocks_freed,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(test_done_missing_chunk,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(test_resume,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				test_chunks_stored_in_batches, setup, teardown),
+			 ztest_unit_test_setup_teardown(test_progress_resume,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				test_progress_resume_corrupt, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				test_progress_resume_old_format, setup,
+				teardown),
+			 ztest_unit_test_setup_teardown(
+				test_chunk_not_page_aligned, setup, teardown)
+	);
+
+	ztest_run_test_suite(dfu_target_mcuboot_write_at);
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include "class_event.h"
+
+
+EVENT_TYPE_DEFINE(high_class_event,
+		  true,
+		  NULL,
+		  NULL);
+
+EVENT_PROC_CLASS_SET(high_class_event, EVENT_PROC_CLASS_HIGH);
+
+EVENT_TYPE_DEFINE(low_class_event,
+		  true,
+		  NULL,
+		  NULL);
+
+EVENT_PROC_CLASS_SET(low_class_event, EVENT_PROC_CLASS_LOW);
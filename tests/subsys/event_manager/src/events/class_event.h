@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef _CLASS_EVENT_H_
+#define _CLASS_EVENT_H_
+
+/**
+ * @brief Processing Class Events
+ * @defgroup class_event Processing Class Events
+ * @{
+ */
+
+#include "event_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct high_class_event {
+	struct event_header header;
+};
+
+EVENT_TYPE_DECLARE(high_class_event);
+
+struct low_class_event {
+	struct event_header header;
+};
+
+EVENT_TYPE_DECLARE(low_class_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _CLASS_EVENT_H_ */
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include "merge_event.h"
+
+
+static bool merge_merge_event(struct event_header *queued,
+			      const struct event_header *eh)
+{
+	struct merge_event *queued_event = cast_merge_event(queued);
+	const struct merge_event *event = cast_merge_event(eh);
+
+	queued_event->val += event->val;
+	queued_event->cnt += event->cnt;
+
+	return true;
+}
+
+EVENT_TYPE_DEFINE(merge_event,
+		  true,
+		  NULL,
+		  NULL);
+
+EVENT_MERGE_FN_SET(merge_event, merge_merge_event);
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include "perf_event.h"
+
+
+/* One additional event is needed as the last event of a batch is still
+ * allocated while the next batch is submitted.
+ */
+EVENT_TYPE_SLAB_DEFINE(perf_event,
+		       false,
+		       NULL,
+		       NULL,
+		       PERF_EVENT_BATCH_CNT + 1);
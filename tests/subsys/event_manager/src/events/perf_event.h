@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef _PERF_EVENT_H_
+#define _PERF_EVENT_H_
+
+/**
+ * @brief Performance Event
+ * @defgroup perf_event Performance Event
+ * @{
+ */
+
+#include "event_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of events submitted at a time by the benchmark. */
+#define PERF_EVENT_BATCH_CNT 16
+
+struct perf_event {
+	struct event_header header;
+
+	u32_t seq;
+};
+
+EVENT_TYPE_SLAB_DECLARE(perf_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _PERF_EVENT_H_ */
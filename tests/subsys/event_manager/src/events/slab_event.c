@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include "slab_event.h"
+
+
+EVENT_TYPE_SLAB_DEFINE(slab_event,
+		       true,
+		       NULL,
+		       NULL,
+		       SLAB_EVENT_CNT);
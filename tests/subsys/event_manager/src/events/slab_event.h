@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef _SLAB_EVENT_H_
+#define _SLAB_EVENT_H_
+
+/**
+ * @brief Slab Event
+ * @defgroup slab_event Slab Event
+ * @{
+ */
+
+#include "event_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SLAB_EVENT_CNT 8
+
+struct slab_event {
+	struct event_header header;
+
+	int val;
+};
+
+EVENT_TYPE_SLAB_DECLARE(slab_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _SLAB_EVENT_H_ */
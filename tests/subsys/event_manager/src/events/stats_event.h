@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#ifndef _STATS_EVENT_H_
+#define _STATS_EVENT_H_
+
+/**
+ * @brief Listener Statistics Event
+ * @defgroup stats_event Listener Statistics Event
+ * @{
+ */
+
+#include "event_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct stats_event {
+	struct event_header header;
+
+	bool consume;
+};
+
+EVENT_TYPE_DECLARE(stats_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _STATS_EVENT_H_ */
@@ -27,6 +27,12 @@ enum test_id {
 	TEST_SUBSCRIBER_ORDER,
 	TEST_OOM_RESET,
 	TEST_MULTICONTEXT,
+	TEST_MEM_SLAB,
+	TEST_BENCHMARK,
+	TEST_PROC_CLASS,
+	TEST_EVENT_MERGE,
+	TEST_STRESS,
+	TEST_LISTENER_STATS,
 
 	TEST_CNT
 };
@@ -59,6 +59,36 @@ static void test_multicontext(void)
 	test_start(TEST_MULTICONTEXT);
 }
 
+static void test_mem_slab(void)
+{
+	test_start(TEST_MEM_SLAB);
+}
+
+static void test_benchmark(void)
+{
+	test_start(TEST_BENCHMARK);
+}
+
+static void test_proc_class(void)
+{
+	test_start(TEST_PROC_CLASS);
+}
+
+static void test_event_merge(void)
+{
+	test_start(TEST_EVENT_MERGE);
+}
+
+static void test_stress(void)
+{
+	test_start(TEST_STRESS);
+}
+
+static void test_listener_stats(void)
+{
+	test_start(TEST_LISTENER_STATS);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(event_manager_tests,
@@ -68,7 +98,13 @@ void test_main(void)
 			 ztest_unit_test(test_event_order),
 			 ztest_unit_test(test_subs_order),
 			 ztest_unit_test(test_oom_reset),
-			 ztest_unit_test(test_multicontext)
+			 ztest_unit_test(test_multicontext),
+			 ztest_unit_test(test_mem_slab),
+			 ztest_unit_test(test_benchmark),
+			 ztest_unit_test(test_proc_class),
+			 ztest_unit_test(test_event_merge),
+			 ztest_unit_test(test_stress),
+			 ztest_unit_test(test_listener_stats)
 			 );
 
 	ztest_run_test_suite(event_manager_tests);
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <test_events.h>
+#include <perf_event.h>
+
+#define MODULE test_benchmark
+#define PERF_EVENT_CNT 4096
+
+BUILD_ASSERT((PERF_EVENT_CNT % PERF_EVENT_BATCH_CNT) == 0,
+	     "Event count must be a multiple of batch size");
+
+static enum test_id cur_test_id;
+static u32_t start_cycles;
+static u32_t notify_cnt;
+
+
+static void submit_batch(u32_t first_seq)
+{
+	for (size_t i = 0; i < PERF_EVENT_BATCH_CNT; i++) {
+		struct perf_event *event = new_perf_event();
+
+		event->seq = first_seq + i;
+		EVENT_SUBMIT(event);
+	}
+}
+
+static void report(u32_t cycles)
+{
+	u32_t cycles_per_event = cycles / PERF_EVENT_CNT;
+	u64_t events_per_sec = (u64_t)PERF_EVENT_CNT *
+			       sys_clock_hw_cycles_per_sec() / MAX(cycles, 1);
+
+	printk("Event Manager benchmark (%s):\n",
+	       IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_DISPATCH_TABLE) ?
+	       "dispatch table" : "subscriber sections");
+	printk("\tevents: %u, subscribers per event: 4\n", PERF_EVENT_CNT);
+	printk("\tcycles per dispatch: %u\n", cycles_per_event);
+	printk("\tevents per second: %u\n", (u32_t)events_per_sec);
+}
+
+static bool event_handler_passive(const struct event_header *eh)
+{
+	if (is_perf_event(eh)) {
+		notify_cnt++;
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+static bool event_handler(const struct event_header *eh)
+{
+	if (is_test_start_event(eh)) {
+		struct test_start_event *st = cast_test_start_event(eh);
+
+		cur_test_id = st->test_id;
+
+		if (cur_test_id == TEST_BENCHMARK) {
+			notify_cnt = 0;
+			start_cycles = k_cycle_get_32();
+			submit_batch(0);
+		}
+
+		return false;
+	}
+
+	if (is_perf_event(eh)) {
+		struct perf_event *event = cast_perf_event(eh);
+
+		zassert_equal(cur_test_id, TEST_BENCHMARK, "Unexpected event");
+
+		notify_cnt++;
+
+		if (((event->seq + 1) % PERF_EVENT_BATCH_CNT) != 0) {
+			return false;
+		}
+
+		if (event->seq + 1 < PERF_EVENT_CNT) {
+			submit_batch(event->seq + 1);
+			return false;
+		}
+
+		report(k_cycle_get_32() - start_cycles);
+
+		zassert_equal(notify_cnt, 4 * PERF_EVENT_CNT,
+			      "Missing notifications");
+
+		struct test_end_event *te = new_test_end_event();
+
+		te->test_id = TEST_BENCHMARK;
+		EVENT_SUBMIT(te);
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+EVENT_LISTENER(MODULE, event_handler);
+EVENT_SUBSCRIBE(MODULE, test_start_event);
+EVENT_SUBSCRIBE_FINAL(MODULE, perf_event);
+
+EVENT_LISTENER(bench_early, event_handler_passive);
+EVENT_SUBSCRIBE_EARLY(bench_early, perf_event);
+
+EVENT_LISTENER(bench_normal1, event_handler_passive);
+EVENT_SUBSCRIBE(bench_normal1, perf_event);
+
+EVENT_LISTENER(bench_normal2, event_handler_passive);
+EVENT_SUBSCRIBE(bench_normal2, perf_event);
@@ -19,3 +19,11 @@
 
 /* TEST_EVENT_ORDER */
 #define TEST_EVENT_ORDER_CNT 20
+
+
+/* TEST_EVENT_MERGE */
+#define TEST_EVENT_MERGE_CNT 10
+
+
+/* TEST_LISTENER_STATS */
+#define TEST_LISTENER_STATS_CNT 10
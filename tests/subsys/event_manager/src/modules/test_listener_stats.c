@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <ztest.h>
+
+#include <test_events.h>
+#include <stats_event.h>
+
+#include "test_config.h"
+
+
+static enum test_id cur_test_id;
+static int final_cnt;
+
+static bool event_handler_early(const struct event_header *eh)
+{
+	if (is_test_start_event(eh)) {
+		struct test_start_event *st = cast_test_start_event(eh);
+
+		cur_test_id = st->test_id;
+
+		if (cur_test_id == TEST_LISTENER_STATS) {
+			for (size_t i = 0; i < TEST_LISTENER_STATS_CNT; i++) {
+				struct stats_event *event = new_stats_event();
+
+				/* Every second event is consumed, starting
+				 * with the first one.
+				 */
+				event->consume = ((i % 2) == 0);
+				EVENT_SUBMIT(event);
+			}
+		}
+
+		return false;
+	}
+
+	if (is_stats_event(eh)) {
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+	return false;
+}
+
+EVENT_LISTENER(stats_early, event_handler_early);
+EVENT_SUBSCRIBE_EARLY(stats_early, stats_event);
+EVENT_SUBSCRIBE(stats_early, test_start_event);
+
+
+static bool event_handler_consumer(const struct event_header *eh)
+{
+	if (is_stats_event(eh)) {
+		return cast_stats_event(eh)->consume;
+	}
+
+	zassert_true(false, "Wrong event type received");
+	return false;
+}
+
+EVENT_LISTENER(stats_consumer, event_handler_consumer);
+EVENT_SUBSCRIBE(stats_consumer, stats_event);
+
+
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS
+static void stats_check(const struct event_type *et, const char *listener_name,
+			u32_t call_cnt)
+{
+	const struct event_subscriber *found = NULL;
+	struct event_subscriber_stats stats;
+
+	for (size_t prio = SUBS_PRIO_MIN; prio <= SUBS_PRIO_MAX; prio++) {
+		for (const struct event_subscriber *es = et->subs_start[prio];
+		     es != et->subs_stop[prio];
+		     es++) {
+			if (!strcmp(es->listener->name, listener_name)) {
+				found = es;
+			}
+		}
+	}
+
+	zassert_not_null(found, "No statistics");
+	event_manager_listener_stats_get(found, &stats);
+
+	zassert_equal(stats.call_cnt, call_cnt, "Wrong number of calls");
+	zassert_true(stats.min_cycles <= stats.max_cycles,
+		     "Minimum above maximum");
+	zassert_true(stats.total_cycles >=
+		     (u64_t)stats.min_cycles * stats.call_cnt,
+		     "Total below minimum");
+	zassert_true(stats.total_cycles <=
+		     (u64_t)stats.max_cycles * stats.call_cnt,
+		     "Total above maximum");
+}
+#endif
+
+static bool event_handler_final(const struct event_header *eh)
+{
+	if (is_stats_event(eh)) {
+		zassert_false(cast_stats_event(eh)->consume,
+			      "Consumed event received");
+
+		final_cnt++;
+		if (final_cnt < TEST_LISTENER_STATS_CNT / 2) {
+			return false;
+		}
+
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LISTENER_STATS
+		/* Every event reached the earlier listeners, the consumed
+		 * ones did not reach this one. Its statistics are updated
+		 * after it returns.
+		 */
+		stats_check(eh->type_id, "stats_early",
+			    TEST_LISTENER_STATS_CNT);
+		stats_check(eh->type_id, "stats_consumer",
+			    TEST_LISTENER_STATS_CNT);
+		stats_check(eh->type_id, "stats_final",
+			    TEST_LISTENER_STATS_CNT / 2 - 1);
+
+		event_manager_listener_stats_reset();
+		stats_check(eh->type_id, "stats_early", 0);
+#endif
+
+		struct test_end_event *te = new_test_end_event();
+
+		te->test_id = cur_test_id;
+		EVENT_SUBMIT(te);
+
+		return false;
+	}
+
+	zassert_true(false, "Wrong event type received");
+	return false;
+}
+
+EVENT_LISTENER(stats_final, event_handler_final);
+EVENT_SUBSCRIBE_FINAL(stats_final, stats_event);
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <test_events.h>
+#include <slab_event.h>
+
+#define MODULE test_mem_slab
+
+static enum test_id cur_test_id;
+static int received_cnt;
+
+static bool event_handler(const struct event_header *eh)
+{
+	if (is_test_start_event(eh)) {
+		struct test_start_event *st = cast_test_start_event(eh);
+
+		cur_test_id = st->test_id;
+
+		if (cur_test_id != TEST_MEM_SLAB) {
+			return false;
+		}
+
+		const struct event_type *et = NULL;
+		struct event_mem_slab_stats stats;
+
+		/* Use all blocks of the slab. */
+		for (size_t i = 0; i < SLAB_EVENT_CNT; i++) {
+			struct slab_event *event = new_slab_event();
+
+			et = event->header.type_id;
+			event->val = i;
+			EVENT_SUBMIT(event);
+		}
+
+		zassert_equal(event_manager_mem_slab_stats_get(et, &stats), 0,
+			      "Memory slab not assigned");
+		zassert_equal(stats.used, SLAB_EVENT_CNT, "Wrong usage");
+		zassert_equal(stats.max_used, SLAB_EVENT_CNT,
+			      "Wrong high watermark");
+		zassert_equal(stats.total, SLAB_EVENT_CNT, "Wrong slab size");
+		zassert_is_null(_event_mem_slab_alloc(et->mem_slab),
+				"Allocated from exhausted slab");
+
+		zassert_equal(event_manager_mem_slab_stats_get(et, &stats), 0,
+			      "Memory slab not assigned");
+		zassert_equal(stats.alloc_fail_cnt, 1,
+			      "Allocation failure not counted");
+		zassert_equal(event_manager_mem_slab_stats_get(eh->type_id,
+							       &stats),
+			      -ENOENT, "Heap event type has a memory slab");
+
+		return false;
+	}
+
+	if (is_slab_event(eh)) {
+		if (cur_test_id == TEST_MEM_SLAB) {
+			struct slab_event *event = cast_slab_event(eh);
+
+			zassert_equal(event->val, received_cnt,
+				      "Incorrect event order");
+			received_cnt++;
+
+			if (received_cnt == SLAB_EVENT_CNT) {
+				struct test_end_event *te =
+					new_test_end_event();
+
+				te->test_id = TEST_MEM_SLAB;
+				EVENT_SUBMIT(te);
+			}
+		}
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+EVENT_LISTENER(MODULE, event_handler);
+EVENT_SUBSCRIBE(MODULE, slab_event);
+EVENT_SUBSCRIBE(MODULE, test_start_event);
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <test_events.h>
+#include <merge_event.h>
+#include <order_event.h>
+
+#include "test_config.h"
+
+#define MODULE test_merge
+
+static enum test_id cur_test_id;
+static int received_val;
+static int received_cnt;
+static int event_cnt;
+
+
+static void submit_merge_event(int val)
+{
+	struct merge_event *event = new_merge_event();
+
+	event->val = val;
+	event->cnt = 1;
+	EVENT_SUBMIT(event);
+}
+
+static bool event_handler(const struct event_header *eh)
+{
+	if (is_test_start_event(eh)) {
+		struct test_start_event *st = cast_test_start_event(eh);
+
+		cur_test_id = st->test_id;
+
+		if (cur_test_id == TEST_EVENT_MERGE) {
+			for (size_t i = 0; i < TEST_EVENT_MERGE_CNT; i++) {
+				submit_merge_event(i);
+			}
+
+			/* Events queued after another event type are merged
+			 * as well, as the merged event is still pending.
+			 */
+			struct order_event *event = new_order_event();
+
+			EVENT_SUBMIT(event);
+
+			submit_merge_event(TEST_EVENT_MERGE_CNT);
+		}
+
+		return false;
+	}
+
+	if (is_merge_event(eh)) {
+		struct merge_event *event = cast_merge_event(eh);
+
+		zassert_equal(cur_test_id, TEST_EVENT_MERGE,
+			      "Unexpected event");
+
+		received_val += event->val;
+		received_cnt += event->cnt;
+		event_cnt++;
+
+		if (received_cnt < TEST_EVENT_MERGE_CNT + 1) {
+			return false;
+		}
+
+		zassert_equal(received_val,
+			      TEST_EVENT_MERGE_CNT * (TEST_EVENT_MERGE_CNT + 1) / 2,
+			      "Wrong merged value");
+
+		if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_EVENT_MERGE)) {
+			zassert_equal(event_cnt, 1, "Events not merged");
+		} else {
+			zassert_equal(event_cnt, TEST_EVENT_MERGE_CNT + 1,
+				      "Events merged");
+		}
+
+		struct test_end_event *te = new_test_end_event();
+
+		te->test_id = TEST_EVENT_MERGE;
+		EVENT_SUBMIT(te);
+
+		return false;
+	}
+
+	if (is_order_event(eh)) {
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+EVENT_LISTENER(MODULE, event_handler);
+EVENT_SUBSCRIBE(MODULE, merge_event);
+EVENT_SUBSCRIBE(MODULE, order_event);
+EVENT_SUBSCRIBE(MODULE, test_start_event);
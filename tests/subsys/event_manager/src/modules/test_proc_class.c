@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <test_events.h>
+#include <class_event.h>
+#include <order_event.h>
+
+#define MODULE test_proc_class
+
+enum received_class {
+	RECEIVED_HIGH,
+	RECEIVED_NORMAL,
+	RECEIVED_LOW,
+
+	RECEIVED_CNT
+};
+
+static enum test_id cur_test_id;
+static enum received_class received[RECEIVED_CNT];
+static size_t received_cnt;
+
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+#define HIST_CNT (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_PROC_CLASSES) ? \
+		  EVENT_PROC_CLASS_COUNT : 1)
+
+static u32_t latency_cnt_start[EVENT_PROC_CLASS_COUNT];
+
+static u32_t latency_cnt_get(enum event_proc_class proc_class)
+{
+	const u32_t *hist = event_manager_latency_hist_get(proc_class);
+	u32_t cnt = 0;
+
+	for (size_t b = 0; b < EVENT_MANAGER_LATENCY_HIST_BUCKET_CNT; b++) {
+		cnt += hist[b];
+	}
+
+	return cnt;
+}
+
+static void latency_cnt_check(enum event_proc_class proc_class,
+			      u32_t event_cnt)
+{
+	zassert_equal(latency_cnt_get(proc_class) -
+		      latency_cnt_start[proc_class], event_cnt,
+		      "Wrong latency histogram of class %d", proc_class);
+}
+#endif
+
+
+static void event_received(enum received_class rc)
+{
+	zassert_true(received_cnt < RECEIVED_CNT, "Too many events");
+	received[received_cnt] = rc;
+	received_cnt++;
+
+	if (received_cnt < RECEIVED_CNT) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_PROC_CLASSES)) {
+		/* Higher priority classes are processed first. */
+		zassert_equal(received[0], RECEIVED_HIGH, "Wrong order");
+		zassert_equal(received[1], RECEIVED_NORMAL, "Wrong order");
+		zassert_equal(received[2], RECEIVED_LOW, "Wrong order");
+	} else {
+		/* Events are processed in order of submission. */
+		zassert_equal(received[0], RECEIVED_LOW, "Wrong order");
+		zassert_equal(received[1], RECEIVED_NORMAL, "Wrong order");
+		zassert_equal(received[2], RECEIVED_HIGH, "Wrong order");
+	}
+
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+	/* Latency of every event is counted before it is dispatched. */
+	if (IS_ENABLED(CONFIG_DESKTOP_EVENT_MANAGER_PROC_CLASSES)) {
+		latency_cnt_check(EVENT_PROC_CLASS_HIGH, 1);
+		latency_cnt_check(EVENT_PROC_CLASS_NORMAL, 1);
+		latency_cnt_check(EVENT_PROC_CLASS_LOW, 1);
+	} else {
+		latency_cnt_check(0, RECEIVED_CNT);
+	}
+#endif
+
+	struct test_end_event *te = new_test_end_event();
+
+	te->test_id = TEST_PROC_CLASS;
+	EVENT_SUBMIT(te);
+}
+
+static bool event_handler(const struct event_header *eh)
+{
+	if (is_test_start_event(eh)) {
+		struct test_start_event *st = cast_test_start_event(eh);
+
+		cur_test_id = st->test_id;
+
+		if (cur_test_id == TEST_PROC_CLASS) {
+#ifdef CONFIG_DESKTOP_EVENT_MANAGER_LATENCY_HIST
+			for (size_t c = 0; c < HIST_CNT; c++) {
+				latency_cnt_start[c] = latency_cnt_get(c);
+			}
+#endif
+
+			/* Submit events in reversed priority order. */
+			struct low_class_event *low = new_low_class_event();
+
+			EVENT_SUBMIT(low);
+
+			struct order_event *normal = new_order_event();
+
+			EVENT_SUBMIT(normal);
+
+			struct high_class_event *high = new_high_class_event();
+
+			EVENT_SUBMIT(high);
+		}
+
+		return false;
+	}
+
+	if (is_high_class_event(eh)) {
+		event_received(RECEIVED_HIGH);
+		return false;
+	}
+
+	if (is_low_class_event(eh)) {
+		event_received(RECEIVED_LOW);
+		return false;
+	}
+
+	if (is_order_event(eh)) {
+		if (cur_test_id == TEST_PROC_CLASS) {
+			event_received(RECEIVED_NORMAL);
+		}
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+EVENT_LISTENER(MODULE, event_handler);
+EVENT_SUBSCRIBE(MODULE, high_class_event);
+EVENT_SUBSCRIBE(MODULE, low_class_event);
+EVENT_SUBSCRIBE(MODULE, order_event);
+EVENT_SUBSCRIBE(MODULE, test_start_event);
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <test_events.h>
+#include <stress_event.h>
+
+#define MODULE test_stress
+#define THREAD_STACK_SIZE 400
+#define PRODUCER_CNT 4
+#define PRODUCER_EVENT_CNT 200
+#define ISR_EVENT_CNT 100
+
+/* Producer threads use the first sources, timer ISR uses the last one. */
+#define SOURCE_ISR PRODUCER_CNT
+#define SOURCE_CNT (PRODUCER_CNT + 1)
+#define EVENT_CNT (PRODUCER_CNT * PRODUCER_EVENT_CNT + ISR_EVENT_CNT)
+
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, PRODUCER_CNT,
+				   THREAD_STACK_SIZE);
+static struct k_thread producer_threads[PRODUCER_CNT];
+
+static enum test_id cur_test_id;
+static u16_t next_seq[SOURCE_CNT];
+static u16_t isr_seq;
+static size_t received_cnt;
+
+
+static void send_event(u8_t source, u16_t seq)
+{
+	struct stress_event *event = new_stress_event();
+
+	event->source = source;
+	event->seq = seq;
+	EVENT_SUBMIT(event);
+}
+
+static void timer_handler(struct k_timer *timer)
+{
+	send_event(SOURCE_ISR, isr_seq);
+
+	isr_seq++;
+	if (isr_seq == ISR_EVENT_CNT) {
+		k_timer_stop(timer);
+	}
+}
+
+static K_TIMER_DEFINE(stress_timer, timer_handler, NULL);
+
+static void producer_fn(void *p1, void *p2, void *p3)
+{
+	u8_t source = POINTER_TO_UINT(p1);
+
+	for (u16_t seq = 0; seq < PRODUCER_EVENT_CNT; seq++) {
+		send_event(source, seq);
+
+		/* Let other producers and the timer interrupt race with
+		 * this one.
+		 */
+		k_busy_wait(50 * (source + 1));
+	}
+}
+
+static void start_test(void)
+{
+	isr_seq = 0;
+	k_timer_start(&stress_timer, K_MSEC(1), K_MSEC(1));
+
+	/* All producers are preemptible and use different priorities. */
+	for (size_t i = 0; i < PRODUCER_CNT; i++) {
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				THREAD_STACK_SIZE, producer_fn,
+				UINT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1 + (i % 2)), 0, K_NO_WAIT);
+	}
+}
+
+static bool event_handler(const struct event_header *eh)
+{
+	if (is_test_start_event(eh)) {
+		struct test_start_event *st = cast_test_start_event(eh);
+
+		cur_test_id = st->test_id;
+
+		if (cur_test_id == TEST_STRESS) {
+			start_test();
+		}
+
+		return false;
+	}
+
+	if (is_stress_event(eh)) {
+		struct stress_event *event = cast_stress_event(eh);
+
+		zassert_equal(cur_test_id, TEST_STRESS, "Unexpected event");
+		zassert_true(event->source < SOURCE_CNT, "Invalid source");
+		zassert_equal(event->seq, next_seq[event->source],
+			      "Event lost or reordered");
+
+		next_seq[event->source]++;
+		received_cnt++;
+
+		if (received_cnt == EVENT_CNT) {
+			struct test_end_event *te = new_test_end_event();
+
+			te->test_id = TEST_STRESS;
+			EVENT_SUBMIT(te);
+		}
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+EVENT_LISTENER(MODULE, event_handler);
+EVENT_SUBSCRIBE(MODULE, stress_event);
+EVENT_SUBSCRIBE(MODULE, test_start_event);
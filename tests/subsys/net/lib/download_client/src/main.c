@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr.h>
+#include <ztest.h>
+#include <net/socket.h>
+#include <net/socket_offload.h>
+#include <net/download_client.h>
+
+#define HOST "example.com"
+#define FILE_NAME "firmware.bin"
+
+#define FILE_SIZE (16 * CONFIG_DOWNLOAD_CLIENT_MAX_FRAGMENT_SIZE)
+/* Latency of the first response bytes after a request is received. */
+#define LATENCY_MS 100
+/* Largest chunk of data returned by a single recv() call. */
+#define SEGMENT_SIZE 512
+/* Time to receive a segment, limiting the throughput of a connection. */
+#define SEGMENT_MS 10
+/* Concurrent connections to the fake server. */
+#define CONN_CNT 4
+
+#define DOWNLOAD_TIMEOUT K_SECONDS(30)
+
+/* Fake HTTP server, serving a file with a known pattern. */
+static struct {
+	struct {
+		bool open;
+		char request[256];
+		size_t request_len;
+		char header[128];
+		size_t header_len;
+		size_t header_sent;
+		size_t body_pos;
+		size_t body_end;
+		bool response_started;
+	} conn[CONN_CNT];
+	/* A connection is dropped after sending this many body bytes. */
+	size_t drop_after;
+	size_t request_cnt;
+} server;
+
+/* Lent to the client, smaller than a fragment. */
+#define APP_BUF_SIZE 700
+
+static struct {
+	size_t received;
+	size_t next_offset;
+	size_t fragment_cnt;
+	size_t out_of_order_cnt;
+	size_t error_cnt;
+	bool corrupted;
+	bool app_buf_misplaced;
+	u32_t elapsed_ms;
+} client_state;
+
+static u8_t app_buf[APP_BUF_SIZE];
+static bool app_buf_lent;
+
+static struct download_client client;
+static K_SEM_DEFINE(download_done, 0, 1);
+
+static u8_t file_byte(size_t off)
+{
+	return (off * 7 + (off >> 8)) & 0xff;
+}
+
+static void request_handle(int sock)
+{
+	unsigned int from;
+	unsigned int to = FILE_SIZE - 1;
+	char *range = strstr(server.conn[sock].request, "Range: bytes=");
+
+	zassert_not_null(range, "Range header missing");
+	range += strlen("Range: bytes=");
+
+	from = strtoul(range, &range, 10);
+	zassert_equal(*range, '-', "Malformed range");
+	range++;
+	if (*range != '\r') {
+		to = MIN(strtoul(range, NULL, 10), FILE_SIZE - 1);
+	}
+
+	server.conn[sock].header_len = snprintf(server.conn[sock].header,
+		sizeof(server.conn[sock].header),
+		"HTTP/1.1 206 Partial Content\r\n"
+		"Content-Range: bytes %u-%u/%u\r\n"
+		"Content-Length: %u\r\n"
+		"\r\n",
+		from, to, FILE_SIZE, to - from + 1);
+	server.conn[sock].header_sent = 0;
+	server.conn[sock].body_pos = from;
+	server.conn[sock].body_end = to + 1;
+	server.conn[sock].response_started = false;
+	server.conn[sock].request_len = 0;
+	server.request_cnt++;
+}
+
+static int fake_socket(int family, int type, int proto)
+{
+	for (int sock = 0; sock < CONN_CNT; sock++) {
+		if (!server.conn[sock].open) {
+			memset(&server.conn[sock], 0, sizeof(server.conn[sock]));
+			server.conn[sock].open = true;
+			return sock;
+		}
+	}
+
+	errno = ENFILE;
+	return -1;
+}
+
+static int fake_close(int sock)
+{
+	server.conn[sock].open = false;
+	return 0;
+}
+
+static int fake_connect(int sock, const struct sockaddr *addr,
+			socklen_t addrlen)
+{
+	return 0;
+}
+
+static int fake_setsockopt(int sock, int level, int optname,
+			   const void *optval, socklen_t optlen)
+{
+	return 0;
+}
+
+static ssize_t fake_send(int sock, const void *buf, size_t len, int flags)
+{
+	char *request = server.conn[sock].request;
+	size_t *request_len = &server.conn[sock].request_len;
+
+	zassert_true(*request_len + len < sizeof(server.conn[sock].request),
+		     "Request too long");
+
+	k_sched_lock();
+
+	memcpy(request + *request_len, buf, len);
+	*request_len += len;
+	request[*request_len] = '\0';
+
+	if (strstr(request, "\r\n\r\n")) {
+		request_handle(sock);
+	}
+
+	k_sched_unlock();
+
+	return len;
+}
+
+static ssize_t fake_recv(int sock, void *buf, size_t max_len, int flags)
+{
+	u8_t *dst = buf;
+	size_t len = 0;
+
+	if (!server.conn[sock].response_started) {
+		server.conn[sock].response_started = true;
+		k_sleep(K_MSEC(LATENCY_MS));
+	}
+
+	k_sched_lock();
+
+	if (server.drop_after == 0) {
+		server.drop_after = SIZE_MAX;
+		k_sched_unlock();
+		/* Peer closed connection. */
+		return 0;
+	}
+
+	max_len = MIN(max_len, SEGMENT_SIZE);
+
+	while ((len < max_len) &&
+	       (server.conn[sock].header_sent < server.conn[sock].header_len)) {
+		dst[len++] = server.conn[sock].header[
+			server.conn[sock].header_sent++];
+	}
+
+	while ((len < max_len) &&
+	       (server.conn[sock].body_pos < server.conn[sock].body_end) &&
+	       (server.drop_after > 0)) {
+		dst[len++] = file_byte(server.conn[sock].body_pos++);
+		server.drop_after--;
+	}
+
+	k_sched_unlock();
+
+	/* Blocking socket without data would wait forever. */
+	zassert_true(len > 0, "Client waits for data not requested");
+
+	k_sleep(K_MSEC(SEGMENT_MS));
+
+	return len;
+}
+
+static struct zsock_addrinfo fake_addrinfo;
+static struct sockaddr_in fake_addr = {
+	.sin_family = AF_INET,
+};
+
+static int fake_getaddrinfo(const char *node, const char *service,
+			    const struct zsock_addrinfo *hints,
+			    struct zsock_addrinfo **res)
+{
+	fake_addrinfo.ai_family = AF_INET;
+	fake_addrinfo.ai_socktype = SOCK_STREAM;
+	fake_addrinfo.ai_addr = (struct sockaddr *)&fake_addr;
+	fake_addrinfo.ai_addrlen = sizeof(fake_addr);
+	fake_addrinfo.ai_next = NULL;
+	*res = &fake_addrinfo;
+
+	return 0;
+}
+
+static void fake_freeaddrinfo(struct zsock_addrinfo *res)
+{
+}
+
+static const struct socket_offload fake_server_ops = {
+	.socket = fake_socket,
+	.close = fake_close,
+	.connect = fake_connect,
+	.setsockopt = fake_setsockopt,
+	.send = fake_send,
+	.recv = fake_recv,
+	.getaddrinfo = fake_getaddrinfo,
+	.freeaddrinfo = fake_freeaddrinfo,
+};
+
+static int download_client_callback(const struct download_client_evt *event)
+{
+	const u8_t *data;
+	size_t offset;
+
+	switch (event->id) {
+	case DOWNLOAD_CLIENT_EVT_FRAGMENT:
+		data = event->fragment.buf;
+		offset = event->fragment.offset;
+		if (app_buf_lent &&
+		    ((data != app_buf) ||
+		     (event->fragment.len > APP_BUF_SIZE))) {
+			client_state.app_buf_misplaced = true;
+		}
+		if (offset != client_state.next_offset) {
+			client_state.out_of_order_cnt++;
+		}
+		for (size_t i = 0; i < event->fragment.len; i++) {
+			if (data[i] != file_byte(offset + i)) {
+				client_state.corrupted = true;
+			}
+		}
+		client_state.next_offset = offset + event->fragment.len;
+		client_state.received += event->fragment.len;
+		client_state.fragment_cnt++;
+		break;
+	case DOWNLOAD_CLIENT_EVT_ERROR:
+		client_state.error_cnt++;
+		/* Let the client reconnect and resume. */
+		return 0;
+	case DOWNLOAD_CLIENT_EVT_DONE:
+		k_sem_give(&download_done);
+		break;
+	}
+
+	return 0;
+}
+
+static void download_run(size_t drop_after, bool out_of_order)
+{
+	int err;
+	u32_t start;
+	const struct download_client_cfg cfg = {
+		.sec_tag = -1,
+		.out_of_order = out_of_order,
+	};
+
+	server.drop_after = drop_after;
+	server.request_cnt = 0;
+	memset(&client_state, 0, sizeof(client_state));
+
+	err = download_client_connect(&client, HOST, &cfg);
+	zassert_equal(err, 0, "Failed to connect: %d", err);
+
+	start = k_uptime_get_32();
+
+	err = download_client_start(&client, FILE_NAME, 0);
+	zassert_equal(err, 0, "Failed to start download: %d", err);
+
+	err = k_sem_take(&download_done, DOWNLOAD_TIMEOUT);
+	zassert_equal(err, 0, "Download timed out");
+
+	client_state.elapsed_ms = k_uptime_get_32() - start;
+
+	printk("Downloaded %u bytes in %u fragments, %u requests, %u ms\n",
+	       client_state.received, client_state.fragment_cnt,
+	       server.request_cnt, client_state.elapsed_ms);
+
+	zassert_equal(client_state.received, FILE_SIZE, "Wrong file size");
+	zassert_false(client_state.corrupted, "Wrong file content");
+
+	err = download_client_disconnect(&client);
+	zassert_equal(err, 0, "Failed to disconnect: %d", err);
+}
+
+/* Connections in parallel wait for the latency of their first response
+ * at the same time. Over a single connection, the latency of each request
+ * adds up, so the download takes this long at least.
+ */
+#define SINGLE_CONN_MS \
+	((FILE_SIZE / CONFIG_DOWNLOAD_CLIENT_MAX_FRAGMENT_SIZE) * LATENCY_MS)
+
+static void parallel_speedup_check(void)
+{
+	if (!IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_PARALLEL)) {
+		return;
+	}
+
+	zassert_true(client_state.elapsed_ms < SINGLE_CONN_MS / 2,
+		     "Download took %u ms, no faster than %u ms over "
+		     "a single connection", client_state.elapsed_ms,
+		     SINGLE_CONN_MS);
+}
+
+static void test_download(void)
+{
+	download_run(SIZE_MAX, false);
+
+	zassert_equal(client_state.error_cnt, 0, "Unexpected error");
+	zassert_equal(client_state.out_of_order_cnt, 0,
+		      "Fragment out of order");
+
+	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_PARALLEL)) {
+		/* First fragment, then one range per connection. */
+		zassert_equal(server.request_cnt,
+			      CONFIG_DOWNLOAD_CLIENT_PARALLEL_CONN_CNT + 1,
+			      "One request per connection expected");
+	} else if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_STREAM)) {
+		zassert_equal(server.request_cnt, 1,
+			      "Single request expected");
+	} else {
+		zassert_equal(server.request_cnt,
+			      FILE_SIZE / CONFIG_DOWNLOAD_CLIENT_MAX_FRAGMENT_SIZE,
+			      "One request per fragment expected");
+		zassert_equal(client_state.fragment_cnt, server.request_cnt,
+			      "One fragment per response expected");
+	}
+
+	parallel_speedup_check();
+}
+
+static void test_download_resume(void)
+{
+	/* Drop the connection in the middle of a fragment. */
+	download_run(FILE_SIZE / 2 + SEGMENT_SIZE / 2, false);
+
+	zassert_equal(client_state.error_cnt, 1, "Error expected");
+	zassert_equal(client_state.out_of_order_cnt, 0,
+		      "Fragment out of order");
+
+	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_STREAM) &&
+	    !IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_PARALLEL)) {
+		zassert_equal(server.request_cnt, 2,
+			      "Request after reconnect expected");
+	}
+}
+
+static void test_download_out_of_order(void)
+{
+	/* Each byte is checked against its offset. */
+	download_run(SIZE_MAX, true);
+
+	zassert_equal(client_state.error_cnt, 0, "Unexpected error");
+	parallel_speedup_check();
+}
+
+static void test_download_buf_lend(void)
+{
+	int err;
+
+	err = download_client_buf_set(&client, app_buf, sizeof(app_buf));
+	if (IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_PIPELINE) ||
+	    IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_PARALLEL)) {
+		zassert_equal(err, -ENOTSUP, "Buffer lent to several buffers");
+		return;
+	}
+	zassert_equal(err, 0, "Failed to lend buffer: %d", err);
+	app_buf_lent = true;
+
+	download_run(SIZE_MAX, false);
+
+	zassert_false(client_state.app_buf_misplaced,
+		      "Fragment not at the start of the lent buffer");
+	if (!IS_ENABLED(CONFIG_DOWNLOAD_CLIENT_STREAM)) {
+		zassert_equal(client_state.fragment_cnt, server.request_cnt,
+			      "One fragment per response expected");
+	}
+
+	err = download_client_buf_set(&client, NULL, 0);
+	zassert_equal(err, 0, "Failed to release buffer: %d", err);
+	app_buf_lent = false;
+}
+
+void test_main(void)
+{
+	socket_offload_register(&fake_server_ops);
+	download_client_init(&client, download_client_callback);
+
+	ztest_test_suite(lib_download_client_test,
+			 ztest_unit_test(test_download),
+			 ztest_unit_test(test_download_resume),
+			 ztest_unit_test(test_download_out_of_order),
+			 ztest_unit_test(test_download_buf_lend)
+	);
+
+	ztest_run_test_suite(lib_download_client_test);
+}
@@ -54,6 +54,11 @@ int dfu_target_write(const void *const buf, size_t len)
 	return 0;
 }
 
+int dfu_target_write_at(size_t offset, const void *const buf, size_t len)
+{
+	return -ENOTSUP;
+}
+
 int dfu_target_done(bool successful)
 {
 	return 0;
@@ -0,0 +1,620 @@
+/*
+ * Copyright (c) 2020 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-BSD-5-Clause-Nordic
+ */
+
+#include <string.h>
+#include <zephyr.h>
+#include <ztest.h>
+#include <cJSON.h>
+#include <cJSON_os.h>
+#include "nrf_cloud_codec.h"
+#include "nrf_cloud_json.h"
+
+#define BENCHMARK_ITERATIONS 100
+#define FUZZ_ITERATIONS 2000
+#define ENDPOINT_LEN_MAX 64
+
+static const char gps_data[] =
+	"$GPGGA,121042.00,6325.6750,N,01024.6543,E,1,07,1.2,41.2,M,,M,,*61";
+/* Characters that cJSON escapes. */
+static const char escaped_data[] = "\"quoted\" back\\slash \b\f\n\r\t \x01\x1f";
+
+/* Control channel messages, as received from nRF Cloud. */
+static const char pin_wait_msg[] =
+	"{\"state\":{\"pairing\":{\"state\":\"not_associated\"}}}";
+static const char paired_msg[] =
+	"{\"desired\":{\"pairing\":{\"state\":\"paired\",\"topics\":{"
+	"\"d2c\":\"prod/b8a3/m/d/nrf-3526/d2c\","
+	"\"c2d\":\"prod/b8a3/m/d/nrf-3526/+/r\"}},"
+	"\"nrfcloud_mqtt_topic_prefix\":\"prod/b8a3/m\","
+	"\"stage\":\"prod\"},"
+	"\"reported\":{\"connection\":{\"status\":\"connected\"},"
+	"\"device\":{\"deviceInfo\":{\"modemFirmware\":\"mfw_nrf9160_1.2.0\","
+	"\"batteryVoltage\":5112,\"imei\":\"352656100367872\","
+	"\"board\":\"nrf9160dk_nrf9160\",\"appVersion\":\"v1.3.0\"},"
+	"\"networkInfo\":{\"currentBand\":20,\"supportedBands\":[1,2,3,4,5,8,"
+	"12,13,17,19,20,25,26,28,66],\"areaCode\":36874,\"mccmnc\":\"24202\","
+	"\"ipAddress\":\"10.81.183.99\",\"ueMode\":2,\"cellID\":84485647,"
+	"\"networkMode\":\"LTE-M GPS\"}}}}";
+static const char config_msg[] =
+	"{ \"version\": 27, \"timestamp\": 1594910000,\n"
+	"  \"state\": {\n"
+	"    \"config\": { \"activeMode\": true, \"gpsTimeout\": 6.0e1,\n"
+	"                \"name\": \"a \\\"b\\\" \\u00e6\\ud83d\\ude00\",\n"
+	"                \"cells\": [ null, -0.5, { } ] }\n"
+	"  },\n"
+	"  \"metadata\": { \"config\": { \"activeMode\": "
+	"{ \"timestamp\": 1594910000 } } }\n"
+	"}";
+
+static const char *const decode_msgs[] = {
+	pin_wait_msg,
+	paired_msg,
+	config_msg,
+};
+
+static char buf[512];
+
+/* Heap usage of cJSON, through its hooks. */
+static struct {
+	size_t alloc_cnt;
+	size_t alloc_bytes;
+} heap;
+
+/* Used by the state encoder, which is not tested here. */
+void nct_dc_endpoint_get(struct nrf_cloud_data *tx_endpoint,
+			 struct nrf_cloud_data *rx_endpoint,
+			 struct nrf_cloud_data *m_endpoint)
+{
+}
+
+static void *counting_malloc(size_t size)
+{
+	heap.alloc_cnt++;
+	heap.alloc_bytes += size;
+
+	return k_malloc(size);
+}
+
+static void counting_free(void *ptr)
+{
+	k_free(ptr);
+}
+
+static cJSON *shadow_obj_create(void)
+{
+	cJSON *obj = cJSON_CreateObject();
+
+	zassert_not_null(obj, "Failed to create object");
+	cJSON_AddStringToObject(obj, "modemFirmware", "mfw_nrf9160_1.2.0");
+	cJSON_AddNumberToObject(obj, "band", 20);
+	cJSON_AddStringToObject(obj, "note", escaped_data);
+
+	return obj;
+}
+
+static void sensor_data_check(enum nrf_cloud_sensor type, const char *data)
+{
+	int err;
+	struct nrf_cloud_data expected;
+	struct nrf_cloud_data output;
+	const struct nrf_cloud_sensor_data sensor = {
+		.type = type,
+		.data.ptr = data,
+		.data.len = strlen(data),
+	};
+
+	err = nrf_cloud_encode_sensor_data(&sensor, &expected);
+	zassert_equal(err, 0, "cJSON encoding failed: %d", err);
+
+	err = nrf_cloud_encode_sensor_data_buf(&sensor, buf, sizeof(buf),
+					       &output);
+	zassert_equal(err, 0, "Encoding failed: %d", err);
+
+	zassert_equal(output.ptr, buf, "Not encoded in buffer");
+	zassert_equal(output.len, expected.len, "Wrong length");
+	zassert_mem_equal(output.ptr, expected.ptr, expected.len,
+			  "Not the same as cJSON: %s", buf);
+	zassert_equal(buf[output.len], '\0', "Not null-terminated");
+
+	k_free((void *)expected.ptr);
+}
+
+static void test_sensor_data(void)
+{
+	sensor_data_check(NRF_CLOUD_SENSOR_GPS, gps_data);
+	sensor_data_check(NRF_CLOUD_SENSOR_TEMP, "23.5");
+	sensor_data_check(NRF_CLOUD_SENSOR_FLIP, escaped_data);
+}
+
+static void test_shadow_data(void)
+{
+	int err;
+	struct nrf_cloud_data expected;
+	struct nrf_cloud_data output;
+	struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_DEVICE_INFO,
+		.data.len = 1,
+	};
+
+	/* Both encoders consume the object. */
+	sensor.data.ptr = shadow_obj_create();
+	err = nrf_cloud_encode_shadow_data(&sensor, &expected);
+	zassert_equal(err, 0, "cJSON encoding failed: %d", err);
+
+	sensor.data.ptr = shadow_obj_create();
+	err = nrf_cloud_encode_shadow_data_buf(&sensor, buf, sizeof(buf),
+					       &output);
+	zassert_equal(err, 0, "Encoding failed: %d", err);
+
+	zassert_equal(output.ptr, buf, "Not encoded in buffer");
+	zassert_equal(output.len, expected.len, "Wrong length");
+	zassert_mem_equal(output.ptr, expected.ptr, expected.len,
+			  "Not the same as cJSON: %s", buf);
+
+	k_free((void *)expected.ptr);
+}
+
+static void test_buf_too_small(void)
+{
+	int err;
+	struct nrf_cloud_data output;
+	struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_SENSOR_GPS,
+		.data.ptr = gps_data,
+		.data.len = strlen(gps_data),
+	};
+
+	err = nrf_cloud_encode_sensor_data(&sensor, &output);
+	zassert_equal(err, 0, "cJSON encoding failed: %d", err);
+	k_free((void *)output.ptr);
+
+	/* One byte short, for the null terminator. */
+	err = nrf_cloud_encode_sensor_data_buf(&sensor, buf, output.len,
+					       &output);
+	zassert_equal(err, -ENOMEM, "Message fits: %d", err);
+
+	/* The object is left to the cJSON encoder. */
+	sensor.type = NRF_CLOUD_DEVICE_INFO;
+	sensor.data.ptr = shadow_obj_create();
+	sensor.data.len = 1;
+
+	err = nrf_cloud_encode_shadow_data_buf(&sensor, buf, 32, &output);
+	zassert_equal(err, -ENOMEM, "Message fits: %d", err);
+
+	err = nrf_cloud_encode_shadow_data(&sensor, &output);
+	zassert_equal(err, 0, "cJSON encoding failed: %d", err);
+	k_free((void *)output.ptr);
+}
+
+/* Compare the encoders for message size, heap usage, and time. */
+static void test_benchmark(void)
+{
+	int err;
+	u32_t start;
+	u32_t cjson_cycles;
+	u32_t buf_cycles;
+	size_t cjson_allocs;
+	size_t cjson_bytes;
+	struct nrf_cloud_data output;
+	const struct nrf_cloud_sensor_data sensor = {
+		.type = NRF_CLOUD_SENSOR_GPS,
+		.data.ptr = gps_data,
+		.data.len = strlen(gps_data),
+	};
+
+	memset(&heap, 0, sizeof(heap));
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		err = nrf_cloud_encode_sensor_data(&sensor, &output);
+		zassert_equal(err, 0, "cJSON encoding failed: %d", err);
+		k_free((void *)output.ptr);
+	}
+	cjson_cycles = k_cycle_get_32() - start;
+	cjson_allocs = heap.alloc_cnt;
+	cjson_bytes = heap.alloc_bytes;
+
+	memset(&heap, 0, sizeof(heap));
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		err = nrf_cloud_encode_sensor_data_buf(&sensor, buf,
+						       sizeof(buf), &output);
+		zassert_equal(err, 0, "Encoding failed: %d", err);
+	}
+	buf_cycles = k_cycle_get_32() - start;
+
+	printk("Sensor message of %u bytes, per message:\n", output.len);
+	printk("  cJSON:  %u allocations, %u bytes, %u cycles\n",
+	       cjson_allocs / BENCHMARK_ITERATIONS,
+	       cjson_bytes / BENCHMARK_ITERATIONS,
+	       cjson_cycles / BENCHMARK_ITERATIONS);
+	printk("  buffer: %u allocations, %u bytes, %u cycles\n",
+	       heap.alloc_cnt / BENCHMARK_ITERATIONS,
+	       heap.alloc_bytes / BENCHMARK_ITERATIONS,
+	       buf_cycles / BENCHMARK_ITERATIONS);
+
+	zassert_equal(heap.alloc_cnt, 0, "Heap used");
+}
+
+/* The cJSON decoders that were replaced, as a reference. */
+static cJSON *ref_desired_obj_get(cJSON *root_obj)
+{
+	cJSON *state_obj = cJSON_GetObjectItem(root_obj, "state");
+
+	return state_obj ? state_obj : cJSON_GetObjectItem(root_obj, "desired");
+}
+
+static int ref_decode_requested_state(const char *json,
+				      enum nfsm_state *requested_state)
+{
+	int err = -ENOENT;
+	cJSON *root_obj = cJSON_Parse(json);
+	cJSON *desired_obj = ref_desired_obj_get(root_obj);
+	cJSON *state_obj = cJSON_GetObjectItem(
+		cJSON_GetObjectItem(desired_obj, "pairing"), "state");
+
+	if (cJSON_GetObjectItem(desired_obj, "nrfcloud_mqtt_topic_prefix")) {
+		*requested_state = STATE_UA_PIN_COMPLETE;
+		err = 0;
+	} else if (cJSON_IsString(state_obj)) {
+		if (strncmp(state_obj->valuestring, "not_associated", 14) == 0) {
+			*requested_state = STATE_UA_PIN_WAIT;
+			err = 0;
+		} else {
+			err = -ENOTSUP;
+		}
+	}
+
+	cJSON_Delete(root_obj);
+
+	return err;
+}
+
+static int ref_decode_data_endpoint(const char *json, char *tx, char *rx,
+				    char *m)
+{
+	int err = -ENOENT;
+	cJSON *root_obj = cJSON_Parse(json);
+	cJSON *desired_obj = ref_desired_obj_get(root_obj);
+	cJSON *m_obj = cJSON_GetObjectItem(desired_obj,
+					   "nrfcloud_mqtt_topic_prefix");
+	cJSON *pairing_obj = cJSON_GetObjectItem(desired_obj, "pairing");
+	cJSON *state_obj = cJSON_GetObjectItem(pairing_obj, "state");
+	cJSON *topics_obj = cJSON_GetObjectItem(pairing_obj, "topics");
+	cJSON *tx_obj = cJSON_GetObjectItem(topics_obj, "d2c");
+	cJSON *rx_obj = cJSON_GetObjectItem(topics_obj, "c2d");
+
+	if (cJSON_IsString(state_obj) && (topics_obj != NULL) &&
+	    (strncmp(state_obj->valuestring, "paired", 6) == 0) &&
+	    ((m_obj == NULL) || cJSON_IsString(m_obj)) &&
+	    cJSON_IsString(tx_obj) && cJSON_IsString(rx_obj)) {
+		strncpy(tx, tx_obj->valuestring, ENDPOINT_LEN_MAX);
+		strncpy(rx, rx_obj->valuestring, ENDPOINT_LEN_MAX);
+		strncpy(m, m_obj ? m_obj->valuestring : "", ENDPOINT_LEN_MAX);
+		err = 0;
+	}
+
+	cJSON_Delete(root_obj);
+
+	return err;
+}
+
+static void endpoint_check(const struct nrf_cloud_data *endpoint,
+			   const char *expected)
+{
+	zassert_equal(endpoint->len, strlen(expected), "Wrong length");
+	zassert_mem_equal(endpoint->ptr, expected, endpoint->len,
+			  "Wrong endpoint");
+}
+
+/* Decode a message, and check that the results are those of cJSON. A
+ * message that is not strictly valid JSON is rejected, even if cJSON
+ * accepts it.
+ */
+static void decode_check(const char *json)
+{
+	int err;
+	int ref_err;
+	bool has_config = false;
+	bool valid;
+	enum nfsm_state state = STATE_IDLE;
+	enum nfsm_state ref_state = STATE_IDLE;
+	char ref_tx[ENDPOINT_LEN_MAX + 1] = { 0 };
+	char ref_rx[ENDPOINT_LEN_MAX + 1] = { 0 };
+	char ref_m[ENDPOINT_LEN_MAX + 1] = { 0 };
+	struct nrf_cloud_json_val root;
+	struct nrf_cloud_data tx = { 0 };
+	struct nrf_cloud_data rx = { 0 };
+	struct nrf_cloud_data m = { 0 };
+	struct nrf_cloud_data resp;
+	const struct nrf_cloud_data input = {
+		.ptr = json,
+		.len = strlen(json),
+	};
+
+	valid = (nrf_cloud_json_parse(json, input.len, &root) == 0);
+	if (valid) {
+		cJSON *root_obj = cJSON_Parse(json);
+
+		zassert_not_null(root_obj, "Not valid for cJSON: %s", json);
+		cJSON_Delete(root_obj);
+	}
+
+	if (input.len == 0) {
+		return;
+	}
+
+	err = nrf_cloud_decode_requested_state(&input, &state);
+	if (valid) {
+		ref_err = ref_decode_requested_state(json, &ref_state);
+		zassert_equal(err, ref_err, "Requested state %d, expected %d",
+			      err, ref_err);
+		zassert_equal(state, ref_state, "Wrong requested state");
+	} else {
+		zassert_equal(err, -ENOENT, "Invalid JSON decoded");
+	}
+
+	err = nrf_cloud_decode_data_endpoint(&input, &tx, &rx, &m);
+	if (valid) {
+		ref_err = ref_decode_data_endpoint(json, ref_tx, ref_rx, ref_m);
+		zassert_equal(err == 0, ref_err == 0,
+			      "Endpoints %d, expected %d", err, ref_err);
+	} else {
+		zassert_equal(err, -ENOENT, "Invalid JSON decoded");
+	}
+	if (err == 0) {
+		endpoint_check(&tx, ref_tx);
+		endpoint_check(&rx, ref_rx);
+		if (m.ptr != NULL) {
+			endpoint_check(&m, ref_m);
+		} else {
+			zassert_equal(ref_m[0], '\0', "Prefix not found");
+		}
+	}
+	k_free((void *)tx.ptr);
+	k_free((void *)rx.ptr);
+	k_free((void *)m.ptr);
+
+	err = nrf_cloud_encode_config_response(&input, &resp, &has_config);
+	if (!valid) {
+		zassert_equal(err, -ESRCH, "Invalid JSON decoded");
+		return;
+	}
+	zassert_equal(err, 0, "Config response failed: %d", err);
+
+	cJSON *root_obj = cJSON_Parse(json);
+	cJSON *state_obj = cJSON_GetObjectItem(root_obj, "state");
+	cJSON *config_obj = cJSON_GetObjectItem(
+		state_obj ? state_obj : root_obj, "config");
+
+	zassert_equal(has_config, config_obj != NULL, "Config not found");
+
+	if (state_obj && config_obj) {
+		cJSON *resp_obj = cJSON_Parse(resp.ptr);
+		cJSON *resp_state_obj = cJSON_GetObjectItem(resp_obj, "state");
+
+		zassert_not_null(resp_obj, "Not valid: %s", resp.ptr);
+		zassert_equal(resp.len, strlen(resp.ptr), "Wrong length");
+		zassert_true(cJSON_Compare(config_obj, cJSON_GetObjectItem(
+			cJSON_GetObjectItem(resp_state_obj, "reported"),
+			"config"), true), "Wrong config: %s", resp.ptr);
+		zassert_true(cJSON_IsNull(cJSON_GetObjectItem(
+			cJSON_GetObjectItem(resp_state_obj, "desired"),
+			"config")), "Desired config not cleared: %s", resp.ptr);
+
+		cJSON_Delete(resp_obj);
+		k_free((void *)resp.ptr);
+	} else {
+		zassert_is_null(resp.ptr, "Unexpected response");
+	}
+
+	cJSON_Delete(root_obj);
+}
+
+static void test_decode(void)
+{
+	int err;
+	enum nfsm_state state;
+	bool has_config;
+	struct nrf_cloud_data tx;
+	struct nrf_cloud_data rx;
+	struct nrf_cloud_data m;
+	struct nrf_cloud_data resp;
+	struct nrf_cloud_data input = {
+		.ptr = pin_wait_msg,
+		.len = strlen(pin_wait_msg),
+	};
+
+	for (int i = 0; i < ARRAY_SIZE(decode_msgs); i++) {
+		decode_check(decode_msgs[i]);
+	}
+
+	err = nrf_cloud_decode_requested_state(&input, &state);
+	zassert_equal(err, 0, "Decoding failed: %d", err);
+	zassert_equal(state, STATE_UA_PIN_WAIT, "Wrong state");
+
+	input.ptr = paired_msg;
+	input.len = strlen(paired_msg);
+	err = nrf_cloud_decode_requested_state(&input, &state);
+	zassert_equal(err, 0, "Decoding failed: %d", err);
+	zassert_equal(state, STATE_UA_PIN_COMPLETE, "Wrong state");
+
+	err = nrf_cloud_decode_data_endpoint(&input, &tx, &rx, &m);
+	zassert_equal(err, 0, "Decoding failed: %d", err);
+	endpoint_check(&tx, "prod/b8a3/m/d/nrf-3526/d2c");
+	endpoint_check(&rx, "prod/b8a3/m/d/nrf-3526/+/r");
+	endpoint_check(&m, "prod/b8a3/m");
+	k_free((void *)tx.ptr);
+	k_free((void *)rx.ptr);
+	k_free((void *)m.ptr);
+
+	input.ptr = config_msg;
+	input.len = strlen(config_msg);
+	err = nrf_cloud_encode_config_response(&input, &resp, &has_config);
+	zassert_equal(err, 0, "Encoding failed: %d", err);
+	zassert_true(has_config, "Config not found");
+	zassert_true(strcmp(resp.ptr, "{\"state\":{\"reported\":{\"config\":"
+		"{\"activeMode\":true,\"gpsTimeout\":6.0e1,"
+		"\"name\":\"a \\\"b\\\" \\u00e6\\ud83d\\ude00\","
+		"\"cells\":[null,-0.5,{}]}},"
+		"\"desired\":{\"config\":null}}}") == 0,
+		"Wrong response: %s", resp.ptr);
+	k_free((void *)resp.ptr);
+}
+
+/* The payload buffer is not null-terminated after the message. */
+static void test_decode_unterminated(void)
+{
+	int err;
+	enum nfsm_state state;
+	struct nrf_cloud_data input = {
+		.ptr = buf,
+		.len = strlen(pin_wait_msg),
+	};
+
+	memset(buf, '}', sizeof(buf));
+	memcpy(buf, pin_wait_msg, strlen(pin_wait_msg));
+
+	err = nrf_cloud_decode_requested_state(&input, &state);
+	zassert_equal(err, 0, "Decoding failed: %d", err);
+	zassert_equal(state, STATE_UA_PIN_WAIT, "Wrong state");
+
+	/* Truncated. */
+	input.len--;
+	err = nrf_cloud_decode_requested_state(&input, &state);
+	zassert_equal(err, -ENOENT, "Truncated message decoded");
+}
+
+static u32_t fuzz_rand(void)
+{
+	static u32_t x = 2463534242;
+
+	/* xorshift32 */
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	return x;
+}
+
+/* Decode the messages with random bytes changed, inserted, or removed, and
+ * cut short. Characters that are part of the JSON syntax are chosen more
+ * often, so that more of the mutated messages are still valid.
+ */
+static void test_decode_fuzz(void)
+{
+	static const char syntax[] = "{}[]\":,\\ \nu0123456789.-+eEtrufalsn";
+	static char msg[sizeof(paired_msg) + 16];
+	size_t valid_cnt = 0;
+
+	for (int i = 0; i < FUZZ_ITERATIONS; i++) {
+		const char *seed = decode_msgs[i % ARRAY_SIZE(decode_msgs)];
+		size_t len = strlen(seed);
+		int mutations = 1 + fuzz_rand() % 4;
+
+		memcpy(msg, seed, len + 1);
+
+		for (int j = 0; j < mutations; j++) {
+			size_t pos = fuzz_rand() % len;
+			char c = (fuzz_rand() % 2) ?
+				syntax[fuzz_rand() % (sizeof(syntax) - 1)] :
+				(char)(fuzz_rand() % 256);
+
+			switch (fuzz_rand() % 4) {
+			case 0:
+				msg[pos] = c;
+				break;
+			case 1:
+				if (len + 1 < sizeof(msg)) {
+					memmove(&msg[pos + 1], &msg[pos],
+						len - pos + 1);
+					msg[pos] = c;
+					len++;
+				}
+				break;
+			case 2:
+				memmove(&msg[pos], &msg[pos + 1], len - pos);
+				len--;
+				break;
+			default:
+				msg[pos] = '\0';
+				break;
+			}
+
+			len = strlen(msg);
+			if (len == 0) {
+				break;
+			}
+		}
+
+		valid_cnt += (nrf_cloud_json_parse(msg, len,
+				&(struct nrf_cloud_json_val){ 0 }) == 0);
+		decode_check(msg);
+	}
+
+	printk("%u of %u mutated messages were valid JSON\n", valid_cnt,
+	       FUZZ_ITERATIONS);
+}
+
+/* Compare the decoders for heap usage and time. */
+static void test_decode_benchmark(void)
+{
+	int err;
+	u32_t start;
+	u32_t cjson_cycles;
+	u32_t decoder_cycles;
+	enum nfsm_state state;
+	const struct nrf_cloud_data input = {
+		.ptr = paired_msg,
+		.len = strlen(paired_msg),
+	};
+
+	memset(&heap, 0, sizeof(heap));
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		err = ref_decode_requested_state(paired_msg, &state);
+		zassert_equal(err, 0, "cJSON decoding failed: %d", err);
+	}
+	cjson_cycles = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+		err = nrf_cloud_decode_requested_state(&input, &state);
+		zassert_equal(err, 0, "Decoding failed: %d", err);
+	}
+	decoder_cycles = k_cycle_get_32() - start;
+
+	printk("Shadow delta of %u bytes, per message:\n", input.len);
+	printk("  cJSON:   %u allocations, %u bytes, %u cycles\n",
+	       heap.alloc_cnt / BENCHMARK_ITERATIONS,
+	       heap.alloc_bytes / BENCHMARK_ITERATIONS,
+	       cjson_cycles / BENCHMARK_ITERATIONS);
+	printk("  decoder: no allocations, %u cycles\n",
+	       decoder_cycles / BENCHMARK_ITERATIONS);
+}
+
+void test_main(void)
+{
+	static cJSON_Hooks hooks = {
+		.malloc_fn = counting_malloc,
+		.free_fn = counting_free,
+	};
+
+	nrf_codec_init();
+	cJSON_InitHooks(&hooks);
+
+	ztest_test_suite(nrf_cloud_codec_test,
+			 ztest_unit_test(test_sensor_data),
+			 ztest_unit_test(test_shadow_data),
+			 ztest_unit_test(test_buf_too_small),
+			 ztest_unit_test(test_benchmark),
+			 ztest_unit_test(test_decode),
+			 ztest_unit_test(test_decode_unterminated),
+			 ztest_unit_test(test_decode_fuzz),
+			 ztest_unit_test(test_decode_benchmark)
+	);
+
+	ztest_run_test_suite(nrf_cloud_codec_test);
+}